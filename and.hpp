@@ -11,6 +11,7 @@
 #include "helper.hpp"
 #include "or.hpp"
 #include "pretty_printer.hpp"
+#include "storage.hpp"
 #include "traits.hpp"
 
 #include <ostream>
@@ -20,7 +21,7 @@
 namespace fol {
 
 template<typename... Ts>
-struct And {
+struct And : details::StoredTs<std::tuple<Ts...>> {
 	private:
 	template<typename... Tx, std::size_t... Idx>
 	static constexpr And<Tx...> fromTupleImpl(std::tuple<Tx...> t, const std::index_sequence<Idx...>) {
@@ -30,19 +31,20 @@ struct And {
 	public:
 	static_assert((IsFormula<Ts>::value && ...), "All parameters have to be formulas!");
 	
-	std::tuple<Ts...> ts;
+	using details::StoredTs<std::tuple<Ts...>>::ts;
 	
 	using VariableCount = std::integral_constant<std::size_t, (0 + ... + Ts::VariableCount::value)>;
 //	using VariableArray = decltype((ArraySet<0>{} + ... + typename Ts::VariableArray{}));
 	
 	constexpr And(void) = default;
 	constexpr And(Ts... t) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...) &&
-	                                noexcept(std::make_tuple(std::move(t)...))) : ts{std::make_tuple(std::move(t)...)} {
+	                                noexcept(std::make_tuple(std::move(t)...))) :
+			details::StoredTs<std::tuple<Ts...>>{std::make_tuple(std::move(t)...)} {
 		return;
 	}
 	
 	constexpr auto simplified(void) const {
-		return fromTuple(details::simplifiedTuple(ts));
+		return details::simplifyJunction<And, True, False, Or>(details::simplifiedTuple(ts));
 	}
 	
 	constexpr auto negate(void) const {
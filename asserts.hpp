@@ -14,12 +14,18 @@
 #include "function.hpp"
 #include "helper.hpp"
 #include "implies.hpp"
+#include "lowering.hpp"
 #include "name.hpp"
+#include "nary_junction.hpp"
 #include "not.hpp"
 #include "or.hpp"
+#include "order.hpp"
 #include "predicate.hpp"
+#include "truth.hpp"
 #include "variable.hpp"
+#include "visit.hpp"
 
+#include <tuple>
 #include <type_traits>
 
 namespace fol {
@@ -135,14 +141,14 @@ static_assert(Implies{Not{Predicate{Name<'p'>{}}}, Predicate{Name<'q'>{}}}.simpl
               Or{Predicate{Name<'p'>{}}, Predicate{Name<'q'>{}}});
 
 static_assert(Equivalent{Predicate{Name<'p'>{}}, Predicate{Name<'q'>{}}}.simplified() ==
-              And{Or{Not{Predicate{Name<'p'>{}}}, Predicate{Name<'q'>{}}},
-                  Or{Not{Predicate{Name<'q'>{}}}, Predicate{Name<'p'>{}}}});
+              And{Or{Predicate{Name<'p'>{}}, Not{Predicate{Name<'q'>{}}}},
+                  Or{Not{Predicate{Name<'p'>{}}}, Predicate{Name<'q'>{}}}});
 static_assert(Equivalent{Not{Predicate{Name<'p'>{}}}, Predicate{Name<'q'>{}}}.simplified() ==
               And{Or{Predicate{Name<'p'>{}}, Predicate{Name<'q'>{}}},
-                  Or{Not{Predicate{Name<'q'>{}}}, Not{Predicate{Name<'p'>{}}}}});
+                  Or{Not{Predicate{Name<'p'>{}}}, Not{Predicate{Name<'q'>{}}}}});
 static_assert(Equivalent{Predicate{Name<'p'>{}}, Not{Predicate{Name<'q'>{}}}}.simplified() ==
-              And{Or{Not{Predicate{Name<'p'>{}}}, Not{Predicate{Name<'q'>{}}}},
-                  Or{Predicate{Name<'q'>{}}, Predicate{Name<'p'>{}}}});
+              And{Or{Predicate{Name<'p'>{}}, Predicate{Name<'q'>{}}},
+                  Or{Not{Predicate{Name<'p'>{}}}, Not{Predicate{Name<'q'>{}}}}});
 
 static_assert(Not{And{Not{Predicate{Name<'p'>{}}}, Predicate{Name<'q'>{}}}}.simplified() ==
               Not{And{Not{Predicate{Name<'p'>{}}}, Predicate{Name<'q'>{}}}});
@@ -163,6 +169,64 @@ static_assert(Not{Or{Not{Predicate{Name<'p'>{}, Variable<'x'>{}}},
                      Not{Predicate{Name<'p'>{}, Variable<'y'>{}}},
                      Not{Equality{Variable<'x'>{}, Variable<'y'>{}}}}});
 
+//Algebraic simplification tests
+static_assert(std::is_same_v<decltype(Not{True{}}.simplified()), False>);
+static_assert(std::is_same_v<decltype(Not<Not<False>>{}.simplified()), False>);
+static_assert(std::is_same_v<decltype(Equality{Variable<'x'>{}, Variable<'x'>{}}.simplified()), True>);
+static_assert(Equality{Variable<'x'>{}, Variable<'y'>{}}.simplified() == Equality{Variable<'x'>{}, Variable<'y'>{}});
+static_assert(std::is_same_v<decltype(ForAll{Variable<'x'>{}, Equality{Variable<'x'>{}, Variable<'x'>{}}}.simplified()),
+                             True>);
+
+static_assert(std::is_same_v<decltype(And{Predicate{Name<'p'>{}}, Not{Predicate{Name<'p'>{}}}}.simplified()), False>);
+static_assert(std::is_same_v<decltype(Or{Not{Predicate{Name<'p'>{}}}, Predicate{Name<'p'>{}}}.simplified()), True>);
+static_assert(std::is_same_v<decltype(Implies{Predicate{Name<'p'>{}}, Predicate{Name<'p'>{}}}.simplified()), True>);
+static_assert(std::is_same_v<decltype(And{Predicate{Name<'p'>{}}, False{}}.simplified()), False>);
+static_assert(std::is_same_v<decltype(Or{Predicate{Name<'p'>{}}, True{}}.simplified()), True>);
+static_assert(std::is_same_v<decltype(And{True{}, True{}}.simplified()), True>);
+static_assert(std::is_same_v<decltype(Or{False{}, False{}}.simplified()), False>);
+
+static_assert(And{Predicate{Name<'p'>{}}, Predicate{Name<'p'>{}}}.simplified() == Predicate{Name<'p'>{}});
+static_assert(Or{Predicate{Name<'p'>{}}, Predicate{Name<'q'>{}}, Predicate{Name<'p'>{}}}.simplified() ==
+              Or{Predicate{Name<'p'>{}}, Predicate{Name<'q'>{}}});
+static_assert(And{Predicate{Name<'p'>{}}, True{}, Predicate{Name<'q'>{}}}.simplified() ==
+              And{Predicate{Name<'p'>{}}, Predicate{Name<'q'>{}}});
+static_assert(Or{False{}, Predicate{Name<'p'>{}}}.simplified() == Predicate{Name<'p'>{}});
+static_assert(And{Predicate{Name<'p'>{}}, Or{Predicate{Name<'p'>{}}, Predicate{Name<'q'>{}}}}.simplified() ==
+              Predicate{Name<'p'>{}});
+static_assert(Or{And{Predicate{Name<'q'>{}}, Predicate{Name<'p'>{}}}, Predicate{Name<'p'>{}}}.simplified() ==
+              Predicate{Name<'p'>{}});
+static_assert(Not{And{Not{Predicate{Name<'p'>{}}}, True{}}}.simplified() == Predicate{Name<'p'>{}});
+static_assert(std::is_same_v<decltype(And{Predicate{Name<'p'>{}}, Or{Predicate{Name<'p'>{}},
+                                                                    Predicate{Name<'q'>{}}}}.simplified()),
+                             Predicate<Name<'p'>>>);
+
+//Canonical order tests
+static_assert(orderedBefore(Name<'p'>{}, Name<'q'>{}) && orderedBefore(Name<'q'>{}, Name<'p', 'p'>{}));
+static_assert(orderedBefore(Predicate{Name<'p'>{}}, Not{Predicate{Name<'p'>{}}}));
+static_assert(orderedBefore(Not{Predicate{Name<'p'>{}}}, Predicate{Name<'q'>{}}));
+static_assert(orderedBefore(Predicate{Name<'p'>{}, Variable<'x'>{}},
+                            Predicate{Name<'p'>{}, Function{Name<'c'>{}}}));
+static_assert(!orderedBefore(Predicate{Name<'p'>{}}, Predicate{Name<'p'>{}}));
+static_assert(std::is_same_v<decltype(And{Predicate{Name<'q'>{}}, Predicate{Name<'p'>{}}}.simplified()),
+                             decltype(And{Predicate{Name<'p'>{}}, Predicate{Name<'q'>{}}}.simplified())>);
+static_assert(std::is_same_v<decltype(Or{Predicate{Name<'q'>{}}, Not{Predicate{Name<'p'>{}}}, Predicate{Name<'q'>{}},
+                                         Predicate{Name<'r'>{}}}.simplified()),
+                             Or<Not<Predicate<Name<'p'>>>, Predicate<Name<'q'>>, Predicate<Name<'r'>>>>);
+static_assert(std::is_same_v<decltype(ForAll{Variable<'x'>{}, And{Predicate{Name<'q'>{}, Variable<'x'>{}},
+                                                                  Predicate{Name<'p'>{}}}}.simplified()),
+                             ForAll<Variable<'x'>, And<Predicate<Name<'p'>>, Predicate<Name<'q'>, Variable<'x'>>>>>);
+
+//Homogeneous junction tests
+static_assert(std::is_same_v<decltype(AndN<Not<Not<Predicate<Name<'p'>>>>>{}.simplified()),
+                             AndN<Predicate<Name<'p'>>>>);
+static_assert(std::is_same_v<decltype(AndN<Predicate<Name<'p'>>>{}.negate()), OrN<Not<Predicate<Name<'p'>>>>>);
+static_assert(std::is_same_v<decltype(OrN<Not<Predicate<Name<'p'>>>>{}.toNegationNormalForm()),
+                             OrN<Not<Predicate<Name<'p'>>>>>);
+static_assert(std::is_same_v<decltype(OrN<Not<Predicate<Name<'p'>>>,
+                                          SmallVector<Not<Predicate<Name<'p'>>>, 4>>{}.negate()),
+                             AndN<Predicate<Name<'p'>>, SmallVector<Predicate<Name<'p'>>, 4>>>);
+static_assert(IsFormula<And<AndN<Predicate<Name<'p'>>>, Predicate<Name<'q'>>>>::value);
+
 //To negation normal form tests
 static_assert(Not<Predicate<Name<'p'>>>{}.toNegationNormalForm() == Not{Predicate{Name<'p'>{}}});
 static_assert(Not<Not<Predicate<Name<'p'>>>>{}.toNegationNormalForm() == Predicate{Name<'p'>{}});
@@ -196,6 +260,43 @@ static_assert(Not{Exists{Variable<'x'>{}, Not{Predicate{Name<'p'>{}, Variable<'x
 static_assert(Exists{Variable<'x'>{}, Not{Predicate{Name<'p'>{}, Variable<'x'>{}}}}.toNegationNormalForm() ==
               Exists{Variable<'x'>{}, Not{Predicate{Name<'p'>{}, Variable<'x'>{}}}});
 
+//Storage tests
+static_assert(sizeof(Variable<'x'>) == 1);
+static_assert(sizeof(Function{Name<'f'>{}, Variable<'x'>{}, Variable<'x'>{}}) == 1);
+static_assert(sizeof(Predicate{Name<'p'>{}, Variable<'x'>{}, Function{Name<'f'>{}, Variable<'x'>{}}}) == 1);
+static_assert(sizeof(Equality{Variable<'x'>{}, Variable<'x'>{}}) == 1);
+static_assert(sizeof(And{Predicate{Name<'p'>{}}, Predicate{Name<'p'>{}}, Not{Predicate{Name<'p'>{}}}}) == 1);
+static_assert(sizeof(ForAll{Variable<'x'>{}, Implies{Predicate{Name<'p'>{}, Variable<'x'>{}},
+                                                     Exists{Variable<'y'>{}, Equivalent{True{}, False{}}}}}) == 1);
+static_assert(std::is_empty_v<Or<Predicate<Name<'p'>>, Predicate<Name<'p'>>>>);
+static_assert(sizeof(Predicate{Name<'p'>{}, RtVariable{"x"}}) == sizeof(std::tuple<RtVariable>));
+static_assert(sizeof(Not{Predicate{Name<'p'>{}, RtVariable{"x"}}}) == sizeof(Predicate<Name<'p'>, RtVariable>));
+static_assert(sizeof(Exists{Variable<'x'>{}, Predicate{Name<'p'>{}, RtVariable{"x"}}}) ==
+              sizeof(Predicate<Name<'p'>, RtVariable>));
+static_assert(sizeof(Implies{Predicate{Name<'q'>{}}, Predicate{Name<'p'>{}, RtVariable{"x"}}}) ==
+              sizeof(Predicate<Name<'p'>, RtVariable>));
+static_assert(sizeof(Exists{RtVariable{"x"}, True{}}) == sizeof(RtVariable));
+
+//Traversal tests
+static_assert(atomCount(And{Predicate{Name<'p'>{}}, Not{Equality{Variable<'x'>{}, Variable<'y'>{}}}}) == 2);
+static_assert(fold(ForAll{Variable<'x'>{}, Predicate{Name<'p'>{}, Function{Name<'f'>{}, Variable<'x'>{}}}}, 0,
+                   [](int& count, const auto&) { ++count; return; }) == 4);
+static_assert(!visit(Or{Predicate{Name<'p'>{}}, Not{Predicate{Name<'q'>{}}}, Predicate{Name<'r'>{}}},
+                     [](const auto& node) { return !IsNot<std::decay_t<decltype(node)>>::value; }));
+static_assert(fold(Or{Predicate{Name<'p'>{}}, Not{Predicate{Name<'q'>{}}}, Predicate{Name<'r'>{}}}, 0,
+                   [](int& count, const auto& node) {
+                       ++count;
+                       return !IsNot<std::decay_t<decltype(node)>>::value;
+                   }) == 3);
+
+//Lowering tests
+static_assert(details::StaticLowering<ForAll<Variable<'x'>, Predicate<Name<'p'>, Variable<'x'>>>>::NodeCount == 3);
+static_assert(details::StaticLowering<ForAll<Variable<'x'>, Predicate<Name<'p'>, Variable<'x'>>>>::Built.SymbolCount ==
+              2);
+static_assert(details::StaticLowering<And<Predicate<Name<'p'>>, Not<Predicate<Name<'q'>>>>>::Built.Nodes[0].End == 4);
+static_assert(details::StaticLowering<And<Predicate<Name<'p'>>, Not<Predicate<Name<'q'>>>>>::Built.Nodes[2].Kind ==
+              binary::NodeKind::Not);
+
 } //namespace fol
 
 #endif
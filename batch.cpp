@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks batch.hpp for self-containment.
+ * 
+ */
+
+#include "batch.hpp"
@@ -0,0 +1,122 @@
+/**
+ * @file
+ * @brief Contains the batch transformations of many independent formulas.
+ */
+
+#ifndef FOL_BATCH_HPP
+#define FOL_BATCH_HPP
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+namespace details {
+inline unsigned int defaultThreadCount(void) noexcept {
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+} //namespace details
+
+/**
+ * @brief Applies transform to count formulas starting at formulas, using up to threads threads.
+ *
+ * The input is cut into blocks, which the threads take one after another. Every block is written into its own output
+ * vector, so the threads do not share any allocation, and the blocks are concatenated in input order at the end. The
+ * first exception thrown by a transformation is rethrown after all threads have finished. The statistics collector of
+ * the calling thread is installed in the worker threads.
+ */
+template<typename T, typename Transform>
+auto transformBatch(const T *formulas, const std::size_t count, Transform transform,
+                    unsigned int threads = details::defaultThreadCount()) {
+	using Result = std::decay_t<std::invoke_result_t<Transform&, const T&>>;
+	constexpr std::size_t blockSize = 256;
+	
+	const std::size_t blockCount = (count + blockSize - 1) / blockSize;
+	threads = static_cast<unsigned int>(std::min<std::size_t>(std::max(threads, 1u),
+	                                                          std::max<std::size_t>(blockCount, 1)));
+	
+	std::vector<std::vector<Result>> blocks(blockCount);
+	std::atomic<std::size_t> nextBlock{0};
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	stats::Collector *const collector = stats::current();
+	
+	auto worker = [&](void) {
+			const stats::Install install{collector};
+			try {
+				for ( auto block = nextBlock++; block < blockCount; block = nextBlock++ ) {
+					const std::size_t first = block * blockSize, last = std::min(first + blockSize, count);
+					auto& out = blocks[block];
+					out.reserve(last - first);
+					for ( auto index = first; index < last; ++index ) {
+						out.push_back(transform(formulas[index]));
+					} //for ( auto index = first; index < last; ++index )
+				} //for ( auto block = nextBlock++; block < blockCount; block = nextBlock++ )
+			} //try
+			catch ( ... ) {
+				nextBlock = blockCount;
+				std::lock_guard lock{errorMutex};
+				if ( !error ) {
+					error = std::current_exception();
+				} //if ( !error )
+			} //catch ( ... )
+			return;
+		};
+	
+	std::vector<std::thread> pool;
+	pool.reserve(threads - 1);
+	for ( unsigned int i = 1; i < threads; ++i ) {
+		pool.emplace_back(worker);
+	} //for ( unsigned int i = 1; i < threads; ++i )
+	worker();
+	for ( auto& thread : pool ) {
+		thread.join();
+	} //for ( auto& thread : pool )
+	
+	if ( error ) {
+		std::rethrow_exception(error);
+	} //if ( error )
+	
+	std::vector<Result> ret;
+	ret.reserve(count);
+	for ( auto& block : blocks ) {
+		std::move(block.begin(), block.end(), std::back_inserter(ret));
+	} //for ( auto& block : blocks )
+	return ret;
+}
+
+template<typename T, typename Transform>
+auto transformBatch(const std::vector<T>& formulas, Transform transform,
+                    const unsigned int threads = details::defaultThreadCount()) {
+	return transformBatch(formulas.data(), formulas.size(), std::move(transform), threads);
+}
+
+template<typename T>
+auto simplifiedBatch(const std::vector<T>& formulas, const unsigned int threads = details::defaultThreadCount()) {
+	return transformBatch(formulas, [](const T& t) { return t.simplified(); }, threads);
+}
+
+template<typename T>
+auto negateBatch(const std::vector<T>& formulas, const unsigned int threads = details::defaultThreadCount()) {
+	return transformBatch(formulas, [](const T& t) { return t.negate(); }, threads);
+}
+
+template<typename T>
+auto toNegationNormalFormBatch(const std::vector<T>& formulas,
+                               const unsigned int threads = details::defaultThreadCount()) {
+	return transformBatch(formulas, [](const T& t) { return t.toNegationNormalForm(); }, threads);
+}
+
+} //namespace fol
+
+#endif
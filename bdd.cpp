@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks bdd.hpp for self-containment.
+ * 
+ */
+
+#include "bdd.hpp"
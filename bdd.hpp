@@ -0,0 +1,587 @@
+/**
+ * @file
+ * @brief Contains reduced ordered binary decision diagrams for the propositional fragment.
+ */
+
+#ifndef FOL_BDD_HPP
+#define FOL_BDD_HPP
+
+#include "rt_formula.hpp"
+#include "traits.hpp"
+#include "visit.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+class BddManager;
+
+/**
+ * @brief A reference to a node of a BddManager, the node is kept alive as long as a reference exists.
+ *
+ * Because the diagrams are reduced and ordered, two references are equal iff their formulas are equivalent. The manager
+ * has to outlive all of its references.
+ */
+class Bdd {
+	BddManager *Manager = nullptr;
+	std::uint32_t Edge  = 0;
+	
+	friend class BddManager;
+	
+	Bdd(BddManager *manager, const std::uint32_t edge) noexcept;
+	
+	BddManager& manager(void) const;
+	
+	public:
+	/**
+	 * @brief An empty reference without a manager, it can only be assigned to, compared, and queried.
+	 */
+	Bdd(void) noexcept = default;
+	Bdd(const Bdd& that) noexcept;
+	Bdd(Bdd&& that) noexcept;
+	Bdd& operator=(Bdd that) noexcept;
+	~Bdd(void) noexcept;
+	
+	bool isTrue(void) const noexcept;
+	bool isFalse(void) const noexcept;
+	
+	/**
+	 * @brief Returns the number of nodes of this diagram, including the terminal.
+	 */
+	std::size_t nodeCount(void) const;
+	
+	/**
+	 * @brief Returns the number of satisfying assignments to all variables of the manager.
+	 */
+	double satCount(void) const;
+	
+	Bdd operator!(void) const;
+	Bdd operator&(const Bdd& that) const;
+	Bdd operator|(const Bdd& that) const;
+	Bdd implies(const Bdd& that) const;
+	Bdd equivalent(const Bdd& that) const;
+	
+	friend bool operator==(const Bdd& b1, const Bdd& b2) noexcept {
+		return b1.Manager == b2.Manager && b1.Edge == b2.Edge;
+	}
+	
+	friend bool operator!=(const Bdd& b1, const Bdd& b2) noexcept {
+		return !(b1 == b2);
+	}
+};
+
+/**
+ * @brief Owns the nodes of the diagrams over one variable order.
+ *
+ * An edge is the index of its node shifted by one, the lowest bit marks a complemented edge. Node 0 is the terminal
+ * true, so edge 0 is true and edge 1 false. Only the low edge of a node may be complemented, which keeps the diagrams
+ * canonical. All nodes are hash consed in the unique table and the results of ite are memorized in a direct mapped
+ * cache. Nodes which are not reachable from a Bdd are only freed by collectGarbage(), which build() and ite() call
+ * before they start once the node count exceeds twice the live nodes of the last collection.
+ */
+class BddManager {
+	public:
+	using Edge = std::uint32_t;
+	
+	/**
+	 * @brief The heuristics for the order of the variables of a formula which are not yet known to the manager.
+	 */
+	enum class VariableOrder : std::uint8_t {
+		Appearance, //In the order of their first occurrence, keeps related variables close to each other.
+		Frequency,  //The most frequent variables first.
+		Alphabetical
+	};
+	
+	static constexpr Edge True  = 0;
+	static constexpr Edge False = 1;
+	
+	private:
+	static constexpr std::uint32_t TerminalLevel = std::numeric_limits<std::uint32_t>::max();
+	
+	struct Node {
+		std::uint32_t Level;
+		Edge Low;
+		Edge High;
+		std::uint32_t References;
+	};
+	
+	struct NodeKey {
+		std::uint32_t Level;
+		Edge Low;
+		Edge High;
+		
+		friend bool operator==(const NodeKey& k1, const NodeKey& k2) noexcept {
+			return k1.Level == k2.Level && k1.Low == k2.Low && k1.High == k2.High;
+		}
+	};
+	
+	struct NodeKeyHash {
+		std::size_t operator()(const NodeKey& key) const noexcept {
+			return details::hashCombine(details::hashCombine(key.Level, key.Low), key.High);
+		}
+	};
+	
+	struct CacheEntry {
+		Edge F = True, G = True, H = True, Result = True;
+		bool Valid = false;
+	};
+	
+	std::vector<Node> Nodes{{TerminalLevel, True, True, 1}};
+	std::vector<std::uint32_t> FreeNodes;
+	std::unordered_map<NodeKey, std::uint32_t, NodeKeyHash> Unique;
+	std::vector<CacheEntry> Cache;
+	std::vector<RtName> Variables;
+	std::unordered_map<RtName, std::uint32_t> Levels;
+	std::size_t CollectAt = 1 << 16;
+	
+	friend class Bdd;
+	
+	static constexpr Edge complement(const Edge e) noexcept {
+		return e ^ 1;
+	}
+	
+	static constexpr bool isComplemented(const Edge e) noexcept {
+		return e & 1;
+	}
+	
+	static constexpr std::uint32_t nodeOf(const Edge e) noexcept {
+		return e >> 1;
+	}
+	
+	std::uint32_t level(const Edge e) const noexcept {
+		return Nodes[nodeOf(e)].Level;
+	}
+	
+	/**
+	 * @brief Returns the cofactor of e for the variable at level, i.e. e with the variable set to value.
+	 */
+	Edge cofactor(const Edge e, const std::uint32_t lvl, const bool value) const noexcept {
+		const auto& node = Nodes[nodeOf(e)];
+		if ( node.Level != lvl ) {
+			return e;
+		} //if ( node.Level != lvl )
+		return (value ? node.High : node.Low) ^ (e & 1);
+	}
+	
+	Edge makeNode(const std::uint32_t lvl, Edge low, Edge high) {
+		if ( low == high ) {
+			return low;
+		} //if ( low == high )
+		const bool complemented = isComplemented(high);
+		if ( complemented ) {
+			low  = complement(low);
+			high = complement(high);
+		} //if ( complemented )
+		
+		const NodeKey key{lvl, low, high};
+		if ( const auto iter = Unique.find(key); iter != Unique.end() ) {
+			return (iter->second << 1) | (complemented ? 1u : 0u);
+		} //if ( const auto iter = Unique.find(key); iter != Unique.end() )
+		
+		std::uint32_t index;
+		if ( FreeNodes.empty() ) {
+			if ( Nodes.size() > std::numeric_limits<Edge>::max() >> 1 ) {
+				throw std::length_error{"Too many BDD nodes!"};
+			} //if ( Nodes.size() > std::numeric_limits<Edge>::max() >> 1 )
+			index = static_cast<std::uint32_t>(Nodes.size());
+			Nodes.push_back({lvl, low, high, 0});
+		} //if ( FreeNodes.empty() )
+		else {
+			index = FreeNodes.back();
+			FreeNodes.pop_back();
+			Nodes[index] = {lvl, low, high, 0};
+		} //else -> if ( FreeNodes.empty() )
+		Unique.emplace(key, index);
+		return (index << 1) | (complemented ? 1u : 0u);
+	}
+	
+	CacheEntry& cacheEntry(const Edge f, const Edge g, const Edge h) noexcept {
+		const auto hash = details::hashCombine(details::hashCombine(f, g), h);
+		return Cache[hash & (Cache.size() - 1)];
+	}
+	
+	Edge iteEdge(Edge f, Edge g, Edge h) {
+		if ( f == True ) {
+			return g;
+		} //if ( f == True )
+		if ( f == False ) {
+			return h;
+		} //if ( f == False )
+		
+		if ( g == f ) {
+			g = True;
+		} //if ( g == f )
+		else if ( g == complement(f) ) {
+			g = False;
+		} //else if ( g == complement(f) )
+		if ( h == f ) {
+			h = False;
+		} //if ( h == f )
+		else if ( h == complement(f) ) {
+			h = True;
+		} //else if ( h == complement(f) )
+		
+		if ( g == h ) {
+			return g;
+		} //if ( g == h )
+		if ( g == True && h == False ) {
+			return f;
+		} //if ( g == True && h == False )
+		if ( g == False && h == True ) {
+			return complement(f);
+		} //if ( g == False && h == True )
+		
+		//Normalize to a regular f and g, so equal calls share one cache entry.
+		if ( isComplemented(f) ) {
+			f = complement(f);
+			std::swap(g, h);
+		} //if ( isComplemented(f) )
+		const bool complemented = isComplemented(g);
+		if ( complemented ) {
+			g = complement(g);
+			h = complement(h);
+		} //if ( complemented )
+		
+		if ( const auto& entry = cacheEntry(f, g, h); entry.Valid && entry.F == f && entry.G == g && entry.H == h ) {
+			return entry.Result ^ (complemented ? 1u : 0u);
+		} //if ( const auto& entry = cacheEntry(f, g, h); entry.Valid && ... )
+		
+		const auto top  = std::min({level(f), level(g), level(h)});
+		const auto high = iteEdge(cofactor(f, top, true), cofactor(g, top, true), cofactor(h, top, true));
+		const auto low  = iteEdge(cofactor(f, top, false), cofactor(g, top, false), cofactor(h, top, false));
+		const auto ret  = makeNode(top, low, high);
+		
+		cacheEntry(f, g, h) = {f, g, h, ret, true};
+		return ret ^ (complemented ? 1u : 0u);
+	}
+	
+	Edge buildEdge(const RtFormula& f) {
+		using Kind = RtFormula::Kind;
+		const auto junction = [this, &f](const Edge neutral) {
+				auto ret = neutral;
+				for ( const auto& child : f.Children ) {
+					const auto c = buildEdge(child);
+					ret = neutral == True ? iteEdge(ret, c, False) : iteEdge(ret, True, c);
+				} //for ( const auto& child : f.Children )
+				return ret;
+			};
+		
+		switch ( f.K ) {
+			case Kind::True       : return True;
+			case Kind::False      : return False;
+			case Kind::Predicate  : {
+				if ( !f.Terms.empty() ) {
+					throw std::invalid_argument{"Predicate " + f.N->string() + " is not propositional!"};
+				} //if ( !f.Terms.empty() )
+				return variableEdge(*f.N);
+			} //case Kind::Predicate
+			case Kind::Not        : return complement(buildEdge(f.Children.front()));
+			case Kind::And        : return junction(True);
+			case Kind::Or         : return junction(False);
+			case Kind::Implies    : {
+				const auto f1 = buildEdge(f.Children[0]);
+				return iteEdge(f1, buildEdge(f.Children[1]), True);
+			} //case Kind::Implies
+			case Kind::Equivalent : {
+				const auto f1 = buildEdge(f.Children[0]);
+				const auto f2 = buildEdge(f.Children[1]);
+				return iteEdge(f1, f2, complement(f2));
+			} //case Kind::Equivalent
+			case Kind::Equality   :
+			case Kind::Exists     :
+			case Kind::ForAll     : break;
+		} //switch ( f.K )
+		throw std::invalid_argument{"Formula is not propositional!"};
+	}
+	
+	Edge variableEdge(const RtName& name) {
+		if ( const auto iter = Levels.find(name); iter != Levels.end() ) {
+			return makeNode(iter->second, False, True);
+		} //if ( const auto iter = Levels.find(name); iter != Levels.end() )
+		declare({name});
+		return makeNode(Levels.at(name), False, True);
+	}
+	
+	void reference(const Edge e) noexcept {
+		++Nodes[nodeOf(e)].References;
+		return;
+	}
+	
+	void dereference(const Edge e) noexcept {
+		--Nodes[nodeOf(e)].References;
+		return;
+	}
+	
+	void collectIfNeeded(void) {
+		if ( Unique.size() >= CollectAt ) {
+			collectGarbage();
+			CollectAt = std::max(CollectAt, 2 * Unique.size());
+		} //if ( Unique.size() >= CollectAt )
+		return;
+	}
+	
+	public:
+	explicit BddManager(const std::size_t cacheSizeLog2 = 16) : Cache(std::size_t{1} << cacheSizeLog2) {
+		return;
+	}
+	
+	BddManager(const BddManager&) = delete;
+	BddManager& operator=(const BddManager&) = delete;
+	
+	/**
+	 * @brief Returns the variables of the propositional formula, ordered by the heuristic.
+	 */
+	static std::vector<RtName> variableOrder(const RtFormula& f, const VariableOrder order) {
+		std::vector<RtName> ret;
+		std::unordered_map<RtName, std::size_t> occurrences;
+		visit(f, [&ret, &occurrences](const auto& node) {
+				if constexpr ( std::is_same_v<std::decay_t<decltype(node)>, RtFormula> ) {
+					if ( node.K == RtFormula::Kind::Predicate && occurrences[*node.N]++ == 0 ) {
+						ret.push_back(*node.N);
+					} //if ( node.K == RtFormula::Kind::Predicate && occurrences[*node.N]++ == 0 )
+				} //if constexpr ( std::is_same_v<std::decay_t<decltype(node)>, RtFormula> )
+				return true;
+			});
+		
+		switch ( order ) {
+			case VariableOrder::Appearance   : break;
+			case VariableOrder::Frequency    : {
+				std::stable_sort(ret.begin(), ret.end(), [&occurrences](const RtName& n1, const RtName& n2) {
+						return occurrences[n1] > occurrences[n2];
+					});
+				break;
+			} //case VariableOrder::Frequency
+			case VariableOrder::Alphabetical : {
+				std::sort(ret.begin(), ret.end(), [](const RtName& n1, const RtName& n2) noexcept {
+						return n1.string() < n2.string();
+					});
+				break;
+			} //case VariableOrder::Alphabetical
+		} //switch ( order )
+		return ret;
+	}
+	
+	/**
+	 * @brief Appends the unknown variables to the order, the order of the known ones can not be changed.
+	 */
+	void declare(const std::vector<RtName>& variables) {
+		for ( const auto& variable : variables ) {
+			if ( Levels.count(variable) ) {
+				continue;
+			} //if ( Levels.count(variable) )
+			if ( Variables.size() >= TerminalLevel ) {
+				throw std::length_error{"Too many BDD variables!"};
+			} //if ( Variables.size() >= TerminalLevel )
+			Levels.emplace(variable, static_cast<std::uint32_t>(Variables.size()));
+			Variables.push_back(variable);
+		} //for ( const auto& variable : variables )
+		return;
+	}
+	
+	const std::vector<RtName>& variables(void) const noexcept {
+		return Variables;
+	}
+	
+	Bdd constant(const bool value) noexcept {
+		return {this, value ? True : False};
+	}
+	
+	Bdd variable(const RtName& name) {
+		return {this, variableEdge(name)};
+	}
+	
+	/**
+	 * @brief Returns if f then g else h.
+	 */
+	Bdd ite(const Bdd& f, const Bdd& g, const Bdd& h) {
+		if ( f.Manager != this || g.Manager != this || h.Manager != this ) {
+			throw std::invalid_argument{"BDDs of different managers can not be combined!"};
+		} //if ( f.Manager != this || g.Manager != this || h.Manager != this )
+		collectIfNeeded();
+		return {this, iteEdge(f.Edge, g.Edge, h.Edge)};
+	}
+	
+	/**
+	 * @brief Builds the diagram of the propositional formula, its new variables are ordered by the heuristic.
+	 */
+	Bdd build(const RtFormula& f, const VariableOrder order = VariableOrder::Appearance) {
+		declare(variableOrder(f, order));
+		collectIfNeeded();
+		return {this, buildEdge(f)};
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	Bdd build(const T& f, const VariableOrder order = VariableOrder::Appearance) {
+		return build(toRuntime(f), order);
+	}
+	
+	/**
+	 * @brief Returns the number of live nodes, including the terminal.
+	 */
+	std::size_t nodeCount(void) const noexcept {
+		return Unique.size() + 1;
+	}
+	
+	/**
+	 * @brief Frees all nodes which are not reachable from a Bdd and clears the cache.
+	 * @return The number of freed nodes.
+	 */
+	std::size_t collectGarbage(void) {
+		std::vector<bool> marked(Nodes.size(), false);
+		std::vector<std::uint32_t> stack;
+		for ( std::uint32_t index = 0; index < Nodes.size(); ++index ) {
+			if ( Nodes[index].References > 0 ) {
+				stack.push_back(index);
+			} //if ( Nodes[index].References > 0 )
+		} //for ( std::uint32_t index = 0; index < Nodes.size(); ++index )
+		while ( !stack.empty() ) {
+			const auto index = stack.back();
+			stack.pop_back();
+			if ( marked[index] ) {
+				continue;
+			} //if ( marked[index] )
+			marked[index] = true;
+			if ( Nodes[index].Level != TerminalLevel ) {
+				stack.push_back(nodeOf(Nodes[index].Low));
+				stack.push_back(nodeOf(Nodes[index].High));
+			} //if ( Nodes[index].Level != TerminalLevel )
+		} //while ( !stack.empty() )
+		
+		std::size_t freed = 0;
+		for ( std::uint32_t index = 1; index < Nodes.size(); ++index ) {
+			const auto& node = Nodes[index];
+			if ( !marked[index] && node.Level != TerminalLevel ) {
+				Unique.erase({node.Level, node.Low, node.High});
+				Nodes[index].Level = TerminalLevel;
+				FreeNodes.push_back(index);
+				++freed;
+			} //if ( !marked[index] && node.Level != TerminalLevel )
+		} //for ( std::uint32_t index = 1; index < Nodes.size(); ++index )
+		std::fill(Cache.begin(), Cache.end(), CacheEntry{});
+		return freed;
+	}
+};
+
+inline Bdd::Bdd(BddManager *manager, const std::uint32_t edge) noexcept : Manager{manager}, Edge{edge} {
+	Manager->reference(Edge);
+	return;
+}
+
+inline Bdd::Bdd(const Bdd& that) noexcept : Manager{that.Manager}, Edge{that.Edge} {
+	if ( Manager ) {
+		Manager->reference(Edge);
+	} //if ( Manager )
+	return;
+}
+
+inline Bdd::Bdd(Bdd&& that) noexcept : Manager{that.Manager}, Edge{that.Edge} {
+	that.Manager = nullptr;
+	return;
+}
+
+inline Bdd& Bdd::operator=(Bdd that) noexcept {
+	std::swap(Manager, that.Manager);
+	std::swap(Edge, that.Edge);
+	return *this;
+}
+
+inline Bdd::~Bdd(void) noexcept {
+	if ( Manager ) {
+		Manager->dereference(Edge);
+	} //if ( Manager )
+	return;
+}
+
+inline bool Bdd::isTrue(void) const noexcept {
+	return Manager && Edge == BddManager::True;
+}
+
+inline bool Bdd::isFalse(void) const noexcept {
+	return Manager && Edge == BddManager::False;
+}
+
+inline std::size_t Bdd::nodeCount(void) const {
+	if ( !Manager ) {
+		return 0;
+	} //if ( !Manager )
+	std::vector<std::uint32_t> stack{BddManager::nodeOf(Edge)};
+	std::vector<bool> seen(Manager->Nodes.size(), false);
+	std::size_t ret = 0;
+	while ( !stack.empty() ) {
+		const auto index = stack.back();
+		stack.pop_back();
+		if ( seen[index] ) {
+			continue;
+		} //if ( seen[index] )
+		seen[index] = true;
+		++ret;
+		if ( const auto& node = Manager->Nodes[index]; node.Level != BddManager::TerminalLevel ) {
+			stack.push_back(BddManager::nodeOf(node.Low));
+			stack.push_back(BddManager::nodeOf(node.High));
+		} //if ( const auto& node = Manager->Nodes[index]; node.Level != BddManager::TerminalLevel )
+	} //while ( !stack.empty() )
+	return ret;
+}
+
+inline double Bdd::satCount(void) const {
+	if ( !Manager ) {
+		return 0;
+	} //if ( !Manager )
+	
+	//The fraction of all assignments which satisfy the regular edge to the node.
+	std::unordered_map<std::uint32_t, double> fractions{{0, 1.0}};
+	const auto fraction = [this, &fractions](const auto& self, const BddManager::Edge e) -> double {
+			const auto index = BddManager::nodeOf(e);
+			auto iter = fractions.find(index);
+			if ( iter == fractions.end() ) {
+				const auto& node = Manager->Nodes[index];
+				iter = fractions.emplace(index, (self(self, node.Low) + self(self, node.High)) / 2).first;
+			} //if ( iter == fractions.end() )
+			return BddManager::isComplemented(e) ? 1 - iter->second : iter->second;
+		};
+	
+	double assignments = 1;
+	for ( std::size_t i = 0; i < Manager->Variables.size(); ++i ) {
+		assignments *= 2;
+	} //for ( std::size_t i = 0; i < Manager->Variables.size(); ++i )
+	return fraction(fraction, Edge) * assignments;
+}
+
+inline BddManager& Bdd::manager(void) const {
+	if ( !Manager ) {
+		throw std::logic_error{"The BDD has no manager!"};
+	} //if ( !Manager )
+	return *Manager;
+}
+
+inline Bdd Bdd::operator!(void) const {
+	return {&manager(), BddManager::complement(Edge)};
+}
+
+inline Bdd Bdd::operator&(const Bdd& that) const {
+	return manager().ite(*this, that, manager().constant(false));
+}
+
+inline Bdd Bdd::operator|(const Bdd& that) const {
+	return manager().ite(*this, manager().constant(true), that);
+}
+
+inline Bdd Bdd::implies(const Bdd& that) const {
+	return manager().ite(*this, that, manager().constant(true));
+}
+
+inline Bdd Bdd::equivalent(const Bdd& that) const {
+	return manager().ite(*this, that, !that);
+}
+
+} //namespace fol
+
+#endif
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks bytecode.hpp for self-containment.
+ * 
+ */
+
+#include "bytecode.hpp"
@@ -0,0 +1,364 @@
+/**
+ * @file
+ * @brief Contains the compilation of formulas to a flat instruction stream and its interpreter.
+ */
+
+#ifndef FOL_BYTECODE_HPP
+#define FOL_BYTECODE_HPP
+
+#include "evaluation.hpp"
+#include "name.hpp"
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+namespace bytecode {
+/**
+ * @brief The operations of the machine.
+ *
+ * The machine has a truth register, a stack of domain elements and a slot per variable. Terms push their value, atoms
+ * pop their arguments and set the register, the junctions jump out as soon as the register decides them.
+ */
+enum class OpCode : std::uint8_t {
+	LoadVariable,   //Push Slots[A].
+	ApplyFunction,  //Replace the top B elements by function A applied to them.
+	Predicate,      //Set the register to predicate A of the top B elements and pop them.
+	Equal,          //Set the register to whether the top two elements are equal and pop them.
+	Constant,       //Set the register to A.
+	Not,            //Negate the register.
+	JumpIfFalse,    //Continue at A if the register is false.
+	JumpIfTrue,     //Continue at A if the register is true.
+	PushTruth,      //Push the register.
+	Equivalent,     //Set the register to whether it equals the popped truth value.
+	QuantifierInit, //Set Slots[A] to the first element.
+	ForAllNext,     //If the register is true and Slots[A] has a next element, step and continue at B.
+	ExistsNext      //If the register is false and Slots[A] has a next element, step and continue at B.
+};
+
+struct Instruction {
+	OpCode Op;
+	std::uint32_t A;
+	std::uint32_t B;
+};
+} //namespace bytecode
+
+/**
+ * @brief A formula compiled against the signature of an interpretation.
+ *
+ * The compiled formula can be run in every interpretation which defines the same predicates and functions with the
+ * same ids and arities, i.e. which were defined in the same order. The free variables get the first slots, in the
+ * order of their first occurrence.
+ */
+class CompiledFormula {
+	public:
+	using Element = Interpretation::Element;
+	
+	private:
+	struct Use {
+		bool IsPredicate;
+		RtName Name;
+		std::uint32_t Id;
+		std::size_t Arity;
+	};
+	
+	std::vector<bytecode::Instruction> Code;
+	std::vector<RtName> FreeVariables;
+	std::vector<Use> Uses;
+	std::uint32_t SlotCount = 0;
+	std::size_t MaxStack    = 0;
+	
+	struct Compiler {
+		CompiledFormula& Target;
+		const Interpretation& Interp;
+		std::vector<std::pair<RtName, std::uint32_t>> Scopes;
+		std::vector<std::pair<RtName, std::uint32_t>> Free;
+		std::size_t Stack = 0;
+		
+		std::uint32_t here(void) const noexcept {
+			return static_cast<std::uint32_t>(Target.Code.size());
+		}
+		
+		void emit(const bytecode::OpCode op, const std::uint32_t a = 0, const std::uint32_t b = 0) {
+			Target.Code.push_back({op, a, b});
+			return;
+		}
+		
+		void push(void) {
+			Target.MaxStack = std::max(Target.MaxStack, ++Stack);
+			return;
+		}
+		
+		std::uint32_t variable(const RtName& name) {
+			for ( auto iter = Scopes.rbegin(); iter != Scopes.rend(); ++iter ) {
+				if ( iter->first == name ) {
+					return iter->second;
+				} //if ( iter->first == name )
+			} //for ( auto iter = Scopes.rbegin(); iter != Scopes.rend(); ++iter )
+			for ( const auto& [freeName, slot] : Free ) {
+				if ( freeName == name ) {
+					return slot;
+				} //if ( freeName == name )
+			} //for ( const auto& [freeName, slot] : Free )
+			Free.emplace_back(name, Target.SlotCount);
+			return Target.SlotCount++;
+		}
+		
+		std::uint32_t symbol(const bool isPredicate, const RtName& name, const std::size_t arity) {
+			const auto id = isPredicate ? Interp.predicateId(name) : Interp.functionId(name);
+			if ( !id || (isPredicate ? Interp.predicateArity(*id) : Interp.functionArity(*id)) != arity ) {
+				throw std::invalid_argument{"Symbol " + name.string() + " is not interpreted with this arity!"};
+			} //if ( !id || (isPredicate ? Interp.predicateArity(*id) : Interp.functionArity(*id)) != arity )
+			Target.Uses.push_back({isPredicate, name, *id, arity});
+			return *id;
+		}
+		
+		void compile(const RtTerm& t) {
+			if ( t.isVariable() ) {
+				emit(bytecode::OpCode::LoadVariable, variable(t.Name));
+				push();
+				return;
+			} //if ( t.isVariable() )
+			for ( const auto& arg : t.Args ) {
+				compile(arg);
+			} //for ( const auto& arg : t.Args )
+			const auto arity = static_cast<std::uint32_t>(t.Args.size());
+			emit(bytecode::OpCode::ApplyFunction, symbol(false, t.Name, arity), arity);
+			Stack -= arity;
+			push();
+			return;
+		}
+		
+		void compileJunction(const RtFormula& f, const bytecode::OpCode exit) {
+			if ( f.Children.empty() ) {
+				emit(bytecode::OpCode::Constant, f.K == RtFormula::Kind::And ? 1 : 0);
+				return;
+			} //if ( f.Children.empty() )
+			
+			std::vector<std::uint32_t> jumps;
+			for ( std::size_t i = 0; i < f.Children.size(); ++i ) {
+				compile(f.Children[i]);
+				if ( i + 1 < f.Children.size() ) {
+					jumps.push_back(here());
+					emit(exit);
+				} //if ( i + 1 < f.Children.size() )
+			} //for ( std::size_t i = 0; i < f.Children.size(); ++i )
+			for ( const auto jump : jumps ) {
+				Target.Code[jump].A = here();
+			} //for ( const auto jump : jumps )
+			return;
+		}
+		
+		void compile(const RtFormula& f) {
+			using bytecode::OpCode;
+			using Kind = RtFormula::Kind;
+			switch ( f.K ) {
+				case Kind::True       :
+				case Kind::False      : emit(OpCode::Constant, f.K == Kind::True ? 1 : 0); break;
+				case Kind::Predicate  : {
+					for ( const auto& term : f.Terms ) {
+						compile(term);
+					} //for ( const auto& term : f.Terms )
+					const auto arity = static_cast<std::uint32_t>(f.Terms.size());
+					emit(OpCode::Predicate, symbol(true, *f.N, arity), arity);
+					Stack -= arity;
+					break;
+				} //case Kind::Predicate
+				case Kind::Equality   : {
+					compile(f.Terms[0]);
+					compile(f.Terms[1]);
+					emit(OpCode::Equal);
+					Stack -= 2;
+					break;
+				} //case Kind::Equality
+				case Kind::Not        : compile(f.Children.front()); emit(OpCode::Not); break;
+				case Kind::And        : compileJunction(f, OpCode::JumpIfFalse); break;
+				case Kind::Or         : compileJunction(f, OpCode::JumpIfTrue); break;
+				case Kind::Implies    : {
+					compile(f.Children[0]);
+					emit(OpCode::Not);
+					const auto jump = here();
+					emit(OpCode::JumpIfTrue);
+					compile(f.Children[1]);
+					Target.Code[jump].A = here();
+					break;
+				} //case Kind::Implies
+				case Kind::Equivalent : {
+					compile(f.Children[0]);
+					emit(OpCode::PushTruth);
+					push();
+					compile(f.Children[1]);
+					emit(OpCode::Equivalent);
+					--Stack;
+					break;
+				} //case Kind::Equivalent
+				case Kind::Exists     :
+				case Kind::ForAll     : {
+					const auto slot = Target.SlotCount++;
+					emit(OpCode::QuantifierInit, slot);
+					const auto body = here();
+					Scopes.emplace_back(*f.N, slot);
+					compile(f.Children.front());
+					Scopes.pop_back();
+					emit(f.K == Kind::ForAll ? OpCode::ForAllNext : OpCode::ExistsNext, slot, body);
+					break;
+				} //case Kind::Exists, Kind::ForAll
+			} //switch ( f.K )
+			return;
+		}
+	};
+	
+	public:
+	CompiledFormula(const RtFormula& f, const Interpretation& interpretation) {
+		Compiler compiler{*this, interpretation, {}, {}, 0};
+		compiler.compile(f);
+		if ( Code.size() >= std::numeric_limits<std::uint32_t>::max() ) {
+			throw std::length_error{"Formula too large to compile!"};
+		} //if ( Code.size() >= std::numeric_limits<std::uint32_t>::max() )
+		
+		//The free variables were numbered while compiling, move them in front of the bound ones.
+		std::vector<std::uint32_t> remap(SlotCount);
+		std::uint32_t next = 0;
+		for ( const auto& [name, slot] : compiler.Free ) {
+			remap[slot] = next++;
+			FreeVariables.push_back(name);
+		} //for ( const auto& [name, slot] : compiler.Free )
+		std::vector<bool> isFree(SlotCount, false);
+		for ( const auto& free : compiler.Free ) {
+			isFree[free.second] = true;
+		} //for ( const auto& free : compiler.Free )
+		for ( std::uint32_t slot = 0; slot < SlotCount; ++slot ) {
+			if ( !isFree[slot] ) {
+				remap[slot] = next++;
+			} //if ( !isFree[slot] )
+		} //for ( std::uint32_t slot = 0; slot < SlotCount; ++slot )
+		for ( auto& instruction : Code ) {
+			switch ( instruction.Op ) {
+				case bytecode::OpCode::LoadVariable   :
+				case bytecode::OpCode::QuantifierInit :
+				case bytecode::OpCode::ForAllNext     :
+				case bytecode::OpCode::ExistsNext     : instruction.A = remap[instruction.A]; break;
+				default                               : break;
+			} //switch ( instruction.Op )
+		} //for ( auto& instruction : Code )
+		return;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	CompiledFormula(const T& f, const Interpretation& interpretation) :
+			CompiledFormula{toRuntime(f), interpretation} {
+		return;
+	}
+	
+	const std::vector<bytecode::Instruction>& code(void) const noexcept {
+		return Code;
+	}
+	
+	/**
+	 * @brief The free variables, the values passed to Machine::run() are in this order.
+	 */
+	const std::vector<RtName>& freeVariables(void) const noexcept {
+		return FreeVariables;
+	}
+	
+	/**
+	 * @brief Runs a compiled formula in one interpretation, keeping its buffers for the next run.
+	 */
+	class Machine {
+		const CompiledFormula *Program;
+		const Interpretation *Interp;
+		std::vector<Element> Slots;
+		std::vector<Element> Stack;
+		
+		public:
+		Machine(const CompiledFormula& program, const Interpretation& interpretation) : Program{&program},
+				Interp{&interpretation}, Slots(program.SlotCount), Stack(program.MaxStack) {
+			for ( const auto& use : program.Uses ) {
+				const auto id = use.IsPredicate ? interpretation.predicateId(use.Name) :
+				                                  interpretation.functionId(use.Name);
+				const bool matches = id == use.Id && (use.IsPredicate ? interpretation.predicateArity(*id) :
+				                                                        interpretation.functionArity(*id)) == use.Arity;
+				if ( !matches ) {
+					throw std::invalid_argument{"Interpretation has a different signature!"};
+				} //if ( !matches )
+			} //for ( const auto& use : program.Uses )
+			return;
+		}
+		
+		/**
+		 * @brief Evaluates the formula with the free variables set to freeValues.
+		 */
+		bool run(const Element *freeValues) noexcept {
+			using bytecode::OpCode;
+			const auto *code       = Program->Code.data();
+			const auto codeSize    = static_cast<std::uint32_t>(Program->Code.size());
+			const auto domainSize  = Interp->domainSize();
+			Element *slots         = Slots.data();
+			Element *top           = Stack.data();
+			bool truth             = false;
+			
+			std::copy(freeValues, freeValues + Program->FreeVariables.size(), slots);
+			for ( std::uint32_t pc = 0; pc < codeSize; ) {
+				const auto& instruction = code[pc++];
+				switch ( instruction.Op ) {
+					case OpCode::LoadVariable   : *top++ = slots[instruction.A]; break;
+					case OpCode::ApplyFunction  : {
+						top -= instruction.B;
+						*top = Interp->apply(instruction.A, top);
+						++top;
+						break;
+					} //case OpCode::ApplyFunction
+					case OpCode::Predicate      : {
+						top  -= instruction.B;
+						truth = Interp->holds(instruction.A, top);
+						break;
+					} //case OpCode::Predicate
+					case OpCode::Equal          : top -= 2; truth = top[0] == top[1]; break;
+					case OpCode::Constant       : truth = instruction.A != 0; break;
+					case OpCode::Not            : truth = !truth; break;
+					case OpCode::JumpIfFalse    : pc = truth ? pc : instruction.A; break;
+					case OpCode::JumpIfTrue     : pc = truth ? instruction.A : pc; break;
+					case OpCode::PushTruth      : *top++ = truth ? 1 : 0; break;
+					case OpCode::Equivalent     : truth = (*--top != 0) == truth; break;
+					case OpCode::QuantifierInit : slots[instruction.A] = 0; break;
+					case OpCode::ForAllNext     : {
+						if ( truth && ++slots[instruction.A] < domainSize ) {
+							pc = instruction.B;
+						} //if ( truth && ++slots[instruction.A] < domainSize )
+						break;
+					} //case OpCode::ForAllNext
+					case OpCode::ExistsNext     : {
+						if ( !truth && ++slots[instruction.A] < domainSize ) {
+							pc = instruction.B;
+						} //if ( !truth && ++slots[instruction.A] < domainSize )
+						break;
+					} //case OpCode::ExistsNext
+				} //switch ( instruction.Op )
+			} //for ( std::uint32_t pc = 0; pc < codeSize; )
+			return truth;
+		}
+		
+		bool run(const std::vector<Element>& freeValues) {
+			if ( freeValues.size() != Program->FreeVariables.size() ) {
+				throw std::invalid_argument{"Wrong number of values for the free variables!"};
+			} //if ( freeValues.size() != Program->FreeVariables.size() )
+			return run(freeValues.data());
+		}
+	};
+	
+	Machine machine(const Interpretation& interpretation) const {
+		return {*this, interpretation};
+	}
+};
+
+} //namespace fol
+
+#endif
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks clause_store.hpp for self-containment.
+ * 
+ */
+
+#include "clause_store.hpp"
@@ -0,0 +1,278 @@
+/**
+ * @file
+ * @brief Contains a flat clause database.
+ */
+
+#ifndef FOL_CLAUSE_STORE_HPP
+#define FOL_CLAUSE_STORE_HPP
+
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief Stores clauses as packed literals in one contiguous array.
+ *
+ * The atoms (predicates and equalities) are interned, a literal is the atom id shifted by one with the lowest bit
+ * marking the negation. The literals of clause i are Literals[Offsets[i], Offsets[i+1]), activity and flags are kept in
+ * side arrays indexed by the clause. Removing a clause only flags it, compact() reclaims the space.
+ */
+class ClauseStore {
+	public:
+	using Literal     = std::uint32_t;
+	using AtomId      = std::uint32_t;
+	using ClauseIndex = std::uint32_t;
+	
+	enum Flag : std::uint8_t { Deleted = 1, Learnt = 2 };
+	
+	static constexpr ClauseIndex InvalidClause = std::numeric_limits<ClauseIndex>::max();
+	
+	private:
+	std::vector<RtFormula> Atoms;
+	std::unordered_multimap<std::size_t, AtomId> AtomIds;
+	
+	std::vector<Literal> Literals;
+	std::vector<std::uint32_t> Offsets{0};
+	std::vector<float> Activities;
+	std::vector<std::uint8_t> Flags;
+	
+	std::size_t DeletedClauses = 0;
+	std::size_t WastedLiterals = 0;
+	
+	AtomId intern(const RtFormula& atom) {
+		const auto hash = std::hash<RtFormula>{}(atom);
+		for ( auto [iter, end] = AtomIds.equal_range(hash); iter != end; ++iter ) {
+			if ( Atoms[iter->second] == atom ) {
+				return iter->second;
+			} //if ( Atoms[iter->second] == atom )
+		} //for ( auto [iter, end] = AtomIds.equal_range(hash); iter != end; ++iter )
+		
+		if ( Atoms.size() > (std::numeric_limits<Literal>::max() >> 1) ) {
+			throw std::length_error{"Too many atoms for the literal encoding!"};
+		} //if ( Atoms.size() > (std::numeric_limits<Literal>::max() >> 1) )
+		const auto id = static_cast<AtomId>(Atoms.size());
+		Atoms.push_back(atom);
+		AtomIds.emplace(hash, id);
+		return id;
+	}
+	
+	public:
+	static constexpr Literal makeLiteral(const AtomId atom, const bool negated) noexcept {
+		return static_cast<Literal>(atom << 1 | (negated ? 1u : 0u));
+	}
+	
+	static constexpr AtomId atomOf(const Literal literal) noexcept {
+		return literal >> 1;
+	}
+	
+	static constexpr bool isNegated(const Literal literal) noexcept {
+		return literal & 1;
+	}
+	
+	static constexpr Literal negated(const Literal literal) noexcept {
+		return literal ^ 1;
+	}
+	
+	/**
+	 * @brief Returns the literal for an atom or a negated atom, interning the atom if needed.
+	 */
+	Literal literal(const RtFormula& f) {
+		if ( f.isAtom() ) {
+			return makeLiteral(intern(f), false);
+		} //if ( f.isAtom() )
+		if ( f.K == RtFormula::Kind::Not && f.Children.front().isAtom() ) {
+			return makeLiteral(intern(f.Children.front()), true);
+		} //if ( f.K == RtFormula::Kind::Not && f.Children.front().isAtom() )
+		throw std::invalid_argument{"A literal has to be an atom or a negated atom!"};
+	}
+	
+	const RtFormula& atom(const AtomId id) const {
+		return Atoms.at(id);
+	}
+	
+	std::size_t atomCount(void) const noexcept {
+		return Atoms.size();
+	}
+	
+	/**
+	 * @brief Adds a clause of literals, whose atoms have to be interned with literal() before.
+	 */
+	template<typename Iter>
+	ClauseIndex add(Iter first, const Iter last, const std::uint8_t flags = 0) {
+		if ( Flags.size() >= InvalidClause ) {
+			throw std::length_error{"Too many clauses!"};
+		} //if ( Flags.size() >= InvalidClause )
+		
+		const auto oldSize = Literals.size();
+		for ( ; first != last; ++first ) {
+			if ( atomOf(*first) >= Atoms.size() ) {
+				Literals.resize(oldSize);
+				throw std::invalid_argument{"Literal of an atom which is not interned!"};
+			} //if ( atomOf(*first) >= Atoms.size() )
+			Literals.push_back(*first);
+		} //for ( ; first != last; ++first )
+		
+		if ( Literals.size() > std::numeric_limits<std::uint32_t>::max() ) {
+			Literals.resize(oldSize);
+			throw std::length_error{"Too many literals!"};
+		} //if ( Literals.size() > std::numeric_limits<std::uint32_t>::max() )
+		
+		Offsets.push_back(static_cast<std::uint32_t>(Literals.size()));
+		Activities.push_back(0.0f);
+		Flags.push_back(static_cast<std::uint8_t>(flags & ~Deleted));
+		return static_cast<ClauseIndex>(Flags.size() - 1);
+	}
+	
+	/**
+	 * @brief Adds a clause, that is a disjunction of literals or a single literal.
+	 */
+	ClauseIndex add(const RtFormula& clause, const std::uint8_t flags = 0) {
+		std::vector<Literal> literals;
+		if ( clause.K == RtFormula::Kind::Or ) {
+			literals.reserve(clause.Children.size());
+			for ( const auto& child : clause.Children ) {
+				literals.push_back(literal(child));
+			} //for ( const auto& child : clause.Children )
+		} //if ( clause.K == RtFormula::Kind::Or )
+		else {
+			literals.push_back(literal(clause));
+		} //else -> if ( clause.K == RtFormula::Kind::Or )
+		return add(literals.begin(), literals.end(), flags);
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	ClauseIndex add(const T& clause, const std::uint8_t flags = 0) {
+		return add(toRuntime(clause), flags);
+	}
+	
+	/**
+	 * @brief Returns the number of clause slots, including removed but not yet compacted clauses.
+	 */
+	std::size_t size(void) const noexcept {
+		return Flags.size();
+	}
+	
+	std::size_t liveClauses(void) const noexcept {
+		return Flags.size() - DeletedClauses;
+	}
+	
+	std::size_t literalCount(void) const noexcept {
+		return Literals.size() - WastedLiterals;
+	}
+	
+	std::size_t clauseSize(const ClauseIndex index) const noexcept {
+		return Offsets[index + 1] - Offsets[index];
+	}
+	
+	const Literal* begin(const ClauseIndex index) const noexcept {
+		return Literals.data() + Offsets[index];
+	}
+	
+	const Literal* end(const ClauseIndex index) const noexcept {
+		return Literals.data() + Offsets[index + 1];
+	}
+	
+	float& activity(const ClauseIndex index) noexcept {
+		return Activities[index];
+	}
+	
+	float activity(const ClauseIndex index) const noexcept {
+		return Activities[index];
+	}
+	
+	std::uint8_t flags(const ClauseIndex index) const noexcept {
+		return Flags[index];
+	}
+	
+	bool isDeleted(const ClauseIndex index) const noexcept {
+		return Flags[index] & Deleted;
+	}
+	
+	void remove(const ClauseIndex index) {
+		if ( index >= Flags.size() ) {
+			throw std::out_of_range{"Clause index out of range!"};
+		} //if ( index >= Flags.size() )
+		if ( !isDeleted(index) ) {
+			Flags[index] |= Deleted;
+			++DeletedClauses;
+			WastedLiterals += clauseSize(index);
+		} //if ( !isDeleted(index) )
+		return;
+	}
+	
+	/**
+	 * @brief Whether more than half of the literal array is occupied by removed clauses.
+	 */
+	bool needsCompaction(void) const noexcept {
+		return WastedLiterals * 2 > Literals.size();
+	}
+	
+	/**
+	 * @brief Removes the deleted clauses from the arrays.
+	 * @return The new index for every old clause index, InvalidClause for removed clauses.
+	 */
+	std::vector<ClauseIndex> compact(void) {
+		std::vector<ClauseIndex> newIndices(Flags.size(), InvalidClause);
+		std::uint32_t writeLiteral = 0;
+		ClauseIndex writeClause = 0;
+		
+		for ( ClauseIndex readClause = 0; readClause < Flags.size(); ++readClause ) {
+			if ( isDeleted(readClause) ) {
+				continue;
+			} //if ( isDeleted(readClause) )
+			
+			const auto first = Offsets[readClause], last = Offsets[readClause + 1];
+			Offsets[writeClause] = writeLiteral;
+			for ( auto readLiteral = first; readLiteral < last; ++readLiteral ) {
+				Literals[writeLiteral++] = Literals[readLiteral];
+			} //for ( auto readLiteral = first; readLiteral < last; ++readLiteral )
+			Activities[writeClause] = Activities[readClause];
+			Flags[writeClause]      = Flags[readClause];
+			newIndices[readClause]  = writeClause++;
+		} //for ( ClauseIndex readClause = 0; readClause < Flags.size(); ++readClause )
+		
+		Offsets[writeClause] = writeLiteral;
+		Offsets.resize(writeClause + 1u);
+		Literals.resize(writeLiteral);
+		Activities.resize(writeClause);
+		Flags.resize(writeClause);
+		DeletedClauses = 0;
+		WastedLiterals = 0;
+		return newIndices;
+	}
+	
+	/**
+	 * @brief Returns the clause as a disjunction of literals.
+	 */
+	RtFormula toFormula(const ClauseIndex index) const {
+		std::vector<RtFormula> literals;
+		literals.reserve(clauseSize(index));
+		for ( auto iter = begin(index), last = end(index); iter != last; ++iter ) {
+			const auto& a = Atoms[atomOf(*iter)];
+			literals.push_back(isNegated(*iter) ? RtFormula::negation(a) : a);
+		} //for ( auto iter = begin(index), last = end(index); iter != last; ++iter )
+		return RtFormula::disjunction(std::move(literals));
+	}
+	
+	/**
+	 * @brief Returns the bytes reserved for the clause arrays, without the atom table.
+	 */
+	std::size_t memoryUsage(void) const noexcept {
+		return Literals.capacity() * sizeof(Literal) + Offsets.capacity() * sizeof(std::uint32_t) +
+		       Activities.capacity() * sizeof(float) + Flags.capacity() * sizeof(std::uint8_t);
+	}
+};
+
+} //namespace fol
+
+#endif
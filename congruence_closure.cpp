@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks congruence_closure.hpp for self-containment.
+ * 
+ */
+
+#include "congruence_closure.hpp"
@@ -0,0 +1,404 @@
+/**
+ * @file
+ * @brief Contains a backtrackable congruence closure over ground terms.
+ */
+
+#ifndef FOL_CONGRUENCE_CLOSURE_HPP
+#define FOL_CONGRUENCE_CLOSURE_HPP
+
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief Decides the equalities which follow from a set of ground equalities by reflexivity, symmetry, transitivity,
+ * and congruence.
+ *
+ * The terms are hash consed, every node knows its representative directly. A merge moves the members of the smaller
+ * class to the larger one, and the nodes using the smaller class as an argument get a new signature, which is looked up
+ * in the signature table to find the nodes which became congruent. The table is never cleaned, a lookup compares the
+ * current signatures of the candidates, so outdated entries are harmless. Every change is recorded on a trail, pop()
+ * undoes the changes since the matching push() in reverse order, so no path compression is used.
+ */
+class CongruenceClosure {
+	public:
+	using TermId = std::uint32_t;
+	
+	private:
+	struct Node {
+		std::uint32_t Symbol;
+		std::uint32_t FirstArg;
+		std::uint32_t Arity;
+	};
+	
+	enum class Action : std::uint8_t { AddTerm, Merge, InsertSignature };
+	
+	/**
+	 * @brief A change to undo: a new term with its hash, a merge of First into Second with the old sizes of the
+	 * member and use lists of Second, or a new entry of the signature table with its hash.
+	 */
+	struct Change {
+		Action A;
+		TermId First;
+		TermId Second;
+		std::uint32_t MemberCount;
+		std::uint32_t UseCount;
+		std::size_t Hash;
+	};
+	
+	std::unordered_map<RtName, std::uint32_t> SymbolIds;
+	std::vector<RtName> SymbolNames;
+	std::vector<Node> Nodes;
+	std::vector<TermId> Args;
+	std::vector<TermId> Representative;
+	std::vector<std::vector<TermId>> Members;
+	std::vector<std::vector<TermId>> Uses;
+	std::unordered_multimap<std::size_t, TermId> Interned;
+	std::unordered_multimap<std::size_t, TermId> Signatures;
+	std::vector<Change> Trail;
+	std::vector<std::size_t> Checkpoints;
+	std::vector<std::pair<TermId, TermId>> Pending;
+	std::size_t MergeCount = 0;
+	
+	template<typename Map>
+	static std::size_t hashOf(const std::uint32_t symbol, const std::size_t arity, Map map) noexcept {
+		std::size_t ret = details::hashCombine(symbol, arity);
+		for ( std::size_t i = 0; i < arity; ++i ) {
+			ret = details::hashCombine(ret, map(i));
+		} //for ( std::size_t i = 0; i < arity; ++i )
+		return ret;
+	}
+	
+	std::size_t signatureHash(const TermId id) const noexcept {
+		const auto& node = Nodes[id];
+		return hashOf(node.Symbol, node.Arity, [this, &node](const std::size_t i) noexcept {
+				return Representative[Args[node.FirstArg + i]];
+			});
+	}
+	
+	bool congruent(const TermId a, const TermId b) const noexcept {
+		const auto& nodeA = Nodes[a];
+		const auto& nodeB = Nodes[b];
+		if ( nodeA.Symbol != nodeB.Symbol || nodeA.Arity != nodeB.Arity ) {
+			return false;
+		} //if ( nodeA.Symbol != nodeB.Symbol || nodeA.Arity != nodeB.Arity )
+		for ( std::uint32_t i = 0; i < nodeA.Arity; ++i ) {
+			if ( Representative[Args[nodeA.FirstArg + i]] != Representative[Args[nodeB.FirstArg + i]] ) {
+				return false;
+			} //if ( Representative[Args[nodeA.FirstArg + i]] != Representative[Args[nodeB.FirstArg + i]] )
+		} //for ( std::uint32_t i = 0; i < nodeA.Arity; ++i )
+		return true;
+	}
+	
+	/**
+	 * @brief Enters the current signature of the node into the table, or returns a different node with the same one.
+	 */
+	std::optional<TermId> insertSignature(const TermId id) {
+		const auto hash = signatureHash(id);
+		for ( auto [iter, end] = Signatures.equal_range(hash); iter != end; ++iter ) {
+			if ( iter->second != id && congruent(iter->second, id) ) {
+				return iter->second;
+			} //if ( iter->second != id && congruent(iter->second, id) )
+		} //for ( auto [iter, end] = Signatures.equal_range(hash); iter != end; ++iter )
+		Signatures.emplace(hash, id);
+		Trail.push_back({Action::InsertSignature, id, id, 0, 0, hash});
+		return std::nullopt;
+	}
+	
+	void processPending(void) {
+		while ( !Pending.empty() ) {
+			auto [from, into] = Pending.back();
+			Pending.pop_back();
+			from = Representative[from];
+			into = Representative[into];
+			if ( from == into ) {
+				continue;
+			} //if ( from == into )
+			if ( Members[from].size() > Members[into].size() ) {
+				std::swap(from, into);
+			} //if ( Members[from].size() > Members[into].size() )
+			
+			Trail.push_back({Action::Merge, from, into, static_cast<std::uint32_t>(Members[into].size()),
+			                 static_cast<std::uint32_t>(Uses[into].size()), 0});
+			++MergeCount;
+			for ( const auto member : Members[from] ) {
+				Representative[member] = into;
+				Members[into].push_back(member);
+			} //for ( const auto member : Members[from] )
+			for ( const auto use : Uses[from] ) {
+				Uses[into].push_back(use);
+				if ( const auto other = insertSignature(use) ) {
+					Pending.emplace_back(use, *other);
+				} //if ( const auto other = insertSignature(use) )
+			} //for ( const auto use : Uses[from] )
+		} //while ( !Pending.empty() )
+		return;
+	}
+	
+	void undo(const Change& change) {
+		switch ( change.A ) {
+			case Action::AddTerm         : {
+				const auto& node = Nodes[change.First];
+				for ( auto i = node.Arity; i > 0; --i ) {
+					Uses[Representative[Args[node.FirstArg + i - 1]]].pop_back();
+				} //for ( auto i = node.Arity; i > 0; --i )
+				eraseEntry(Interned, change.Hash, change.First);
+				Args.resize(node.FirstArg);
+				Nodes.pop_back();
+				Representative.pop_back();
+				Members.pop_back();
+				Uses.pop_back();
+				break;
+			} //case Action::AddTerm
+			case Action::Merge           : {
+				auto& members = Members[change.Second];
+				for ( auto i = change.MemberCount; i < members.size(); ++i ) {
+					Representative[members[i]] = change.First;
+				} //for ( auto i = change.MemberCount; i < members.size(); ++i )
+				members.resize(change.MemberCount);
+				Uses[change.Second].resize(change.UseCount);
+				break;
+			} //case Action::Merge
+			case Action::InsertSignature : {
+				eraseEntry(Signatures, change.Hash, change.First);
+				break;
+			} //case Action::InsertSignature
+		} //switch ( change.A )
+		return;
+	}
+	
+	static void eraseEntry(std::unordered_multimap<std::size_t, TermId>& map, const std::size_t hash, const TermId id) {
+		for ( auto [iter, end] = map.equal_range(hash); iter != end; ++iter ) {
+			if ( iter->second == id ) {
+				map.erase(iter);
+				return;
+			} //if ( iter->second == id )
+		} //for ( auto [iter, end] = map.equal_range(hash); iter != end; ++iter )
+		return;
+	}
+	
+	TermId intern(const RtTerm& t) {
+		if ( t.isVariable() ) {
+			throw std::invalid_argument{"Congruence closure only supports ground terms!"};
+		} //if ( t.isVariable() )
+		std::vector<TermId> args;
+		args.reserve(t.Args.size());
+		for ( const auto& arg : t.Args ) {
+			args.push_back(intern(arg));
+		} //for ( const auto& arg : t.Args )
+		
+		const auto [symbolIter, inserted] = SymbolIds.emplace(t.Name, static_cast<std::uint32_t>(SymbolNames.size()));
+		if ( inserted ) {
+			SymbolNames.push_back(t.Name);
+		} //if ( inserted )
+		const auto symbol = symbolIter->second;
+		const auto hash   = hashOf(symbol, args.size(), [&args](const std::size_t i) noexcept {
+				return args[i];
+			});
+		for ( auto [iter, end] = Interned.equal_range(hash); iter != end; ++iter ) {
+			const auto& node = Nodes[iter->second];
+			if ( node.Symbol == symbol && node.Arity == args.size() &&
+			     std::equal(args.begin(), args.end(), Args.begin() + static_cast<std::ptrdiff_t>(node.FirstArg)) ) {
+				return iter->second;
+			} //if ( node.Symbol == symbol && node.Arity == args.size() && ... )
+		} //for ( auto [iter, end] = Interned.equal_range(hash); iter != end; ++iter )
+		
+		if ( Nodes.size() >= std::numeric_limits<TermId>::max() ) {
+			throw std::length_error{"Too many terms!"};
+		} //if ( Nodes.size() >= std::numeric_limits<TermId>::max() )
+		const auto id = static_cast<TermId>(Nodes.size());
+		Nodes.push_back({symbol, static_cast<std::uint32_t>(Args.size()), static_cast<std::uint32_t>(args.size())});
+		Args.insert(Args.end(), args.begin(), args.end());
+		Representative.push_back(id);
+		Members.push_back({id});
+		Uses.emplace_back();
+		for ( const auto arg : args ) {
+			Uses[Representative[arg]].push_back(id);
+		} //for ( const auto arg : args )
+		Interned.emplace(hash, id);
+		Trail.push_back({Action::AddTerm, id, id, 0, 0, hash});
+		if ( const auto other = insertSignature(id) ) {
+			Pending.emplace_back(id, *other);
+		} //if ( const auto other = insertSignature(id) )
+		return id;
+	}
+	
+	/**
+	 * @brief Returns the representative of the class a term which may not be added would be in, nothing if it would be
+	 * in a class of its own.
+	 */
+	std::optional<TermId> lookup(const RtTerm& t) const {
+		const auto symbol = SymbolIds.find(t.Name);
+		if ( t.isVariable() || symbol == SymbolIds.end() ) {
+			return std::nullopt;
+		} //if ( t.isVariable() || symbol == SymbolIds.end() )
+		std::vector<TermId> args;
+		args.reserve(t.Args.size());
+		for ( const auto& arg : t.Args ) {
+			const auto representative = lookup(arg);
+			if ( !representative ) {
+				return std::nullopt;
+			} //if ( !representative )
+			args.push_back(*representative);
+		} //for ( const auto& arg : t.Args )
+		const auto hash = hashOf(symbol->second, args.size(), [&args](const std::size_t i) noexcept {
+				return args[i];
+			});
+		for ( auto [iter, end] = Signatures.equal_range(hash); iter != end; ++iter ) {
+			const auto& node = Nodes[iter->second];
+			bool same = node.Symbol == symbol->second && node.Arity == args.size();
+			for ( std::uint32_t i = 0; same && i < node.Arity; ++i ) {
+				same = Representative[Args[node.FirstArg + i]] == args[i];
+			} //for ( std::uint32_t i = 0; same && i < node.Arity; ++i )
+			if ( same ) {
+				return Representative[iter->second];
+			} //if ( same )
+		} //for ( auto [iter, end] = Signatures.equal_range(hash); iter != end; ++iter )
+		return std::nullopt;
+	}
+	
+	public:
+	/**
+	 * @brief Adds a ground term in a class of its own, unless it is congruent to a known term.
+	 */
+	TermId add(const RtTerm& t) {
+		const auto ret = intern(t);
+		processPending();
+		return ret;
+	}
+	
+	/**
+	 * @brief Merges the classes of the two terms, and all classes which become congruent by that.
+	 */
+	void merge(const TermId a, const TermId b) {
+		if ( a >= Nodes.size() || b >= Nodes.size() ) {
+			throw std::out_of_range{"Term id out of range!"};
+		} //if ( a >= Nodes.size() || b >= Nodes.size() )
+		Pending.emplace_back(a, b);
+		processPending();
+		return;
+	}
+	
+	void merge(const RtTerm& t1, const RtTerm& t2) {
+		const auto a = intern(t1);
+		const auto b = intern(t2);
+		merge(a, b);
+		return;
+	}
+	
+	/**
+	 * @brief Merges the two sides of a ground equality.
+	 */
+	void merge(const RtFormula& equality) {
+		if ( equality.K != RtFormula::Kind::Equality ) {
+			throw std::invalid_argument{"Only equalities can be merged!"};
+		} //if ( equality.K != RtFormula::Kind::Equality )
+		merge(equality.Terms[0], equality.Terms[1]);
+		return;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	void merge(const T& equality) {
+		merge(toRuntime(equality));
+		return;
+	}
+	
+	TermId find(const TermId id) const {
+		return Representative.at(id);
+	}
+	
+	bool equal(const TermId a, const TermId b) const {
+		return find(a) == find(b);
+	}
+	
+	/**
+	 * @brief Whether the two terms are equal, the terms do not have to be added.
+	 */
+	bool equal(const RtTerm& t1, const RtTerm& t2) const {
+		const auto a = lookup(t1);
+		const auto b = lookup(t2);
+		if ( a || b ) {
+			return a == b;
+		} //if ( a || b )
+		//Neither is congruent to a known term, so only the same symbol with equal arguments is equal.
+		if ( t1.isVariable() || t2.isVariable() ) {
+			return t1 == t2;
+		} //if ( t1.isVariable() || t2.isVariable() )
+		if ( t1.Name != t2.Name || t1.Args.size() != t2.Args.size() ) {
+			return false;
+		} //if ( t1.Name != t2.Name || t1.Args.size() != t2.Args.size() )
+		for ( std::size_t i = 0; i < t1.Args.size(); ++i ) {
+			if ( !equal(t1.Args[i], t2.Args[i]) ) {
+				return false;
+			} //if ( !equal(t1.Args[i], t2.Args[i]) )
+		} //for ( std::size_t i = 0; i < t1.Args.size(); ++i )
+		return true;
+	}
+	
+	/**
+	 * @brief Starts a new backtracking level.
+	 */
+	void push(void) {
+		Checkpoints.push_back(Trail.size());
+		return;
+	}
+	
+	/**
+	 * @brief Undoes all terms and merges since the last push().
+	 */
+	void pop(void) {
+		if ( Checkpoints.empty() ) {
+			throw std::logic_error{"There is no level to pop!"};
+		} //if ( Checkpoints.empty() )
+		while ( Trail.size() > Checkpoints.back() ) {
+			undo(Trail.back());
+			Trail.pop_back();
+		} //while ( Trail.size() > Checkpoints.back() )
+		Checkpoints.pop_back();
+		return;
+	}
+	
+	std::size_t level(void) const noexcept {
+		return Checkpoints.size();
+	}
+	
+	/**
+	 * @brief Returns the number of terms.
+	 */
+	std::size_t size(void) const noexcept {
+		return Nodes.size();
+	}
+	
+	/**
+	 * @brief Returns the number of performed merges of two classes, including the undone ones.
+	 */
+	std::size_t merges(void) const noexcept {
+		return MergeCount;
+	}
+	
+	RtTerm term(const TermId id) const {
+		const auto& node = Nodes.at(id);
+		std::vector<RtTerm> args;
+		args.reserve(node.Arity);
+		for ( std::uint32_t i = 0; i < node.Arity; ++i ) {
+			args.push_back(term(Args[node.FirstArg + i]));
+		} //for ( std::uint32_t i = 0; i < node.Arity; ++i )
+		return {SymbolNames[node.Symbol], std::move(args)};
+	}
+};
+
+} //namespace fol
+
+#endif
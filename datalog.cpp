@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks datalog.hpp for self-containment.
+ * 
+ */
+
+#include "datalog.hpp"
@@ -0,0 +1,720 @@
+/**
+ * @file
+ * @brief Contains the semi-naive bottom-up evaluation of Datalog rules.
+ */
+
+#ifndef FOL_DATALOG_HPP
+#define FOL_DATALOG_HPP
+
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief Computes the least model of function free Horn rules with stratified negation bottom-up.
+ *
+ * A rule is ForAll x1 ... ForAll xn . Implies{body, head} with a predicate as head and a predicate, a negated
+ * predicate, or a conjunction of them as body, a fact is a ground predicate. The arguments are variables or constants,
+ * every variable of the head or of a negated literal has to occur in a positive literal of the body.
+ *
+ * The constants are interned and a relation stores its tuples column by column. The relations only grow, so the
+ * tuples of an iteration are a range of rows and the delta relation is just the range of the last iteration. The
+ * predicates are put into strata, such that every negated relation is complete before it is used. Within a stratum
+ * each recursive literal of a rule takes once only the delta, the recursive literals before it the older rows, and the
+ * ones after it all rows up to the delta, so no derivation is repeated. The join starts with the delta and prefers the
+ * literals sharing a bound variable, a literal with known arguments is looked up in a hash index over these columns.
+ * The new tuples are appended after the iteration, an index over all columns rejects the duplicates.
+ */
+class DatalogEngine {
+	public:
+	using Constant = std::uint32_t;
+	
+	struct Options {
+		//Without it every rule is evaluated on all rows in every iteration, only useful for comparison.
+		bool SemiNaive = true;
+	};
+	
+	struct Report {
+		std::size_t Strata     = 0;
+		std::size_t Iterations = 0;
+		std::size_t Derived    = 0;
+	};
+	
+	private:
+	using RowId = std::uint32_t;
+	
+	static constexpr std::uint32_t NoIndex = std::numeric_limits<std::uint32_t>::max();
+	static constexpr std::size_t NoDelta   = std::numeric_limits<std::size_t>::max();
+	
+	/**
+	 * @brief A hash index over some columns, the rows of a bucket are ascending.
+	 */
+	struct Index {
+		std::vector<std::size_t> Columns;
+		std::unordered_map<std::size_t, std::vector<RowId>> Buckets;
+	};
+	
+	struct Relation {
+		RtName Name;
+		std::size_t Arity;
+		std::vector<std::vector<Constant>> Columns;
+		RowId Size = 0;
+		//The first index is over all columns.
+		std::vector<Index> Indexes;
+		std::size_t Stratum = 0;
+		bool Derived        = false;
+		//The rows [Old, DeltaEnd) are the delta of the current iteration.
+		RowId Old      = 0;
+		RowId DeltaEnd = 0;
+		//The tuples derived in the current iteration, one after the other.
+		std::vector<Constant> Pending;
+		std::size_t PendingCount = 0;
+		
+		Relation(RtName name, const std::size_t arity) : Name{std::move(name)}, Arity{arity}, Columns(arity) {
+			Indexes.push_back({{}, {}});
+			for ( std::size_t column = 0; column < arity; ++column ) {
+				Indexes.front().Columns.push_back(column);
+			} //for ( std::size_t column = 0; column < arity; ++column )
+			return;
+		}
+	};
+	
+	//A variable of the rule or a constant.
+	struct Argument {
+		bool IsVariable;
+		std::uint32_t Value;
+	};
+	
+	struct Literal {
+		std::uint32_t Relation;
+		bool Negated;
+		std::vector<Argument> Args;
+	};
+	
+	enum class Range : std::uint8_t { All, Old, Delta, Known };
+	
+	/**
+	 * @brief A literal of the join with the columns whose values are known before it, the columns which bind a
+	 * variable, and the columns which have to equal an earlier column of the literal.
+	 */
+	struct Step {
+		std::size_t Literal;
+		Range R;
+		std::uint32_t IndexId;
+		std::vector<std::pair<std::size_t, Argument>> Keys;
+		std::vector<std::pair<std::size_t, std::uint32_t>> Binds;
+		std::vector<std::pair<std::size_t, std::size_t>> Repeats;
+	};
+	
+	struct Rule {
+		Literal Head;
+		std::vector<Literal> Body;
+		std::size_t VariableCount;
+		//The first plan reads all known rows, the others have the delta at one of the recursive literals.
+		std::vector<std::vector<Step>> Plans;
+	};
+	
+	Options Opts;
+	std::unordered_map<RtName, Constant> ConstantIds;
+	std::vector<RtName> ConstantNames;
+	std::unordered_map<RtName, std::uint32_t> RelationIds;
+	std::vector<Relation> Relations;
+	std::vector<Rule> Rules;
+	bool Evaluated = false;
+	
+	template<typename Value>
+	static std::size_t hashKey(const std::size_t count, Value value) noexcept {
+		std::size_t ret = count;
+		for ( std::size_t i = 0; i < count; ++i ) {
+			ret = details::hashCombine(ret, value(i));
+		} //for ( std::size_t i = 0; i < count; ++i )
+		return ret;
+	}
+	
+	static void indexRow(const Relation& relation, Index& index, const RowId row) {
+		const auto hash = hashKey(index.Columns.size(), [&relation, &index, row](const std::size_t i) noexcept {
+				return relation.Columns[index.Columns[i]][row];
+			});
+		index.Buckets[hash].push_back(row);
+		return;
+	}
+	
+	static std::pair<RowId, RowId> rowRange(const Relation& relation, const Range range) noexcept {
+		switch ( range ) {
+			case Range::All   : return {0, relation.Size};
+			case Range::Old   : return {0, relation.Old};
+			case Range::Delta : return {relation.Old, relation.DeltaEnd};
+			case Range::Known : return {0, relation.DeltaEnd};
+		} //switch ( range )
+		return {0, relation.Size};
+	}
+	
+	void checkMutable(void) const {
+		if ( Evaluated ) {
+			throw std::logic_error{"The program was already evaluated!"};
+		} //if ( Evaluated )
+		return;
+	}
+	
+	Constant constantId(const RtName& name) {
+		const auto iter = ConstantIds.find(name);
+		if ( iter != ConstantIds.end() ) {
+			return iter->second;
+		} //if ( iter != ConstantIds.end() )
+		if ( ConstantNames.size() >= std::numeric_limits<Constant>::max() ) {
+			throw std::length_error{"Too many constants!"};
+		} //if ( ConstantNames.size() >= std::numeric_limits<Constant>::max() )
+		const auto ret = static_cast<Constant>(ConstantNames.size());
+		ConstantIds.emplace(name, ret);
+		ConstantNames.push_back(name);
+		return ret;
+	}
+	
+	std::uint32_t relationId(const RtName& name, const std::size_t arity) {
+		const auto [iter, inserted] = RelationIds.emplace(name, static_cast<std::uint32_t>(Relations.size()));
+		if ( inserted ) {
+			Relations.emplace_back(name, arity);
+		} //if ( inserted )
+		else if ( Relations[iter->second].Arity != arity ) {
+			throw std::invalid_argument{"Predicate " + name.string() + " has different arities!"};
+		} //else if ( Relations[iter->second].Arity != arity )
+		return iter->second;
+	}
+	
+	/**
+	 * @brief Returns the index of the relation over the columns, it is built if it does not exist yet.
+	 */
+	static std::uint32_t indexId(Relation& relation, std::vector<std::size_t> columns) {
+		for ( std::size_t id = 0; id < relation.Indexes.size(); ++id ) {
+			if ( relation.Indexes[id].Columns == columns ) {
+				return static_cast<std::uint32_t>(id);
+			} //if ( relation.Indexes[id].Columns == columns )
+		} //for ( std::size_t id = 0; id < relation.Indexes.size(); ++id )
+		relation.Indexes.push_back({std::move(columns), {}});
+		for ( RowId row = 0; row < relation.Size; ++row ) {
+			indexRow(relation, relation.Indexes.back(), row);
+		} //for ( RowId row = 0; row < relation.Size; ++row )
+		return static_cast<std::uint32_t>(relation.Indexes.size() - 1);
+	}
+	
+	/**
+	 * @brief Appends the tuple to the relation, returns false if it already is in it.
+	 */
+	static bool insertTuple(Relation& relation, const Constant *tuple) {
+		const auto hash = hashKey(relation.Arity, [tuple](const std::size_t i) noexcept { return tuple[i]; });
+		auto& bucket    = relation.Indexes.front().Buckets[hash];
+		for ( const auto row : bucket ) {
+			bool equal = true;
+			for ( std::size_t column = 0; column < relation.Arity && equal; ++column ) {
+				equal = relation.Columns[column][row] == tuple[column];
+			} //for ( std::size_t column = 0; column < relation.Arity && equal; ++column )
+			if ( equal ) {
+				return false;
+			} //if ( equal )
+		} //for ( const auto row : bucket )
+		
+		if ( relation.Size >= std::numeric_limits<RowId>::max() ) {
+			throw std::length_error{"Too many tuples in " + relation.Name.string() + "!"};
+		} //if ( relation.Size >= std::numeric_limits<RowId>::max() )
+		const RowId row = relation.Size++;
+		for ( std::size_t column = 0; column < relation.Arity; ++column ) {
+			relation.Columns[column].push_back(tuple[column]);
+		} //for ( std::size_t column = 0; column < relation.Arity; ++column )
+		bucket.push_back(row);
+		for ( std::size_t id = 1; id < relation.Indexes.size(); ++id ) {
+			indexRow(relation, relation.Indexes[id], row);
+		} //for ( std::size_t id = 1; id < relation.Indexes.size(); ++id )
+		return true;
+	}
+	
+	Argument argument(const RtTerm& term, std::unordered_map<RtName, std::uint32_t>& variables) {
+		if ( term.isVariable() ) {
+			const auto [iter, inserted] = variables.emplace(term.Name, static_cast<std::uint32_t>(variables.size()));
+			return {true, iter->second};
+		} //if ( term.isVariable() )
+		if ( !term.Args.empty() ) {
+			throw std::invalid_argument{"Datalog arguments have to be variables or constants!"};
+		} //if ( !term.Args.empty() )
+		return {false, constantId(term.Name)};
+	}
+	
+	Literal literal(const RtFormula& f, std::unordered_map<RtName, std::uint32_t>& variables) {
+		const bool negated = f.K == RtFormula::Kind::Not;
+		const auto& atom   = negated ? f.Children.front() : f;
+		if ( atom.K != RtFormula::Kind::Predicate ) {
+			throw std::invalid_argument{"Datalog literals have to be predicates or negated predicates!"};
+		} //if ( atom.K != RtFormula::Kind::Predicate )
+		Literal ret{relationId(*atom.N, atom.Terms.size()), negated, {}};
+		ret.Args.reserve(atom.Terms.size());
+		for ( const auto& term : atom.Terms ) {
+			ret.Args.push_back(argument(term, variables));
+		} //for ( const auto& term : atom.Terms )
+		return ret;
+	}
+	
+	void collectBody(const RtFormula& f, std::vector<Literal>& body,
+	                 std::unordered_map<RtName, std::uint32_t>& variables) {
+		if ( f.K == RtFormula::Kind::And ) {
+			for ( const auto& child : f.Children ) {
+				collectBody(child, body, variables);
+			} //for ( const auto& child : f.Children )
+		} //if ( f.K == RtFormula::Kind::And )
+		else if ( f.K != RtFormula::Kind::True ) {
+			body.push_back(literal(f, variables));
+		} //else if ( f.K != RtFormula::Kind::True )
+		return;
+	}
+	
+	static bool rangeRestricted(const Rule& rule) {
+		std::vector<bool> bound(rule.VariableCount, false);
+		for ( const auto& literal : rule.Body ) {
+			for ( const auto& arg : literal.Args ) {
+				if ( arg.IsVariable && !literal.Negated ) {
+					bound[arg.Value] = true;
+				} //if ( arg.IsVariable && !literal.Negated )
+			} //for ( const auto& arg : literal.Args )
+		} //for ( const auto& literal : rule.Body )
+		
+		const auto restricted = [&bound](const Literal& literal) {
+				return std::all_of(literal.Args.begin(), literal.Args.end(), [&bound](const Argument& arg) {
+						return !arg.IsVariable || bound[arg.Value];
+					});
+			};
+		return restricted(rule.Head) && std::all_of(rule.Body.begin(), rule.Body.end(),
+			[&restricted](const Literal& literal) { return !literal.Negated || restricted(literal); });
+	}
+	
+	/**
+	 * @brief Assigns every relation the lowest stratum not below its positive and above its negated dependencies,
+	 * returns the number of strata.
+	 */
+	std::size_t stratify(void) {
+		for ( bool changed = true; changed; ) {
+			changed = false;
+			for ( const auto& rule : Rules ) {
+				auto& head = Relations[rule.Head.Relation];
+				for ( const auto& literal : rule.Body ) {
+					const auto needed = Relations[literal.Relation].Stratum + (literal.Negated ? 1 : 0);
+					if ( needed > head.Stratum ) {
+						if ( needed >= Relations.size() ) {
+							throw std::invalid_argument{"Negation of " + head.Name.string() + " is not stratified!"};
+						} //if ( needed >= Relations.size() )
+						head.Stratum = needed;
+						changed      = true;
+					} //if ( needed > head.Stratum )
+				} //for ( const auto& literal : rule.Body )
+			} //for ( const auto& rule : Rules )
+		} //for ( bool changed = true; changed; )
+		
+		std::size_t ret = 0;
+		for ( const auto& relation : Relations ) {
+			ret = std::max(ret, relation.Stratum + 1);
+		} //for ( const auto& relation : Relations )
+		return ret;
+	}
+	
+	bool recursive(const Literal& literal, const std::size_t stratum) const noexcept {
+		const auto& relation = Relations[literal.Relation];
+		return !literal.Negated && relation.Derived && relation.Stratum == stratum;
+	}
+	
+	/**
+	 * @brief Orders the join of the rule body, with the delta at the given literal or without one.
+	 *
+	 * The delta comes first, then the positive literals sharing a bound variable or having a constant, the ones with
+	 * the fewest unbound arguments first. A negated literal is checked as soon as all its variables are bound.
+	 */
+	std::vector<Step> plan(const Rule& rule, const std::size_t stratum, const std::size_t delta) {
+		std::vector<Step> ret;
+		std::vector<bool> bound(rule.VariableCount, false);
+		std::vector<bool> planned(rule.Body.size(), false);
+		
+		const auto known = [&bound](const Argument& arg) noexcept { return !arg.IsVariable || bound[arg.Value]; };
+		const auto schedule = [this, &rule, stratum, delta, &ret, &bound, &planned, &known](const std::size_t i) {
+				const auto& literal = rule.Body[i];
+				Range range         = Range::All;
+				if ( recursive(literal, stratum) ) {
+					range = delta == NoDelta || i > delta ? Range::Known : i == delta ? Range::Delta : Range::Old;
+				} //if ( recursive(literal, stratum) )
+				
+				Step step{i, range, NoIndex, {}, {}, {}};
+				std::vector<std::size_t> columns;
+				for ( std::size_t column = 0; column < literal.Args.size(); ++column ) {
+					const auto arg = literal.Args[column];
+					if ( known(arg) ) {
+						step.Keys.emplace_back(column, arg);
+						columns.push_back(column);
+						continue;
+					} //if ( known(arg) )
+					const auto first = std::find_if(step.Binds.begin(), step.Binds.end(),
+						[&arg](const auto& bind) noexcept { return bind.second == arg.Value; });
+					if ( first != step.Binds.end() ) {
+						step.Repeats.emplace_back(column, first->first);
+					} //if ( first != step.Binds.end() )
+					else {
+						step.Binds.emplace_back(column, arg.Value);
+					} //else -> if ( first != step.Binds.end() )
+				} //for ( std::size_t column = 0; column < literal.Args.size(); ++column )
+				
+				for ( const auto& bind : step.Binds ) {
+					bound[bind.second] = true;
+				} //for ( const auto& bind : step.Binds )
+				if ( !columns.empty() ) {
+					step.IndexId = indexId(Relations[literal.Relation], std::move(columns));
+				} //if ( !columns.empty() )
+				planned[i] = true;
+				ret.push_back(std::move(step));
+				return;
+			};
+		
+		if ( delta != NoDelta ) {
+			schedule(delta);
+		} //if ( delta != NoDelta )
+		for ( ;; ) {
+			for ( std::size_t i = 0; i < rule.Body.size(); ++i ) {
+				const auto& literal = rule.Body[i];
+				if ( !planned[i] && literal.Negated && std::all_of(literal.Args.begin(), literal.Args.end(), known) ) {
+					schedule(i);
+				} //if ( !planned[i] && literal.Negated && std::all_of(...) )
+			} //for ( std::size_t i = 0; i < rule.Body.size(); ++i )
+			
+			//Of the literals sharing a known argument the one with the fewest unknown arguments, else the first one.
+			std::size_t next = rule.Body.size(), nextUnknown = 0;
+			bool nextConnected = false;
+			for ( std::size_t i = 0; i < rule.Body.size(); ++i ) {
+				const auto& literal = rule.Body[i];
+				if ( planned[i] || literal.Negated ) {
+					continue;
+				} //if ( planned[i] || literal.Negated )
+				const auto unknown   = static_cast<std::size_t>(std::count_if(literal.Args.begin(), literal.Args.end(),
+					[&known](const Argument& arg) noexcept { return !known(arg); }));
+				const bool connected = unknown < literal.Args.size();
+				if ( next == rule.Body.size() || (connected && (!nextConnected || unknown < nextUnknown)) ) {
+					next          = i;
+					nextUnknown   = unknown;
+					nextConnected = connected;
+				} //if ( next == rule.Body.size() || (connected && (!nextConnected || unknown < nextUnknown)) )
+			} //for ( std::size_t i = 0; i < rule.Body.size(); ++i )
+			if ( next == rule.Body.size() ) {
+				return ret;
+			} //if ( next == rule.Body.size() )
+			schedule(next);
+		} //for ( ;; )
+	}
+	
+	/**
+	 * @brief Joins the literals of the plan from the position on, the derived heads are added to the pending tuples.
+	 */
+	void join(const Rule& rule, const std::vector<Step>& plan, const std::size_t position,
+	          std::vector<Constant>& binding) {
+		if ( position == plan.size() ) {
+			auto& head = Relations[rule.Head.Relation];
+			for ( const auto& arg : rule.Head.Args ) {
+				head.Pending.push_back(arg.IsVariable ? binding[arg.Value] : arg.Value);
+			} //for ( const auto& arg : rule.Head.Args )
+			++head.PendingCount;
+			return;
+		} //if ( position == plan.size() )
+		
+		const auto& step        = plan[position];
+		const auto& literal     = rule.Body[step.Literal];
+		const auto& relation    = Relations[literal.Relation];
+		const auto [begin, end] = rowRange(relation, step.R);
+		const auto value        = [&binding](const Argument& arg) noexcept {
+				return arg.IsVariable ? binding[arg.Value] : arg.Value;
+			};
+		
+		bool found = false;
+		//Returns whether to go on with the next row.
+		const auto candidate = [this, &rule, &plan, position, &binding, &step, &literal, &relation, &value,
+		                        &found](const RowId row) {
+				for ( const auto& [column, arg] : step.Keys ) {
+					if ( relation.Columns[column][row] != value(arg) ) {
+						return true;
+					} //if ( relation.Columns[column][row] != value(arg) )
+				} //for ( const auto& [column, arg] : step.Keys )
+				for ( const auto& [column, first] : step.Repeats ) {
+					if ( relation.Columns[column][row] != relation.Columns[first][row] ) {
+						return true;
+					} //if ( relation.Columns[column][row] != relation.Columns[first][row] )
+				} //for ( const auto& [column, first] : step.Repeats )
+				if ( literal.Negated ) {
+					found = true;
+					return false;
+				} //if ( literal.Negated )
+				for ( const auto& [column, variable] : step.Binds ) {
+					binding[variable] = relation.Columns[column][row];
+				} //for ( const auto& [column, variable] : step.Binds )
+				join(rule, plan, position + 1, binding);
+				return true;
+			};
+		
+		if ( step.IndexId == NoIndex ) {
+			for ( RowId row = begin; row < end; ++row ) {
+				if ( !candidate(row) ) {
+					break;
+				} //if ( !candidate(row) )
+			} //for ( RowId row = begin; row < end; ++row )
+		} //if ( step.IndexId == NoIndex )
+		else {
+			const auto& buckets = relation.Indexes[step.IndexId].Buckets;
+			const auto bucket   = buckets.find(hashKey(step.Keys.size(), [&step, &value](const std::size_t i) noexcept {
+					return value(step.Keys[i].second);
+				}));
+			if ( bucket != buckets.end() ) {
+				const auto& rows = bucket->second;
+				for ( auto iter = std::lower_bound(rows.begin(), rows.end(), begin); iter != rows.end() && *iter < end;
+				      ++iter ) {
+					if ( !candidate(*iter) ) {
+						break;
+					} //if ( !candidate(*iter) )
+				} //for ( auto iter = std::lower_bound(rows.begin(), rows.end(), begin); ... )
+			} //if ( bucket != buckets.end() )
+		} //else -> if ( step.IndexId == NoIndex )
+		
+		if ( literal.Negated && !found ) {
+			join(rule, plan, position + 1, binding);
+		} //if ( literal.Negated && !found )
+		return;
+	}
+	
+	/**
+	 * @brief Appends the pending tuples of the relation, returns how many were new.
+	 */
+	static std::size_t flush(Relation& relation) {
+		std::size_t ret = 0;
+		for ( std::size_t i = 0; i < relation.PendingCount; ++i ) {
+			ret += insertTuple(relation, relation.Pending.data() + i * relation.Arity) ? 1u : 0u;
+		} //for ( std::size_t i = 0; i < relation.PendingCount; ++i )
+		relation.Pending.clear();
+		relation.PendingCount = 0;
+		return ret;
+	}
+	
+	public:
+	explicit DatalogEngine(const Options options) : Opts{options} {
+		return;
+	}
+	
+	DatalogEngine(void) : DatalogEngine{Options{}} {
+		return;
+	}
+	
+	/**
+	 * @brief Adds a rule or a fact, the universal quantifiers around it are dropped.
+	 */
+	void add(const RtFormula& f) {
+		checkMutable();
+		const RtFormula *formula = &f;
+		while ( formula->K == RtFormula::Kind::ForAll ) {
+			formula = &formula->Children.front();
+		} //while ( formula->K == RtFormula::Kind::ForAll )
+		
+		std::unordered_map<RtName, std::uint32_t> variables;
+		std::vector<Literal> body;
+		const RtFormula *head = formula;
+		if ( formula->K == RtFormula::Kind::Implies ) {
+			collectBody(formula->Children.front(), body, variables);
+			head = &formula->Children.back();
+		} //if ( formula->K == RtFormula::Kind::Implies )
+		if ( head->K != RtFormula::Kind::Predicate ) {
+			throw std::invalid_argument{"Formula is not a Horn rule!"};
+		} //if ( head->K != RtFormula::Kind::Predicate )
+		
+		auto headLiteral = literal(*head, variables);
+		Rule rule{std::move(headLiteral), std::move(body), variables.size(), {}};
+		if ( !rangeRestricted(rule) ) {
+			throw std::invalid_argument{"Rule is not range restricted!"};
+		} //if ( !rangeRestricted(rule) )
+		
+		auto& relation = Relations[rule.Head.Relation];
+		if ( rule.Body.empty() ) {
+			std::vector<Constant> tuple;
+			tuple.reserve(rule.Head.Args.size());
+			for ( const auto& arg : rule.Head.Args ) {
+				tuple.push_back(arg.Value);
+			} //for ( const auto& arg : rule.Head.Args )
+			insertTuple(relation, tuple.data());
+		} //if ( rule.Body.empty() )
+		else {
+			relation.Derived = true;
+			Rules.push_back(std::move(rule));
+		} //else -> if ( rule.Body.empty() )
+		return;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	void add(const T& f) {
+		add(toRuntime(f));
+		return;
+	}
+	
+	/**
+	 * @brief Adds the fact relation(args...) without building a formula.
+	 */
+	void addFact(const RtName& relation, const std::vector<RtName>& args) {
+		checkMutable();
+		const auto id = relationId(relation, args.size());
+		std::vector<Constant> tuple;
+		tuple.reserve(args.size());
+		for ( const auto& arg : args ) {
+			tuple.push_back(constantId(arg));
+		} //for ( const auto& arg : args )
+		insertTuple(Relations[id], tuple.data());
+		return;
+	}
+	
+	/**
+	 * @brief Derives all facts, afterwards no rules or facts can be added.
+	 */
+	Report evaluate(void) {
+		checkMutable();
+		Evaluated = true;
+		Report ret;
+		ret.Strata = stratify();
+		
+		std::vector<std::vector<std::size_t>> rulesOf(ret.Strata);
+		for ( std::size_t r = 0; r < Rules.size(); ++r ) {
+			auto& rule         = Rules[r];
+			const auto stratum = Relations[rule.Head.Relation].Stratum;
+			rulesOf[stratum].push_back(r);
+			rule.Plans.push_back(plan(rule, stratum, NoDelta));
+			for ( std::size_t i = 0; i < rule.Body.size(); ++i ) {
+				if ( recursive(rule.Body[i], stratum) ) {
+					rule.Plans.push_back(plan(rule, stratum, i));
+				} //if ( recursive(rule.Body[i], stratum) )
+			} //for ( std::size_t i = 0; i < rule.Body.size(); ++i )
+		} //for ( std::size_t r = 0; r < Rules.size(); ++r )
+		
+		std::vector<Constant> binding;
+		for ( std::size_t stratum = 0; stratum < ret.Strata; ++stratum ) {
+			if ( rulesOf[stratum].empty() ) {
+				continue;
+			} //if ( rulesOf[stratum].empty() )
+			for ( auto& relation : Relations ) {
+				if ( relation.Stratum == stratum ) {
+					relation.Old      = 0;
+					relation.DeltaEnd = relation.Size;
+				} //if ( relation.Stratum == stratum )
+			} //for ( auto& relation : Relations )
+			
+			for ( bool first = true, changed = true; changed; first = false ) {
+				for ( const auto r : rulesOf[stratum] ) {
+					const auto& rule = Rules[r];
+					binding.assign(rule.VariableCount, 0);
+					if ( !Opts.SemiNaive || (first && rule.Plans.size() == 1) ) {
+						join(rule, rule.Plans.front(), 0, binding);
+					} //if ( !Opts.SemiNaive || (first && rule.Plans.size() == 1) )
+					else {
+						for ( std::size_t p = 1; p < rule.Plans.size(); ++p ) {
+							join(rule, rule.Plans[p], 0, binding);
+						} //for ( std::size_t p = 1; p < rule.Plans.size(); ++p )
+					} //else -> if ( !Opts.SemiNaive || (first && rule.Plans.size() == 1) )
+				} //for ( const auto r : rulesOf[stratum] )
+				
+				changed = false;
+				for ( auto& relation : Relations ) {
+					if ( relation.Stratum == stratum ) {
+						relation.Old       = relation.DeltaEnd;
+						ret.Derived       += flush(relation);
+						relation.DeltaEnd  = relation.Size;
+						changed            = changed || relation.Old != relation.DeltaEnd;
+					} //if ( relation.Stratum == stratum )
+				} //for ( auto& relation : Relations )
+				++ret.Iterations;
+			} //for ( bool first = true, changed = true; changed; first = false )
+		} //for ( std::size_t stratum = 0; stratum < ret.Strata; ++stratum )
+		return ret;
+	}
+	
+	/**
+	 * @brief The number of tuples of the relation.
+	 */
+	std::size_t size(const RtName& relation) const {
+		const auto iter = RelationIds.find(relation);
+		return iter == RelationIds.end() ? 0 : Relations[iter->second].Size;
+	}
+	
+	/**
+	 * @brief Whether the ground predicate is a known fact.
+	 */
+	bool contains(const RtFormula& atom) const {
+		if ( atom.K != RtFormula::Kind::Predicate ) {
+			throw std::invalid_argument{"Only predicates can be looked up!"};
+		} //if ( atom.K != RtFormula::Kind::Predicate )
+		const auto relationIter = RelationIds.find(*atom.N);
+		if ( relationIter == RelationIds.end() || Relations[relationIter->second].Arity != atom.Terms.size() ) {
+			return false;
+		} //if ( relationIter == RelationIds.end() || Relations[relationIter->second].Arity != atom.Terms.size() )
+		
+		std::vector<Constant> tuple;
+		tuple.reserve(atom.Terms.size());
+		for ( const auto& term : atom.Terms ) {
+			if ( term.isVariable() || !term.Args.empty() ) {
+				throw std::invalid_argument{"Only ground predicates over constants can be looked up!"};
+			} //if ( term.isVariable() || !term.Args.empty() )
+			const auto constantIter = ConstantIds.find(term.Name);
+			if ( constantIter == ConstantIds.end() ) {
+				return false;
+			} //if ( constantIter == ConstantIds.end() )
+			tuple.push_back(constantIter->second);
+		} //for ( const auto& term : atom.Terms )
+		
+		const auto& relation = Relations[relationIter->second];
+		const auto& buckets  = relation.Indexes.front().Buckets;
+		const auto bucket    = buckets.find(hashKey(tuple.size(), [&tuple](const std::size_t i) noexcept {
+				return tuple[i];
+			}));
+		return bucket != buckets.end() && std::any_of(bucket->second.begin(), bucket->second.end(),
+			[&relation, &tuple](const RowId row) noexcept {
+				for ( std::size_t column = 0; column < tuple.size(); ++column ) {
+					if ( relation.Columns[column][row] != tuple[column] ) {
+						return false;
+					} //if ( relation.Columns[column][row] != tuple[column] )
+				} //for ( std::size_t column = 0; column < tuple.size(); ++column )
+				return true;
+			});
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	bool contains(const T& atom) const {
+		return contains(toRuntime(atom));
+	}
+	
+	/**
+	 * @brief The tuples of the relation as predicates, in the order they were added.
+	 */
+	std::vector<RtFormula> facts(const RtName& name) const {
+		std::vector<RtFormula> ret;
+		const auto iter = RelationIds.find(name);
+		if ( iter == RelationIds.end() ) {
+			return ret;
+		} //if ( iter == RelationIds.end() )
+		const auto& relation = Relations[iter->second];
+		ret.reserve(relation.Size);
+		for ( RowId row = 0; row < relation.Size; ++row ) {
+			std::vector<RtTerm> args;
+			args.reserve(relation.Arity);
+			for ( std::size_t column = 0; column < relation.Arity; ++column ) {
+				args.emplace_back(ConstantNames[relation.Columns[column][row]]);
+			} //for ( std::size_t column = 0; column < relation.Arity; ++column )
+			ret.push_back(RtFormula::predicate(relation.Name, std::move(args)));
+		} //for ( RowId row = 0; row < relation.Size; ++row )
+		return ret;
+	}
+};
+
+} //namespace fol
+
+#endif
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks editable_formula.hpp for self-containment.
+ * 
+ */
+
+#include "editable_formula.hpp"
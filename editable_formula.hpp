@@ -0,0 +1,206 @@
+/**
+ * @file
+ * @brief Contains a runtime formula which can be edited in place and renormalized incrementally.
+ */
+
+#ifndef FOL_EDITABLE_FORMULA_HPP
+#define FOL_EDITABLE_FORMULA_HPP
+
+#include "formula_dag.hpp"
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief A formula tree with parent links, whose normal forms are cached per node.
+ *
+ * Every node knows the FormulaDag node of its current subtree and of its simplified and negation normal form. An edit
+ * replaces a subtree and only invalidates the nodes on the path to the root. When a normal form is requested again,
+ * only these nodes are interned anew, every untouched subtree is still the same DAG node and hits the caches of the
+ * DAG. The DAG keeps the nodes of all versions, so its memory grows with the number of edits.
+ */
+class EditableFormula {
+	public:
+	using NodeId = std::uint32_t;
+	using Kind   = RtFormula::Kind;
+	
+	static constexpr NodeId NoNode = std::numeric_limits<NodeId>::max();
+	
+	private:
+	struct Node {
+		Kind K;
+		std::optional<RtName> N;
+		std::vector<RtTerm> Terms;
+		std::vector<NodeId> Children;
+		NodeId Parent;
+		FormulaDag::NodeId Shape              = FormulaDag::InvalidNode;
+		FormulaDag::NodeId Simplified         = FormulaDag::InvalidNode;
+		FormulaDag::NodeId NegationNormalForm = FormulaDag::InvalidNode;
+	};
+	
+	FormulaDag Dag;
+	std::vector<Node> Nodes;
+	std::vector<NodeId> FreeNodes;
+	NodeId Root;
+	
+	NodeId allocate(void) {
+		if ( !FreeNodes.empty() ) {
+			const auto id = FreeNodes.back();
+			FreeNodes.pop_back();
+			return id;
+		} //if ( !FreeNodes.empty() )
+		if ( Nodes.size() >= NoNode ) {
+			throw std::length_error{"Too many nodes!"};
+		} //if ( Nodes.size() >= NoNode )
+		Nodes.emplace_back();
+		return static_cast<NodeId>(Nodes.size() - 1);
+	}
+	
+	/**
+	 * @brief Sets the node to f, with newly allocated children.
+	 */
+	void assign(const NodeId id, const RtFormula& f, const NodeId parent) {
+		std::vector<NodeId> children;
+		children.reserve(f.Children.size());
+		for ( std::size_t i = 0; i < f.Children.size(); ++i ) {
+			children.push_back(allocate());
+		} //for ( std::size_t i = 0; i < f.Children.size(); ++i )
+		Nodes[id] = {f.K, f.N, f.Terms, children, parent};
+		for ( std::size_t i = 0; i < f.Children.size(); ++i ) {
+			assign(children[i], f.Children[i], id);
+		} //for ( std::size_t i = 0; i < f.Children.size(); ++i )
+		return;
+	}
+	
+	void release(const NodeId id) {
+		for ( const auto child : Nodes[id].Children ) {
+			release(child);
+			Nodes[child].Parent = NoNode;
+			FreeNodes.push_back(child);
+		} //for ( const auto child : Nodes[id].Children )
+		Nodes[id].Children.clear();
+		return;
+	}
+	
+	const Node& checked(const NodeId id) const {
+		if ( id >= Nodes.size() || (id != Root && Nodes[id].Parent == NoNode) ) {
+			throw std::out_of_range{"Node is not part of the formula!"};
+		} //if ( id >= Nodes.size() || (id != Root && Nodes[id].Parent == NoNode) )
+		return Nodes[id];
+	}
+	
+	public:
+	explicit EditableFormula(const RtFormula& f) : Root{allocate()} {
+		assign(Root, f, NoNode);
+		return;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	explicit EditableFormula(const T& f) : EditableFormula{toRuntime(f)} {
+		return;
+	}
+	
+	NodeId root(void) const noexcept {
+		return Root;
+	}
+	
+	NodeId parent(const NodeId id) const {
+		return checked(id).Parent;
+	}
+	
+	const std::vector<NodeId>& children(const NodeId id) const {
+		return checked(id).Children;
+	}
+	
+	Kind kind(const NodeId id) const {
+		return checked(id).K;
+	}
+	
+	/**
+	 * @brief Replaces the subtree of the node by f, the node keeps its id and the ids of its old descendants become
+	 * invalid.
+	 */
+	void replace(const NodeId id, const RtFormula& f) {
+		const auto parent = checked(id).Parent;
+		release(id);
+		assign(id, f, parent);
+		for ( auto ancestor = parent; ancestor != NoNode && Nodes[ancestor].Shape != FormulaDag::InvalidNode;
+		      ancestor = Nodes[ancestor].Parent ) {
+			//A node on the path which is already invalid has only invalid ancestors.
+			Nodes[ancestor].Shape              = FormulaDag::InvalidNode;
+			Nodes[ancestor].Simplified         = FormulaDag::InvalidNode;
+			Nodes[ancestor].NegationNormalForm = FormulaDag::InvalidNode;
+		} //for ( auto ancestor = parent; ancestor != NoNode && ...; ancestor = Nodes[ancestor].Parent )
+		return;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	void replace(const NodeId id, const T& f) {
+		replace(id, toRuntime(f));
+		return;
+	}
+	
+	/**
+	 * @brief Returns the DAG node of the current subtree, interning only the nodes which changed since the last call.
+	 */
+	FormulaDag::NodeId shape(const NodeId id) {
+		checked(id);
+		if ( Nodes[id].Shape == FormulaDag::InvalidNode ) {
+			std::vector<FormulaDag::NodeId> children;
+			children.reserve(Nodes[id].Children.size());
+			for ( const auto child : Nodes[id].Children ) {
+				children.push_back(shape(child));
+			} //for ( const auto child : Nodes[id].Children )
+			const auto& node = Nodes[id];
+			Nodes[id].Shape = Dag.intern({node.K, node.N, node.Terms, std::move(children)});
+		} //if ( Nodes[id].Shape == FormulaDag::InvalidNode )
+		return Nodes[id].Shape;
+	}
+	
+	FormulaDag::NodeId simplified(const NodeId id) {
+		if ( checked(id).Simplified == FormulaDag::InvalidNode ) {
+			Nodes[id].Simplified = Dag.simplified(shape(id));
+		} //if ( checked(id).Simplified == FormulaDag::InvalidNode )
+		return Nodes[id].Simplified;
+	}
+	
+	FormulaDag::NodeId toNegationNormalForm(const NodeId id) {
+		if ( checked(id).NegationNormalForm == FormulaDag::InvalidNode ) {
+			Nodes[id].NegationNormalForm = Dag.toNegationNormalForm(shape(id));
+		} //if ( checked(id).NegationNormalForm == FormulaDag::InvalidNode )
+		return Nodes[id].NegationNormalForm;
+	}
+	
+	/**
+	 * @brief The DAG the shapes and normal forms live in, use FormulaDag::toFormula() to expand them.
+	 */
+	const FormulaDag& dag(void) const noexcept {
+		return Dag;
+	}
+	
+	/**
+	 * @brief Expands the current subtree of the node.
+	 */
+	RtFormula formula(const NodeId id) const {
+		const auto& node = checked(id);
+		std::vector<RtFormula> children;
+		children.reserve(node.Children.size());
+		for ( const auto child : node.Children ) {
+			children.push_back(formula(child));
+		} //for ( const auto child : node.Children )
+		return {node.K, node.N, node.Terms, std::move(children)};
+	}
+};
+
+} //namespace fol
+
+#endif
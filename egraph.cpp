@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks egraph.hpp for self-containment.
+ * 
+ */
+
+#include "egraph.hpp"
@@ -0,0 +1,655 @@
+/**
+ * @file
+ * @brief Contains an e-graph for the simplification of formulas by equality saturation.
+ */
+
+#ifndef FOL_EGRAPH_HPP
+#define FOL_EGRAPH_HPP
+
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief Stores many equivalent forms of formulas at once, as classes of equivalent nodes.
+ *
+ * A node is a connective, an atom, or a term symbol, its children are classes, so a class stands for every formula
+ * which can be built by choosing one node per class. Rewrite rules are matched against all nodes and only add nodes and
+ * merge classes, nothing is ever replaced, so the order in which they are applied does not matter. saturate() applies
+ * them until nothing changes or a limit is reached, extract() then picks the cheapest formula of a class. Junctions are
+ * binary inside the graph and flattened again on extraction.
+ *
+ * Merges are deferred: merge() only unites the classes, rebuild() canonicalizes the nodes and merges the classes which
+ * became congruent, it is called once per round of rewrites.
+ */
+class EGraph {
+	public:
+	using ClassId = std::uint32_t;
+	
+	static constexpr ClassId NoClass = std::numeric_limits<ClassId>::max();
+	
+	/**
+	 * @brief How extract() weighs the nodes: Size counts every node, Evaluation counts the body of a quantifier once
+	 * per element of a small domain, so smaller bodies are preferred over fewer quantifiers.
+	 */
+	enum class Cost : std::uint8_t { Size, Evaluation };
+	
+	enum class StopReason : std::uint8_t { Saturated, NodeLimit, IterationLimit, TimeLimit };
+	
+	struct Options {
+		std::size_t MaxNodes                = 10000;
+		std::size_t MaxIterations           = 32;
+		std::chrono::microseconds TimeLimit = std::chrono::milliseconds{50};
+	};
+	
+	struct Report {
+		StopReason Reason;
+		std::size_t Iterations;
+	};
+	
+	private:
+	//The kinds of RtFormula, followed by the ones of RtTerm.
+	enum class Op : std::uint8_t {
+		Predicate, Equality, Not, And, Or, Implies, Equivalent, Exists, ForAll, True, False, Variable, Function
+	};
+	
+	//add() and extract() convert between Op and RtFormula::Kind by value.
+	static_assert(static_cast<int>(Op::Predicate) == static_cast<int>(RtFormula::Kind::Predicate));
+	static_assert(static_cast<int>(Op::Equality) == static_cast<int>(RtFormula::Kind::Equality));
+	static_assert(static_cast<int>(Op::Not) == static_cast<int>(RtFormula::Kind::Not));
+	static_assert(static_cast<int>(Op::And) == static_cast<int>(RtFormula::Kind::And));
+	static_assert(static_cast<int>(Op::Or) == static_cast<int>(RtFormula::Kind::Or));
+	static_assert(static_cast<int>(Op::Implies) == static_cast<int>(RtFormula::Kind::Implies));
+	static_assert(static_cast<int>(Op::Equivalent) == static_cast<int>(RtFormula::Kind::Equivalent));
+	static_assert(static_cast<int>(Op::Exists) == static_cast<int>(RtFormula::Kind::Exists));
+	static_assert(static_cast<int>(Op::ForAll) == static_cast<int>(RtFormula::Kind::ForAll));
+	static_assert(static_cast<int>(Op::True) == static_cast<int>(RtFormula::Kind::True));
+	static_assert(static_cast<int>(Op::False) == static_cast<int>(RtFormula::Kind::False));
+	
+	static constexpr double QuantifierWeight = 8;
+	
+	struct ENode {
+		Op O;
+		std::optional<RtName> N;
+		std::vector<ClassId> Children;
+		
+		friend bool operator==(const ENode& n1, const ENode& n2) noexcept {
+			return n1.O == n2.O && n1.N == n2.N && n1.Children == n2.Children;
+		}
+	};
+	
+	struct ENodeHash {
+		std::size_t operator()(const ENode& node) const noexcept {
+			std::size_t ret = static_cast<std::size_t>(node.O);
+			if ( node.N ) {
+				ret = details::hashCombine(ret, std::hash<RtName>{}(*node.N));
+			} //if ( node.N )
+			for ( const auto child : node.Children ) {
+				ret = details::hashCombine(ret, child);
+			} //for ( const auto child : node.Children )
+			return ret;
+		}
+	};
+	
+	/**
+	 * @brief The right hand side of a rewrite, a tree of new nodes whose leaves are existing classes.
+	 */
+	struct Pattern {
+		Op O;
+		std::optional<RtName> N;
+		std::vector<Pattern> Children;
+		ClassId Class;
+	};
+	
+	struct Rewrite {
+		ClassId Class;
+		Pattern Replacement;
+	};
+	
+	std::vector<ClassId> Parent;
+	std::vector<std::vector<ENode>> Nodes;
+	std::unordered_map<ENode, ClassId, ENodeHash> Memo;
+	std::size_t NodeCount = 0;
+	bool Dirty            = false;
+	Options Opts;
+	
+	static Pattern leaf(const ClassId c) {
+		return {Op::True, std::nullopt, {}, c};
+	}
+	
+	static Pattern node(const Op o, std::vector<Pattern> children, std::optional<RtName> n = std::nullopt) {
+		return {o, std::move(n), std::move(children), NoClass};
+	}
+	
+	static Pattern negation(Pattern p) {
+		std::vector<Pattern> children;
+		children.push_back(std::move(p));
+		return node(Op::Not, std::move(children));
+	}
+	
+	static Pattern binary(const Op o, Pattern p1, Pattern p2) {
+		std::vector<Pattern> children;
+		children.reserve(2);
+		children.push_back(std::move(p1));
+		children.push_back(std::move(p2));
+		return node(o, std::move(children));
+	}
+	
+	static Pattern constant(const bool value) {
+		return node(value ? Op::True : Op::False, {});
+	}
+	
+	ClassId add(ENode node) {
+		for ( auto& child : node.Children ) {
+			child = find(child);
+		} //for ( auto& child : node.Children )
+		const auto iter = Memo.find(node);
+		if ( iter != Memo.end() ) {
+			return find(iter->second);
+		} //if ( iter != Memo.end() )
+		if ( Parent.size() >= NoClass ) {
+			throw std::length_error{"Too many e-classes!"};
+		} //if ( Parent.size() >= NoClass )
+		
+		const auto ret = static_cast<ClassId>(Parent.size());
+		Parent.push_back(ret);
+		Memo.emplace(node, ret);
+		Nodes.emplace_back();
+		Nodes.back().push_back(std::move(node));
+		++NodeCount;
+		return ret;
+	}
+	
+	ClassId add(const Op o, const std::vector<RtFormula>& children, const std::size_t first) {
+		if ( first + 1 == children.size() ) {
+			return add(children[first]);
+		} //if ( first + 1 == children.size() )
+		return add(ENode{o, std::nullopt, {add(children[first]), add(o, children, first + 1)}});
+	}
+	
+	ClassId instantiate(const Pattern& p) {
+		if ( p.Class != NoClass ) {
+			return p.Class;
+		} //if ( p.Class != NoClass )
+		ENode ret{p.O, p.N, {}};
+		ret.Children.reserve(p.Children.size());
+		for ( const auto& child : p.Children ) {
+			ret.Children.push_back(instantiate(child));
+		} //for ( const auto& child : p.Children )
+		return add(std::move(ret));
+	}
+	
+	bool has(const ClassId c, const Op o) const noexcept {
+		for ( const auto& n : Nodes[c] ) {
+			if ( n.O == o ) {
+				return true;
+			} //if ( n.O == o )
+		} //for ( const auto& n : Nodes[c] )
+		return false;
+	}
+	
+	/**
+	 * @brief Collects the rewrites of the rules matching the node n of the class c.
+	 *
+	 * The graph is canonical, so the children are representatives and equal classes have equal ids. The rules are only
+	 * matched in one orientation, the commutativity rules create the mirrored nodes.
+	 */
+	void match(const ClassId c, const ENode& n, std::vector<Rewrite>& out) const {
+		const auto rewrite = [c, &out](Pattern p) {
+				out.push_back({c, std::move(p)});
+				return;
+			};
+		
+		switch ( n.O ) {
+			case Op::Not        : {
+				for ( const auto& m : Nodes[n.Children[0]] ) {
+					switch ( m.O ) {
+						case Op::Not        : rewrite(leaf(m.Children[0])); break;
+						case Op::True       :
+						case Op::False      : rewrite(constant(m.O == Op::False)); break;
+						case Op::And        :
+						case Op::Or         : {
+							rewrite(binary(m.O == Op::And ? Op::Or : Op::And, negation(leaf(m.Children[0])),
+							               negation(leaf(m.Children[1]))));
+							break;
+						} //case Op::And, Op::Or
+						case Op::Implies    : {
+							rewrite(binary(Op::And, leaf(m.Children[0]), negation(leaf(m.Children[1]))));
+							break;
+						} //case Op::Implies
+						case Op::Equivalent : {
+							rewrite(binary(Op::Equivalent, leaf(m.Children[0]), negation(leaf(m.Children[1]))));
+							break;
+						} //case Op::Equivalent
+						case Op::Exists     :
+						case Op::ForAll     : {
+							std::vector<Pattern> body;
+							body.push_back(negation(leaf(m.Children[0])));
+							rewrite(node(m.O == Op::Exists ? Op::ForAll : Op::Exists, std::move(body), m.N));
+							break;
+						} //case Op::Exists, Op::ForAll
+						default             : break;
+					} //switch ( m.O )
+				} //for ( const auto& m : Nodes[n.Children[0]] )
+				break;
+			} //case Op::Not
+			case Op::And        :
+			case Op::Or         : {
+				const ClassId a = n.Children[0], b = n.Children[1];
+				const Op dual   = n.O == Op::And ? Op::Or : Op::And;
+				const Op unit   = n.O == Op::And ? Op::True : Op::False;
+				const Op zero   = n.O == Op::And ? Op::False : Op::True;
+				
+				rewrite(binary(n.O, leaf(b), leaf(a)));
+				if ( a == b || has(a, unit) ) {
+					rewrite(leaf(b));
+				} //if ( a == b || has(a, unit) )
+				if ( has(a, zero) ) {
+					rewrite(constant(zero == Op::True));
+				} //if ( has(a, zero) )
+				for ( const auto& m : Nodes[a] ) {
+					if ( m.O == n.O ) {
+						rewrite(binary(n.O, leaf(m.Children[0]), binary(n.O, leaf(m.Children[1]), leaf(b))));
+					} //if ( m.O == n.O )
+					else if ( m.O == Op::Not && n.O == Op::Or ) {
+						rewrite(binary(Op::Implies, leaf(m.Children[0]), leaf(b)));
+					} //else if ( m.O == Op::Not && n.O == Op::Or )
+				} //for ( const auto& m : Nodes[a] )
+				
+				for ( const auto& m : Nodes[b] ) {
+					if ( m.O == Op::Not && m.Children[0] == a ) {
+						rewrite(constant(zero == Op::True));
+					} //if ( m.O == Op::Not && m.Children[0] == a )
+					else if ( m.O == dual && (m.Children[0] == a || m.Children[1] == a) ) {
+						rewrite(leaf(a));
+					} //else if ( m.O == dual && (m.Children[0] == a || m.Children[1] == a) )
+					
+					//Factors out a common operand, a negation, or a distributing quantifier.
+					for ( const auto& l : Nodes[a] ) {
+						if ( l.O != m.O ) {
+							continue;
+						} //if ( l.O != m.O )
+						if ( l.O == dual && l.Children[0] == m.Children[0] ) {
+							rewrite(binary(dual, leaf(l.Children[0]), binary(n.O, leaf(l.Children[1]),
+							                                                  leaf(m.Children[1]))));
+						} //if ( l.O == dual && l.Children[0] == m.Children[0] )
+						else if ( l.O == Op::Not ) {
+							rewrite(negation(binary(dual, leaf(l.Children[0]), leaf(m.Children[0]))));
+						} //else if ( l.O == Op::Not )
+						else if ( l.O == (n.O == Op::And ? Op::ForAll : Op::Exists) && l.N == m.N ) {
+							std::vector<Pattern> body;
+							body.push_back(binary(n.O, leaf(l.Children[0]), leaf(m.Children[0])));
+							rewrite(node(l.O, std::move(body), l.N));
+						} //else if ( l.O == (n.O == Op::And ? Op::ForAll : Op::Exists) && l.N == m.N )
+					} //for ( const auto& l : Nodes[a] )
+				} //for ( const auto& m : Nodes[b] )
+				break;
+			} //case Op::And, Op::Or
+			case Op::Implies    : {
+				const ClassId a = n.Children[0], b = n.Children[1];
+				rewrite(binary(Op::Or, negation(leaf(a)), leaf(b)));
+				if ( a == b ) {
+					rewrite(constant(true));
+				} //if ( a == b )
+				break;
+			} //case Op::Implies
+			case Op::Equivalent : {
+				const ClassId a = n.Children[0], b = n.Children[1];
+				rewrite(binary(Op::Equivalent, leaf(b), leaf(a)));
+				rewrite(binary(Op::And, binary(Op::Implies, leaf(a), leaf(b)), binary(Op::Implies, leaf(b), leaf(a))));
+				if ( a == b ) {
+					rewrite(constant(true));
+				} //if ( a == b )
+				else if ( has(a, Op::True) ) {
+					rewrite(leaf(b));
+				} //else if ( has(a, Op::True) )
+				else if ( has(a, Op::False) ) {
+					rewrite(negation(leaf(b)));
+				} //else if ( has(a, Op::False) )
+				break;
+			} //case Op::Equivalent
+			case Op::Exists     :
+			case Op::ForAll     : {
+				for ( const auto& m : Nodes[n.Children[0]] ) {
+					if ( m.O == Op::True || m.O == Op::False ) {
+						rewrite(leaf(n.Children[0]));
+					} //if ( m.O == Op::True || m.O == Op::False )
+					else if ( m.O == Op::Not ) {
+						std::vector<Pattern> body;
+						body.push_back(leaf(m.Children[0]));
+						rewrite(negation(node(n.O == Op::Exists ? Op::ForAll : Op::Exists, std::move(body), n.N)));
+					} //else if ( m.O == Op::Not )
+				} //for ( const auto& m : Nodes[n.Children[0]] )
+				break;
+			} //case Op::Exists, Op::ForAll
+			case Op::Equality   : {
+				if ( n.Children[0] == n.Children[1] ) {
+					rewrite(constant(true));
+				} //if ( n.Children[0] == n.Children[1] )
+				else {
+					rewrite(binary(Op::Equality, leaf(n.Children[1]), leaf(n.Children[0])));
+				} //else -> if ( n.Children[0] == n.Children[1] )
+				break;
+			} //case Op::Equality
+			default             : break;
+		} //switch ( n.O )
+		return;
+	}
+	
+	double cost(const ENode& n, const Cost model, const std::vector<double>& best) const noexcept {
+		double children = 0;
+		for ( const auto child : n.Children ) {
+			children += best[child];
+		} //for ( const auto child : n.Children )
+		if ( model == Cost::Evaluation && (n.O == Op::Exists || n.O == Op::ForAll) ) {
+			children *= QuantifierWeight;
+		} //if ( model == Cost::Evaluation && (n.O == Op::Exists || n.O == Op::ForAll) )
+		return 1 + children;
+	}
+	
+	public:
+	explicit EGraph(const Options options) : Opts{options} {
+		return;
+	}
+	
+	EGraph(void) : EGraph{Options{}} {
+		return;
+	}
+	
+	ClassId add(const RtTerm& t) {
+		ENode ret{t.isVariable() ? Op::Variable : Op::Function, t.Name, {}};
+		ret.Children.reserve(t.Args.size());
+		for ( const auto& arg : t.Args ) {
+			ret.Children.push_back(add(arg));
+		} //for ( const auto& arg : t.Args )
+		return add(std::move(ret));
+	}
+	
+	/**
+	 * @brief Adds the formula to the graph and returns its class.
+	 *
+	 * Conjunctions and disjunctions are nested to the right, the empty ones are their unit.
+	 */
+	ClassId add(const RtFormula& f) {
+		using Kind = RtFormula::Kind;
+		const auto o = static_cast<Op>(f.K);
+		switch ( f.K ) {
+			case Kind::And        :
+			case Kind::Or         : {
+				if ( f.Children.empty() ) {
+					return add(ENode{f.K == Kind::And ? Op::True : Op::False, std::nullopt, {}});
+				} //if ( f.Children.empty() )
+				return add(o, f.Children, 0);
+			} //case Kind::And, Kind::Or
+			default               : {
+				ENode ret{o, f.N, {}};
+				for ( const auto& t : f.Terms ) {
+					ret.Children.push_back(add(t));
+				} //for ( const auto& t : f.Terms )
+				for ( const auto& child : f.Children ) {
+					ret.Children.push_back(add(child));
+				} //for ( const auto& child : f.Children )
+				return add(std::move(ret));
+			} //default
+		} //switch ( f.K )
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	ClassId add(const T& f) {
+		return add(toRuntime(f));
+	}
+	
+	ClassId find(ClassId c) const noexcept {
+		while ( Parent[c] != c ) {
+			c = Parent[c];
+		} //while ( Parent[c] != c )
+		return c;
+	}
+	
+	/**
+	 * @brief Unites the classes, returns whether they were different. The graph has to be rebuilt afterwards.
+	 */
+	bool merge(ClassId c1, ClassId c2) {
+		c1 = find(c1);
+		c2 = find(c2);
+		if ( c1 == c2 ) {
+			return false;
+		} //if ( c1 == c2 )
+		if ( Nodes[c1].size() < Nodes[c2].size() ) {
+			std::swap(c1, c2);
+		} //if ( Nodes[c1].size() < Nodes[c2].size() )
+		Parent[c2] = c1;
+		auto& from = Nodes[c2];
+		Nodes[c1].insert(Nodes[c1].end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+		from = {};
+		Dirty = true;
+		return true;
+	}
+	
+	/**
+	 * @brief Restores the invariants after merges: the children of all nodes are representatives, no node is stored
+	 * twice, and congruent nodes are in the same class.
+	 */
+	void rebuild(void) {
+		while ( Dirty ) {
+			Dirty     = false;
+			NodeCount = 0;
+			Memo.clear();
+			std::vector<std::pair<ClassId, ClassId>> congruent;
+			for ( ClassId c = 0; c < Parent.size(); ++c ) {
+				if ( Parent[c] != c ) {
+					continue;
+				} //if ( Parent[c] != c )
+				auto& nodes      = Nodes[c];
+				std::size_t kept = 0;
+				for ( std::size_t i = 0; i < nodes.size(); ++i ) {
+					for ( auto& child : nodes[i].Children ) {
+						child = find(child);
+					} //for ( auto& child : nodes[i].Children )
+					const auto [iter, inserted] = Memo.emplace(nodes[i], c);
+					if ( !inserted ) {
+						if ( iter->second != c ) {
+							congruent.emplace_back(iter->second, c);
+						} //if ( iter->second != c )
+						continue;
+					} //if ( !inserted )
+					if ( kept != i ) {
+						nodes[kept] = std::move(nodes[i]);
+					} //if ( kept != i )
+					++kept;
+				} //for ( std::size_t i = 0; i < nodes.size(); ++i )
+				nodes.resize(kept);
+				NodeCount += kept;
+			} //for ( ClassId c = 0; c < Parent.size(); ++c )
+			
+			for ( const auto& [c1, c2] : congruent ) {
+				merge(c1, c2);
+			} //for ( const auto& [c1, c2] : congruent )
+		} //while ( Dirty )
+		return;
+	}
+	
+	/**
+	 * @brief Applies the rewrite rules in rounds until a round changes nothing or a limit is reached.
+	 *
+	 * A round first matches all nodes and then applies the rewrites, so the rules see the same graph. The node limit
+	 * and the time are also checked while applying, a stopped round is still rebuilt.
+	 */
+	Report saturate(void) {
+		const auto start = std::chrono::steady_clock::now();
+		const auto overTime = [this, &start](void) {
+				return std::chrono::steady_clock::now() - start > Opts.TimeLimit;
+			};
+		rebuild();
+		
+		std::vector<Rewrite> rewrites;
+		for ( std::size_t iteration = 0; ; ++iteration ) {
+			if ( iteration >= Opts.MaxIterations ) {
+				return {StopReason::IterationLimit, iteration};
+			} //if ( iteration >= Opts.MaxIterations )
+			
+			rewrites.clear();
+			for ( ClassId c = 0; c < Parent.size(); ++c ) {
+				for ( const auto& n : Nodes[c] ) {
+					match(c, n, rewrites);
+				} //for ( const auto& n : Nodes[c] )
+			} //for ( ClassId c = 0; c < Parent.size(); ++c )
+			
+			const auto classes = Parent.size();
+			bool changed       = false;
+			std::optional<StopReason> stop;
+			for ( std::size_t i = 0; i < rewrites.size(); ++i ) {
+				if ( NodeCount >= Opts.MaxNodes ) {
+					stop = StopReason::NodeLimit;
+					break;
+				} //if ( NodeCount >= Opts.MaxNodes )
+				if ( i % 256 == 255 && overTime() ) {
+					stop = StopReason::TimeLimit;
+					break;
+				} //if ( i % 256 == 255 && overTime() )
+				changed = merge(rewrites[i].Class, instantiate(rewrites[i].Replacement)) || changed;
+			} //for ( std::size_t i = 0; i < rewrites.size(); ++i )
+			rebuild();
+			
+			if ( stop ) {
+				return {*stop, iteration + 1};
+			} //if ( stop )
+			if ( !changed && Parent.size() == classes ) {
+				return {StopReason::Saturated, iteration + 1};
+			} //if ( !changed && Parent.size() == classes )
+			if ( overTime() ) {
+				return {StopReason::TimeLimit, iteration + 1};
+			} //if ( overTime() )
+		} //for ( std::size_t iteration = 0; ; ++iteration )
+	}
+	
+	/**
+	 * @brief Returns the cheapest formula of the class c, the graph must not have merges pending a rebuild().
+	 *
+	 * The cheapest node of every class is computed by iterating to the fixpoint, a node costs more than any of its
+	 * children, so the choice is acyclic. Nested junctions of the same kind are flattened.
+	 */
+	RtFormula extract(ClassId c, const Cost model = Cost::Size) const {
+		if ( Dirty ) {
+			throw std::logic_error{"The graph has to be rebuilt before extracting!"};
+		} //if ( Dirty )
+		std::vector<double> best(Parent.size(), std::numeric_limits<double>::infinity());
+		std::vector<const ENode*> choice(Parent.size(), nullptr);
+		for ( bool changed = true; changed; ) {
+			changed = false;
+			for ( ClassId d = 0; d < Parent.size(); ++d ) {
+				for ( const auto& n : Nodes[d] ) {
+					const auto nodeCost = cost(n, model, best);
+					if ( nodeCost < best[d] ) {
+						best[d]   = nodeCost;
+						choice[d] = &n;
+						changed   = true;
+					} //if ( nodeCost < best[d] )
+				} //for ( const auto& n : Nodes[d] )
+			} //for ( ClassId d = 0; d < Parent.size(); ++d )
+		} //for ( bool changed = true; changed; )
+		
+		const auto term = [&choice](const auto& self, const ClassId d) -> RtTerm {
+				const ENode& n = *choice[d];
+				if ( n.O == Op::Variable ) {
+					return RtVariable{*n.N};
+				} //if ( n.O == Op::Variable )
+				std::vector<RtTerm> args;
+				args.reserve(n.Children.size());
+				for ( const auto child : n.Children ) {
+					args.push_back(self(self, child));
+				} //for ( const auto child : n.Children )
+				return {*n.N, std::move(args)};
+			};
+		
+		const auto formula = [&choice, &term](const auto& self, const ClassId d) -> RtFormula {
+				const ENode& n = *choice[d];
+				const auto k   = static_cast<RtFormula::Kind>(n.O);
+				std::vector<RtTerm> terms;
+				std::vector<RtFormula> children;
+				if ( n.O == Op::Predicate || n.O == Op::Equality ) {
+					for ( const auto child : n.Children ) {
+						terms.push_back(term(term, child));
+					} //for ( const auto child : n.Children )
+				} //if ( n.O == Op::Predicate || n.O == Op::Equality )
+				else {
+					for ( const auto child : n.Children ) {
+						auto form = self(self, child);
+						if ( (n.O == Op::And || n.O == Op::Or) && form.K == k ) {
+							children.insert(children.end(), std::make_move_iterator(form.Children.begin()),
+							                std::make_move_iterator(form.Children.end()));
+						} //if ( (n.O == Op::And || n.O == Op::Or) && form.K == k )
+						else {
+							children.push_back(std::move(form));
+						} //else -> if ( (n.O == Op::And || n.O == Op::Or) && form.K == k )
+					} //for ( const auto child : n.Children )
+				} //else -> if ( n.O == Op::Predicate || n.O == Op::Equality )
+				return {k, n.N, std::move(terms), std::move(children)};
+			};
+		
+		c = find(c);
+		if ( choice[c] == nullptr || choice[c]->O == Op::Variable || choice[c]->O == Op::Function ) {
+			throw std::invalid_argument{"Class is not a formula!"};
+		} //if ( choice[c] == nullptr || choice[c]->O == Op::Variable || choice[c]->O == Op::Function )
+		return formula(formula, c);
+	}
+	
+	/**
+	 * @brief Returns the number of nodes, as of the last rebuild() plus the ones added since.
+	 */
+	std::size_t nodeCount(void) const noexcept {
+		return NodeCount;
+	}
+	
+	std::size_t classCount(void) const noexcept {
+		std::size_t ret = 0;
+		for ( ClassId c = 0; c < Parent.size(); ++c ) {
+			ret += Parent[c] == c ? 1u : 0u;
+		} //for ( ClassId c = 0; c < Parent.size(); ++c )
+		return ret;
+	}
+};
+
+/**
+ * @brief Simplifies f by equality saturation and returns the cheapest equivalent form found.
+ *
+ * Unlike simplified() the rules are not applied greedily, so the result is never more expensive than f itself.
+ * Implications and equivalences are kept if they are cheaper than their expansion.
+ */
+inline RtFormula saturated(const RtFormula& f, const EGraph::Cost model, const EGraph::Options options) {
+	EGraph graph{options};
+	const auto root = graph.add(f);
+	graph.saturate();
+	return graph.extract(root, model);
+}
+
+inline RtFormula saturated(const RtFormula& f, const EGraph::Cost model = EGraph::Cost::Size) {
+	return saturated(f, model, EGraph::Options{});
+}
+
+template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+RtFormula saturated(const T& f, const EGraph::Cost model, const EGraph::Options options) {
+	return saturated(toRuntime(f), model, options);
+}
+
+template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+RtFormula saturated(const T& f, const EGraph::Cost model = EGraph::Cost::Size) {
+	return saturated(toRuntime(f), model);
+}
+
+} //namespace fol
+
+#endif
@@ -8,7 +8,9 @@
 
 #include "not.hpp"
 #include "pretty_printer.hpp"
+#include "storage.hpp"
 #include "traits.hpp"
+#include "truth.hpp"
 
 #include <ostream>
 #include <type_traits>
@@ -16,11 +18,11 @@
 namespace fol {
 
 template<typename T1, typename T2>
-struct Equality {
+struct Equality : details::StoredTerm1<T1>, details::StoredTerm2<T2> {
 	static_assert(IsTerm<T1>::value && IsTerm<T2>::value, "Equality is only defined for two terms!");
 	
-	T1 Term1;
-	T2 Term2;
+	using details::StoredTerm1<T1>::Term1;
+	using details::StoredTerm2<T2>::Term2;
 	
 	using VariableCount = std::integral_constant<std::size_t, T1::VariableCount::value + T2::VariableCount::value>;
 //	using VariableArray = decltype(ArraySet<0>{} + typename T1::VariableArray{} + typename T1::VariableArray{});
@@ -29,11 +31,18 @@ struct Equality {
 	
 	constexpr Equality(T1 t1, T2 t2)
 			noexcept(std::is_nothrow_move_constructible_v<T1> && std::is_nothrow_move_constructible_v<T2>) :
-			Term1{std::move(t1)}, Term2{std::move(t2)} {
+			details::StoredTerm1<T1>{std::move(t1)}, details::StoredTerm2<T2>{std::move(t2)} {
 		return;
 	}
 	
-	constexpr auto simplified(void) const { return *this; }
+	constexpr auto simplified(void) const {
+		if constexpr ( IsStatic<T1>::value && std::is_same_v<T1, T2> ) {
+			return True{};
+		} //if constexpr ( IsStatic<T1>::value && std::is_same_v<T1, T2> )
+		else {
+			return *this;
+		} //else -> if constexpr ( IsStatic<T1>::value && std::is_same_v<T1, T2> )
+	}
 	
 	constexpr auto negate(void) const { return Not{*this}; }
 	
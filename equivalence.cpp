@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks equivalence.hpp for self-containment.
+ * 
+ */
+
+#include "equivalence.hpp"
@@ -0,0 +1,317 @@
+/**
+ * @file
+ * @brief Contains the staged semantic equivalence check of formulas.
+ */
+
+#ifndef FOL_EQUIVALENCE_HPP
+#define FOL_EQUIVALENCE_HPP
+
+#include "bdd.hpp"
+#include "bytecode.hpp"
+#include "evaluation.hpp"
+#include "rt_formula.hpp"
+#include "traits.hpp"
+#include "truth_table.hpp"
+#include "visit.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief The stages of the check, in the order they are tried.
+ */
+enum class EquivalenceStage : std::uint8_t {
+	Structural,    //Equal after simplification and negation normal form, compared by hash first.
+	Simulation,    //A random finite interpretation in which the formulas differ.
+	Propositional, //Truth table or BDD of the formulas with every atom replaced by a propositional variable.
+	Undecided
+};
+
+constexpr std::size_t EquivalenceStageCount = 4;
+
+enum class Verdict : std::uint8_t { Equivalent, NotEquivalent, Unknown };
+
+struct EquivalenceResult {
+	Verdict V;
+	EquivalenceStage Stage;
+	
+	explicit operator bool(void) const noexcept {
+		return V == Verdict::Equivalent;
+	}
+};
+
+/**
+ * @brief Checks formulas for equivalence with increasingly expensive stages and counts which stage decided.
+ *
+ * Equivalent means equal truth values in every interpretation under every assignment of the free variables. The
+ * structural and the propositional stage can only prove equivalence, the simulation only inequivalence. For
+ * quantifier free formulas without equality the propositional stage is complete, because distinct atoms can be chosen
+ * independently in a Herbrand interpretation. Everything else the pipeline can not decide is reported as Unknown.
+ */
+class EquivalenceChecker {
+	public:
+	struct Options {
+		std::size_t SimulationRounds = 64;
+		std::size_t MaxDomainSize    = 3;
+		std::uint64_t Seed           = 0x5eed;
+	};
+	
+	private:
+	struct Symbol {
+		RtName Name;
+		std::size_t Arity;
+		bool IsPredicate;
+	};
+	
+	Options Opts;
+	std::mt19937_64 Random;
+	std::array<std::size_t, EquivalenceStageCount> Decided{};
+	std::array<std::chrono::nanoseconds, EquivalenceStageCount> Elapsed{};
+	
+	/**
+	 * @brief Returns the symbols of the formulas, or nothing if a name is used with different arities.
+	 */
+	static std::optional<std::vector<Symbol>> signature(const RtFormula& f1, const RtFormula& f2) {
+		std::vector<Symbol> ret;
+		std::unordered_map<RtName, std::size_t> predicates, functions;
+		bool consistent = true;
+		const auto add = [&](const RtName& name, const std::size_t arity, const bool isPredicate) {
+				auto& known = isPredicate ? predicates : functions;
+				if ( const auto iter = known.find(name); iter != known.end() ) {
+					consistent = consistent && ret[iter->second].Arity == arity;
+					return;
+				} //if ( const auto iter = known.find(name); iter != known.end() )
+				known.emplace(name, ret.size());
+				ret.push_back({name, arity, isPredicate});
+				return;
+			};
+		const auto collect = [&add](const auto& node) {
+				if constexpr ( std::is_same_v<std::decay_t<decltype(node)>, RtFormula> ) {
+					if ( node.K == RtFormula::Kind::Predicate ) {
+						add(*node.N, node.Terms.size(), true);
+					} //if ( node.K == RtFormula::Kind::Predicate )
+				} //if constexpr ( std::is_same_v<std::decay_t<decltype(node)>, RtFormula> )
+				else if ( !node.isVariable() ) {
+					add(node.Name, node.Args.size(), false);
+				} //else if ( !node.isVariable() )
+				return true;
+			};
+		visit(f1, collect);
+		visit(f2, collect);
+		if ( !consistent ) {
+			return std::nullopt;
+		} //if ( !consistent )
+		return ret;
+	}
+	
+	Interpretation randomInterpretation(const std::vector<Symbol>& symbols, const std::size_t domainSize) {
+		Interpretation ret{domainSize};
+		const auto last = static_cast<Interpretation::Element>(domainSize - 1);
+		std::uniform_int_distribution<Interpretation::Element> element{0, last};
+		for ( const auto& symbol : symbols ) {
+			if ( symbol.IsPredicate ) {
+				ret.definePredicate(symbol.Name, symbol.Arity, [this](const Interpretation::Element*) {
+						return (Random() & 1) != 0;
+					});
+			} //if ( symbol.IsPredicate )
+			else {
+				ret.defineFunction(symbol.Name, symbol.Arity, [this, &element](const Interpretation::Element*) {
+						return element(Random);
+					});
+			} //else -> if ( symbol.IsPredicate )
+		} //for ( const auto& symbol : symbols )
+		return ret;
+	}
+	
+	/**
+	 * @brief Searches a random interpretation and assignment in which the formulas have different truth values.
+	 */
+	bool findCounterexample(const RtFormula& f1, const RtFormula& f2) {
+		const auto symbols = signature(f1, f2);
+		if ( !symbols || Opts.SimulationRounds == 0 ) {
+			return false;
+		} //if ( !symbols || Opts.SimulationRounds == 0 )
+		
+		//All interpretations define the symbols in the same order, so the programs can be compiled once.
+		const auto first = randomInterpretation(*symbols, 1);
+		const CompiledFormula compiled1{f1, first}, compiled2{f2, first};
+		std::vector<RtName> free = compiled1.freeVariables();
+		for ( const auto& name : compiled2.freeVariables() ) {
+			if ( std::find(free.begin(), free.end(), name) == free.end() ) {
+				free.push_back(name);
+			} //if ( std::find(free.begin(), free.end(), name) == free.end() )
+		} //for ( const auto& name : compiled2.freeVariables() )
+		const auto positions = [&free](const CompiledFormula& compiled) {
+				std::vector<std::size_t> ret;
+				for ( const auto& name : compiled.freeVariables() ) {
+					ret.push_back(static_cast<std::size_t>(std::find(free.begin(), free.end(), name) - free.begin()));
+				} //for ( const auto& name : compiled.freeVariables() )
+				return ret;
+			};
+		const auto positions1 = positions(compiled1), positions2 = positions(compiled2);
+		
+		std::vector<Interpretation::Element> values(free.size());
+		std::vector<Interpretation::Element> values1(positions1.size()), values2(positions2.size());
+		for ( std::size_t round = 0; round < Opts.SimulationRounds; ++round ) {
+			const auto domainSize     = 1 + round % std::max<std::size_t>(Opts.MaxDomainSize, 1);
+			const auto interpretation = round == 0 ? first : randomInterpretation(*symbols, domainSize);
+			const auto last           = static_cast<Interpretation::Element>(domainSize - 1);
+			std::uniform_int_distribution<Interpretation::Element> element{0, last};
+			for ( auto& value : values ) {
+				value = element(Random);
+			} //for ( auto& value : values )
+			for ( std::size_t i = 0; i < positions1.size(); ++i ) {
+				values1[i] = values[positions1[i]];
+			} //for ( std::size_t i = 0; i < positions1.size(); ++i )
+			for ( std::size_t i = 0; i < positions2.size(); ++i ) {
+				values2[i] = values[positions2[i]];
+			} //for ( std::size_t i = 0; i < positions2.size(); ++i )
+			if ( compiled1.machine(interpretation).run(values1) != compiled2.machine(interpretation).run(values2) ) {
+				return true;
+			} //if ( compiled1.machine(interpretation).run(values1) != compiled2.machine(interpretation).run(values2) )
+		} //for ( std::size_t round = 0; round < Opts.SimulationRounds; ++round )
+		return false;
+	}
+	
+	/**
+	 * @brief Replaces every distinct atom by a propositional variable.
+	 * @return Nothing if the formula has a quantifier.
+	 */
+	static std::optional<RtFormula> abstracted(const RtFormula& f, std::unordered_map<RtFormula, std::size_t>& atoms,
+	                                           bool& hasEquality) {
+		using Kind = RtFormula::Kind;
+		switch ( f.K ) {
+			case Kind::Predicate  :
+			case Kind::Equality   : {
+				hasEquality = hasEquality || f.K == Kind::Equality;
+				const auto id = atoms.emplace(f, atoms.size()).first->second;
+				return RtFormula::predicate(RtName{std::to_string(id)});
+			} //case Kind::Predicate, Kind::Equality
+			case Kind::Exists     :
+			case Kind::ForAll     : return std::nullopt;
+			default               : {
+				std::vector<RtFormula> children;
+				children.reserve(f.Children.size());
+				for ( const auto& child : f.Children ) {
+					auto abstractedChild = abstracted(child, atoms, hasEquality);
+					if ( !abstractedChild ) {
+						return std::nullopt;
+					} //if ( !abstractedChild )
+					children.push_back(std::move(*abstractedChild));
+				} //for ( const auto& child : f.Children )
+				return RtFormula{f.K, std::nullopt, {}, std::move(children)};
+			} //default
+		} //switch ( f.K )
+	}
+	
+	/**
+	 * @brief Decides the propositional abstraction.
+	 * @return Nothing if the formulas are not quantifier free.
+	 */
+	static std::optional<Verdict> propositional(const RtFormula& f1, const RtFormula& f2) {
+		std::unordered_map<RtFormula, std::size_t> atoms;
+		bool hasEquality = false;
+		const auto a1 = abstracted(f1, atoms, hasEquality);
+		const auto a2 = abstracted(f2, atoms, hasEquality);
+		if ( !a1 || !a2 ) {
+			return std::nullopt;
+		} //if ( !a1 || !a2 )
+		
+		bool equivalent;
+		if ( atoms.size() <= TruthTable::MaxVariables ) {
+			equivalent = arePropositionallyEquivalent(*a1, *a2);
+		} //if ( atoms.size() <= TruthTable::MaxVariables )
+		else {
+			BddManager bdds;
+			equivalent = bdds.build(*a1) == bdds.build(*a2);
+		} //else -> if ( atoms.size() <= TruthTable::MaxVariables )
+		
+		if ( equivalent ) {
+			return Verdict::Equivalent;
+		} //if ( equivalent )
+		//With equality the atoms are not independent, x = x is an abstracted variable but valid.
+		return hasEquality ? Verdict::Unknown : Verdict::NotEquivalent;
+	}
+	
+	EquivalenceResult decided(const Verdict verdict, const EquivalenceStage stage,
+	                          const std::chrono::steady_clock::time_point start) noexcept {
+		const auto index = static_cast<std::size_t>(stage);
+		++Decided[index];
+		Elapsed[index] += std::chrono::steady_clock::now() - start;
+		return {verdict, stage};
+	}
+	
+	public:
+	EquivalenceChecker(void) : EquivalenceChecker{Options{}} {
+		return;
+	}
+	
+	explicit EquivalenceChecker(const Options options) : Opts{options}, Random{options.Seed} {
+		return;
+	}
+	
+	EquivalenceResult check(const RtFormula& f1, const RtFormula& f2) {
+		const auto start = std::chrono::steady_clock::now();
+		if ( f1 == f2 ) {
+			return decided(Verdict::Equivalent, EquivalenceStage::Structural, start);
+		} //if ( f1 == f2 )
+		const auto normal1 = f1.toNegationNormalForm().simplified();
+		const auto normal2 = f2.toNegationNormalForm().simplified();
+		if ( std::hash<RtFormula>{}(normal1) == std::hash<RtFormula>{}(normal2) && normal1 == normal2 ) {
+			return decided(Verdict::Equivalent, EquivalenceStage::Structural, start);
+		} //if ( std::hash<RtFormula>{}(normal1) == std::hash<RtFormula>{}(normal2) && normal1 == normal2 )
+		
+		if ( findCounterexample(normal1, normal2) ) {
+			return decided(Verdict::NotEquivalent, EquivalenceStage::Simulation, start);
+		} //if ( findCounterexample(normal1, normal2) )
+		
+		if ( const auto verdict = propositional(normal1, normal2); verdict && *verdict != Verdict::Unknown ) {
+			return decided(*verdict, EquivalenceStage::Propositional, start);
+		} //if ( const auto verdict = propositional(normal1, normal2); verdict && *verdict != Verdict::Unknown )
+		return decided(Verdict::Unknown, EquivalenceStage::Undecided, start);
+	}
+	
+	template<typename T1, typename T2,
+	         std::enable_if_t<IsFormula<T1>::value && IsFormula<T2>::value>* = nullptr>
+	EquivalenceResult check(const T1& f1, const T2& f2) {
+		return check(toRuntime(f1), toRuntime(f2));
+	}
+	
+	/**
+	 * @brief Returns how many queries the stage decided.
+	 */
+	std::size_t decided(const EquivalenceStage stage) const noexcept {
+		return Decided[static_cast<std::size_t>(stage)];
+	}
+	
+	/**
+	 * @brief Returns the time of all queries the stage decided, including the earlier stages they went through.
+	 */
+	std::chrono::nanoseconds elapsed(const EquivalenceStage stage) const noexcept {
+		return Elapsed[static_cast<std::size_t>(stage)];
+	}
+};
+
+/**
+ * @brief Checks the formulas for equivalence with the default options.
+ */
+template<typename T1, typename T2>
+EquivalenceResult areEquivalent(const T1& f1, const T2& f2) {
+	EquivalenceChecker checker;
+	return checker.check(toRuntime(f1), toRuntime(f2));
+}
+
+} //namespace fol
+
+#endif
@@ -7,19 +7,22 @@
 #define FOL_EQUIVALENT_HPP
 
 #include "and.hpp"
+#include "helper.hpp"
 #include "implies.hpp"
 #include "pretty_printer.hpp"
+#include "storage.hpp"
 #include "traits.hpp"
 
 #include <ostream>
+#include <tuple>
 
 namespace fol {
 
 template<typename T1, typename T2>
-struct Equivalent {
+struct Equivalent : details::StoredT1<T1>, details::StoredT2<T2> {
 	static_assert(IsFormula<T1>::value && IsFormula<T2>::value, "Both parameters have to be formulas!");
-	T1 t1;
-	T2 t2;
+	using details::StoredT1<T1>::t1;
+	using details::StoredT2<T2>::t2;
 	
 	using VariableCount = std::integral_constant<std::size_t, T1::VariableCount::value + T2::VariableCount::value>;
 //	using VariableArray = decltype(ArraySet<0>{} + typename T1::VariableArray{} + typename T1::VariableArray{});
@@ -27,7 +30,7 @@ struct Equivalent {
 	constexpr auto simplified(void) const {
 		auto leftImplies  = Implies<T1, T2>{t1, t2}.simplified();
 		auto rightImplies = Implies<T2, T1>{t2, t1}.simplified();
-		return And{leftImplies, rightImplies};
+		return details::simplifyJunction<And, True, False, Or>(std::make_tuple(leftImplies, rightImplies));
 	}
 	
 	constexpr auto negate(void) const {
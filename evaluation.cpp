@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks evaluation.hpp for self-containment.
+ * 
+ */
+
+#include "evaluation.hpp"
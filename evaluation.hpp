@@ -0,0 +1,276 @@
+/**
+ * @file
+ * @brief Contains finite interpretations and the evaluation of formulas in them.
+ */
+
+#ifndef FOL_EVALUATION_HPP
+#define FOL_EVALUATION_HPP
+
+#include "name.hpp"
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief An interpretation over the domain {0, ..., domainSize-1}.
+ *
+ * Every predicate and function is stored as a table over all argument tuples, the arguments are read as a number with
+ * the base domainSize, the first argument being the most significant digit.
+ */
+class Interpretation {
+	public:
+	using Element = std::uint32_t;
+	
+	private:
+	struct Symbol {
+		RtName Name;
+		std::size_t Arity;
+		std::size_t Offset;
+	};
+	
+	std::size_t DomainSize;
+	std::vector<Symbol> Predicates;
+	std::vector<Symbol> Functions;
+	std::unordered_map<RtName, std::uint32_t> PredicateIds;
+	std::unordered_map<RtName, std::uint32_t> FunctionIds;
+	std::vector<std::uint8_t> PredicateTable;
+	std::vector<Element> FunctionTable;
+	
+	std::size_t tableSize(const std::size_t arity) const {
+		std::size_t ret = 1;
+		for ( std::size_t i = 0; i < arity; ++i ) {
+			if ( ret > std::numeric_limits<std::uint32_t>::max() / DomainSize ) {
+				throw std::length_error{"Table of the symbol would be too large!"};
+			} //if ( ret > std::numeric_limits<std::uint32_t>::max() / DomainSize )
+			ret *= DomainSize;
+		} //for ( std::size_t i = 0; i < arity; ++i )
+		return ret;
+	}
+	
+	std::size_t index(const Symbol& symbol, const Element *args) const noexcept {
+		std::size_t ret = 0;
+		for ( std::size_t i = 0; i < symbol.Arity; ++i ) {
+			ret = ret * DomainSize + args[i];
+		} //for ( std::size_t i = 0; i < symbol.Arity; ++i )
+		return symbol.Offset + ret;
+	}
+	
+	/**
+	 * @brief Calls f with every argument tuple, in the order of the table.
+	 */
+	template<typename F>
+	void forEachTuple(const std::size_t arity, F f) const {
+		std::vector<Element> args(arity, 0);
+		const auto size = tableSize(arity);
+		for ( std::size_t entry = 0; entry < size; ++entry ) {
+			f(args.data());
+			for ( std::size_t i = arity; i-- > 0; ) {
+				if ( ++args[i] < DomainSize ) {
+					break;
+				} //if ( ++args[i] < DomainSize )
+				args[i] = 0;
+			} //for ( std::size_t i = arity; i-- > 0; )
+		} //for ( std::size_t entry = 0; entry < size; ++entry )
+		return;
+	}
+	
+	static std::uint32_t define(std::vector<Symbol>& symbols, std::unordered_map<RtName, std::uint32_t>& ids,
+	                            RtName name, const std::size_t arity, const std::size_t offset) {
+		if ( ids.count(name) ) {
+			throw std::invalid_argument{"Symbol " + name.string() + " is already defined!"};
+		} //if ( ids.count(name) )
+		const auto id = static_cast<std::uint32_t>(symbols.size());
+		ids.emplace(name, id);
+		symbols.push_back({std::move(name), arity, offset});
+		return id;
+	}
+	
+	public:
+	explicit Interpretation(const std::size_t domainSize) : DomainSize{domainSize} {
+		if ( domainSize == 0 || domainSize > std::numeric_limits<Element>::max() ) {
+			throw std::invalid_argument{"The domain must not be empty!"};
+		} //if ( domainSize == 0 || domainSize > std::numeric_limits<Element>::max() )
+		return;
+	}
+	
+	std::size_t domainSize(void) const noexcept {
+		return DomainSize;
+	}
+	
+	std::uint32_t definePredicate(RtName name, const std::size_t arity,
+	                              const std::function<bool(const Element*)>& holds) {
+		const auto id = define(Predicates, PredicateIds, std::move(name), arity, PredicateTable.size());
+		forEachTuple(arity, [this, &holds](const Element *args) {
+				PredicateTable.push_back(holds(args) ? 1 : 0);
+				return;
+			});
+		return id;
+	}
+	
+	std::uint32_t defineFunction(RtName name, const std::size_t arity,
+	                             const std::function<Element(const Element*)>& f) {
+		const auto id = define(Functions, FunctionIds, std::move(name), arity, FunctionTable.size());
+		forEachTuple(arity, [this, &f](const Element *args) {
+				const auto value = f(args);
+				if ( value >= DomainSize ) {
+					throw std::out_of_range{"Function value outside of the domain!"};
+				} //if ( value >= DomainSize )
+				FunctionTable.push_back(value);
+				return;
+			});
+		return id;
+	}
+	
+	std::optional<std::uint32_t> predicateId(const RtName& name) const {
+		if ( const auto iter = PredicateIds.find(name); iter != PredicateIds.end() ) {
+			return iter->second;
+		} //if ( const auto iter = PredicateIds.find(name); iter != PredicateIds.end() )
+		return std::nullopt;
+	}
+	
+	std::optional<std::uint32_t> functionId(const RtName& name) const {
+		if ( const auto iter = FunctionIds.find(name); iter != FunctionIds.end() ) {
+			return iter->second;
+		} //if ( const auto iter = FunctionIds.find(name); iter != FunctionIds.end() )
+		return std::nullopt;
+	}
+	
+	std::size_t predicateArity(const std::uint32_t id) const {
+		return Predicates.at(id).Arity;
+	}
+	
+	std::size_t functionArity(const std::uint32_t id) const {
+		return Functions.at(id).Arity;
+	}
+	
+	bool holds(const std::uint32_t id, const Element *args) const noexcept {
+		return PredicateTable[index(Predicates[id], args)];
+	}
+	
+	Element apply(const std::uint32_t id, const Element *args) const noexcept {
+		return FunctionTable[index(Functions[id], args)];
+	}
+};
+
+using Assignment = std::unordered_map<RtName, Interpretation::Element>;
+
+/**
+ * @brief Evaluates the term under the assignment.
+ */
+inline Interpretation::Element evaluate(const RtTerm& t, const Interpretation& interpretation,
+                                        const Assignment& assignment) {
+	if ( t.isVariable() ) {
+		const auto iter = assignment.find(t.Name);
+		if ( iter == assignment.end() ) {
+			throw std::invalid_argument{"Variable " + t.Name.string() + " is not assigned!"};
+		} //if ( iter == assignment.end() )
+		return iter->second;
+	} //if ( t.isVariable() )
+	
+	const auto id = interpretation.functionId(t.Name);
+	if ( !id || interpretation.functionArity(*id) != t.Args.size() ) {
+		throw std::invalid_argument{"Function " + t.Name.string() + " is not interpreted with this arity!"};
+	} //if ( !id || interpretation.functionArity(*id) != t.Args.size() )
+	std::vector<Interpretation::Element> args;
+	args.reserve(t.Args.size());
+	for ( const auto& arg : t.Args ) {
+		args.push_back(evaluate(arg, interpretation, assignment));
+	} //for ( const auto& arg : t.Args )
+	return interpretation.apply(*id, args.data());
+}
+
+/**
+ * @brief Evaluates the formula by walking its tree, the quantifiers iterate over the whole domain.
+ *
+ * The assignment is used for the free variables and restored after the bound ones.
+ */
+inline bool evaluate(const RtFormula& f, const Interpretation& interpretation, Assignment& assignment) {
+	using Kind = RtFormula::Kind;
+	const auto child = [&](const std::size_t index) {
+			return evaluate(f.Children[index], interpretation, assignment);
+		};
+	
+	switch ( f.K ) {
+		case Kind::True       : return true;
+		case Kind::False      : return false;
+		case Kind::Predicate  : {
+			const auto id = interpretation.predicateId(*f.N);
+			if ( !id || interpretation.predicateArity(*id) != f.Terms.size() ) {
+				throw std::invalid_argument{"Predicate " + f.N->string() + " is not interpreted with this arity!"};
+			} //if ( !id || interpretation.predicateArity(*id) != f.Terms.size() )
+			std::vector<Interpretation::Element> args;
+			args.reserve(f.Terms.size());
+			for ( const auto& term : f.Terms ) {
+				args.push_back(evaluate(term, interpretation, assignment));
+			} //for ( const auto& term : f.Terms )
+			return interpretation.holds(*id, args.data());
+		} //case Kind::Predicate
+		case Kind::Equality   : {
+			return evaluate(f.Terms[0], interpretation, assignment) ==
+			       evaluate(f.Terms[1], interpretation, assignment);
+		} //case Kind::Equality
+		case Kind::Not        : return !child(0);
+		case Kind::And        : {
+			for ( std::size_t i = 0; i < f.Children.size(); ++i ) {
+				if ( !child(i) ) {
+					return false;
+				} //if ( !child(i) )
+			} //for ( std::size_t i = 0; i < f.Children.size(); ++i )
+			return true;
+		} //case Kind::And
+		case Kind::Or         : {
+			for ( std::size_t i = 0; i < f.Children.size(); ++i ) {
+				if ( child(i) ) {
+					return true;
+				} //if ( child(i) )
+			} //for ( std::size_t i = 0; i < f.Children.size(); ++i )
+			return false;
+		} //case Kind::Or
+		case Kind::Implies    : return !child(0) || child(1);
+		case Kind::Equivalent : return child(0) == child(1);
+		case Kind::Exists     :
+		case Kind::ForAll     : {
+			const bool isForAll = f.K == Kind::ForAll;
+			std::optional<Interpretation::Element> outer;
+			if ( const auto iter = assignment.find(*f.N); iter != assignment.end() ) {
+				outer = iter->second;
+			} //if ( const auto iter = assignment.find(*f.N); iter != assignment.end() )
+			auto& value = assignment[*f.N];
+			
+			bool ret = isForAll;
+			for ( std::size_t element = 0; element < interpretation.domainSize() && ret == isForAll; ++element ) {
+				value = static_cast<Interpretation::Element>(element);
+				ret   = child(0);
+			} //for ( std::size_t element = 0; element < interpretation.domainSize() && ret == isForAll; ++element )
+			
+			if ( outer ) {
+				assignment[*f.N] = *outer;
+			} //if ( outer )
+			else {
+				assignment.erase(*f.N);
+			} //else -> if ( outer )
+			return ret;
+		} //case Kind::Exists, Kind::ForAll
+	} //switch ( f.K )
+	return false;
+}
+
+template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+bool evaluate(const T& f, const Interpretation& interpretation, Assignment& assignment) {
+	return evaluate(toRuntime(f), interpretation, assignment);
+}
+
+} //namespace fol
+
+#endif
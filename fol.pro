@@ -1,7 +1,10 @@
 TEMPLATE	 = app
-CONFIG		+= console c++1z strict_c++
+CONFIG		+= console c++1z strict_c++ thread
 CONFIG		-= qt
 
+#Mit CONFIG += stats werden die Transformationen instrumentiert, siehe stats.hpp.
+stats:DEFINES += FOL_ENABLE_STATS
+
 gcc {
 	QMAKE_CFLAGS_DEBUG		*= -ggdb3
 	QMAKE_CXXFLAGS_DEBUG	*= -ggdb3
@@ -35,38 +38,94 @@ gcc {
 }
 
 SOURCES		 = and.cpp\
+			   batch.cpp\
+			   bdd.cpp\
+			   bytecode.cpp\
+			   clause_store.cpp\
+			   congruence_closure.cpp\
+			   datalog.cpp\
+			   editable_formula.cpp\
+			   egraph.cpp\
 			   equality.cpp\
+			   equivalence.cpp\
 			   equivalent.cpp\
+			   evaluation.cpp\
 			   exists.cpp\
 			   forall.cpp\
+			   formula_dag.cpp\
+			   fresh_names.cpp\
 			   function.cpp\
+			   grounding.cpp\
 			   helper.cpp\
+			   herbrand.cpp\
 			   implies.cpp\
+			   lowering.cpp\
+			   memory.cpp\
+			   miniscoping.cpp\
 			   name.cpp\
+			   nary_junction.cpp\
 			   not.cpp\
 			   or.cpp\
+			   order.cpp\
 			   predicate.cpp\
 			   pretty_printer.cpp\
+			   rt_formula.cpp\
+			   serialization.cpp\
+			   small_vector.cpp\
+			   stats.cpp\
+			   storage.cpp\
+			   subsumption.cpp\
 			   traits.cpp\
+			   truth.cpp\
+			   truth_table.cpp\
 			   variable.cpp\
+			   visit.cpp\
 			   main.cpp
 
 HEADERS		 = and.hpp\
 			   asserts.hpp\
+			   batch.hpp\
+			   bdd.hpp\
+			   bytecode.hpp\
+			   clause_store.hpp\
+			   congruence_closure.hpp\
+			   datalog.hpp\
+			   editable_formula.hpp\
+			   egraph.hpp\
 			   equality.hpp\
+			   equivalence.hpp\
 			   equivalent.hpp\
+			   evaluation.hpp\
 			   exists.hpp\
 			   forall.hpp\
+			   formula_dag.hpp\
 			   forward.hpp\
+			   fresh_names.hpp\
 			   function.hpp\
+			   grounding.hpp\
 			   helper.hpp\
+			   herbrand.hpp\
 			   implies.hpp\
+			   lowering.hpp\
+			   memory.hpp\
+			   miniscoping.hpp\
 			   name.hpp\
+			   nary_junction.hpp\
 			   not.hpp\
 			   or.hpp\
+			   order.hpp\
 			   predicate.hpp\
 			   pretty_printer.hpp\
+			   rt_formula.hpp\
+			   serialization.hpp\
+			   small_vector.hpp\
+			   stats.hpp\
+			   storage.hpp\
+			   subsumption.hpp\
 			   traits.hpp\
-			   variable.hpp
+			   truth.hpp\
+			   truth_table.hpp\
+			   variable.hpp\
+			   visit.hpp
 
 include(libs/constexprStd/constexprStd.pri)
@@ -10,25 +10,33 @@
 
 #include "exists.hpp"
 #include "pretty_printer.hpp"
+#include "storage.hpp"
 #include "traits.hpp"
+#include "truth.hpp"
 
 #include <ostream>
+#include <type_traits>
 
 namespace fol {
 
 template<typename Var, typename Form>
-struct ForAll {
+struct ForAll : details::StoredV<Var>, details::StoredF<Form> {
 	static_assert(IsVariable<Var>::value, "The first parameter has to be a variable!");
 	static_assert(IsFormula<Form>::value, "The secnd parameter has to be a formula!");
-	Var V;
-	Form F;
+	using details::StoredV<Var>::V;
+	using details::StoredF<Form>::F;
 	
 	using VariableCount = std::integral_constant<std::size_t, 1 + Form::VariableCount::value>;
 //	using VariableArray = decltype(ArraySet<1, Var>{} + typename Form::VariableArray{});
 	
 	constexpr auto simplified(void) const {
 		auto form = F.simplified();
-		return ForAll<Var, std::decay_t<decltype(form)>>{V, form};
+		if constexpr ( IsTruth<std::decay_t<decltype(form)>>::value ) {
+			return form;
+		} //if constexpr ( IsTruth<std::decay_t<decltype(form)>>::value )
+		else {
+			return ForAll<Var, std::decay_t<decltype(form)>>{V, form};
+		} //else -> if constexpr ( IsTruth<std::decay_t<decltype(form)>>::value )
 	}
 	
 	constexpr auto negate(void) const {
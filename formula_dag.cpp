@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks formula_dag.hpp for self-containment.
+ * 
+ */
+
+#include "formula_dag.hpp"
@@ -0,0 +1,365 @@
+/**
+ * @file
+ * @brief Contains the hash-consed runtime representation of formulas.
+ */
+
+#ifndef FOL_FORMULA_DAG_HPP
+#define FOL_FORMULA_DAG_HPP
+
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief Stores formulas as a DAG in which structurally equal subformulas are the same node.
+ *
+ * Nodes are never removed, an id stays valid for the lifetime of the DAG. The results of simplified(), negate() and
+ * toNegationNormalForm() are cached per node, negate() being the negative polarity of the negation normal form, so a
+ * shared subformula is only transformed once.
+ */
+class FormulaDag {
+	public:
+	using NodeId = std::uint32_t;
+	using Kind   = RtFormula::Kind;
+	
+	static constexpr NodeId InvalidNode = std::numeric_limits<NodeId>::max();
+	
+	struct Node {
+		Kind K;
+		std::optional<RtName> N;
+		std::vector<RtTerm> Terms;
+		std::vector<NodeId> Children;
+		
+		friend bool operator==(const Node& n1, const Node& n2) noexcept {
+			return n1.K == n2.K && n1.N == n2.N && n1.Terms == n2.Terms && n1.Children == n2.Children;
+		}
+	};
+	
+	private:
+	std::vector<Node> Nodes;
+	std::unordered_multimap<std::size_t, NodeId> Unique;
+	
+	std::vector<NodeId> SimplifiedCache;
+	std::vector<NodeId> NegationNormalFormCache[2];
+	
+	static std::size_t hash(const Node& node) noexcept {
+		std::size_t ret = static_cast<std::size_t>(node.K);
+		if ( node.N ) {
+			ret = details::hashCombine(ret, std::hash<RtName>{}(*node.N));
+		} //if ( node.N )
+		for ( const auto& term : node.Terms ) {
+			ret = details::hashCombine(ret, std::hash<RtTerm>{}(term));
+		} //for ( const auto& term : node.Terms )
+		for ( const auto child : node.Children ) {
+			ret = details::hashCombine(ret, child);
+		} //for ( const auto child : node.Children )
+		return ret;
+	}
+	
+	static NodeId& cacheEntry(std::vector<NodeId>& cache, const NodeId id) {
+		if ( cache.size() <= id ) {
+			cache.resize(id + 1u, InvalidNode);
+		} //if ( cache.size() <= id )
+		return cache[id];
+	}
+	
+	NodeId unary(const Kind k, std::optional<RtName> n, const NodeId child) {
+		return intern({k, std::move(n), {}, {child}});
+	}
+	
+	NodeId binary(const Kind k, const NodeId child1, const NodeId child2) {
+		return intern({k, std::nullopt, {}, {child1, child2}});
+	}
+	
+	NodeId constant(const bool value) {
+		return intern({value ? Kind::True : Kind::False, std::nullopt, {}, {}});
+	}
+	
+	std::vector<NodeId> transformedChildren(const NodeId id, NodeId (FormulaDag::*transform)(NodeId)) {
+		std::vector<NodeId> children = Nodes[id].Children;
+		for ( auto& child : children ) {
+			child = (this->*transform)(child);
+		} //for ( auto& child : children )
+		return children;
+	}
+	
+	NodeId transformed(const NodeId id, const Kind k, NodeId (FormulaDag::*transform)(NodeId)) {
+		return intern({k, std::nullopt, {}, transformedChildren(id, transform)});
+	}
+	
+	/**
+	 * @brief The order of RtFormula::order() on the formulas of the nodes, equal nodes are found by their id.
+	 */
+	int order(NodeId id1, NodeId id2) const noexcept {
+		std::size_t negations1 = 0, negations2 = 0;
+		for ( ; Nodes[id1].K == Kind::Not; id1 = Nodes[id1].Children.front() ) {
+			++negations1;
+		} //for ( ; Nodes[id1].K == Kind::Not; id1 = Nodes[id1].Children.front() )
+		for ( ; Nodes[id2].K == Kind::Not; id2 = Nodes[id2].Children.front() ) {
+			++negations2;
+		} //for ( ; Nodes[id2].K == Kind::Not; id2 = Nodes[id2].Children.front() )
+		
+		const Node& n1 = Nodes[id1];
+		const Node& n2 = Nodes[id2];
+		int ret = 0;
+		if ( id1 != id2 ) {
+			if ( n1.K != n2.K ) {
+				return n1.K < n2.K ? -1 : 1;
+			} //if ( n1.K != n2.K )
+			ret = n1.N && n2.N ? RtName::order(*n1.N, *n2.N) : 0;
+			if ( ret == 0 ) {
+				ret = details::orderSequences(n1.Terms, n2.Terms);
+			} //if ( ret == 0 )
+			if ( ret == 0 && n1.Children.size() != n2.Children.size() ) {
+				ret = n1.Children.size() < n2.Children.size() ? -1 : 1;
+			} //if ( ret == 0 && n1.Children.size() != n2.Children.size() )
+			for ( std::size_t i = 0; ret == 0 && i < n1.Children.size(); ++i ) {
+				ret = order(n1.Children[i], n2.Children[i]);
+			} //for ( std::size_t i = 0; ret == 0 && i < n1.Children.size(); ++i )
+		} //if ( id1 != id2 )
+		if ( ret == 0 && negations1 != negations2 ) {
+			ret = negations1 < negations2 ? -1 : 1;
+		} //if ( ret == 0 && negations1 != negations2 )
+		return ret;
+	}
+	
+	/**
+	 * @brief Applies the algebraic rules of RtFormula::simplified() to the simplified operands of a junction.
+	 *
+	 * Since the nodes are hash-consed, structural equality is a comparison of the ids.
+	 */
+	NodeId simplifiedJunction(const Kind k, const std::vector<NodeId>& operands) {
+		const Kind unit = k == Kind::And ? Kind::True : Kind::False;
+		const Kind zero = k == Kind::And ? Kind::False : Kind::True;
+		const Kind dual = k == Kind::And ? Kind::Or : Kind::And;
+		const auto contains = [&operands](const NodeId id) noexcept {
+				return std::find(operands.begin(), operands.end(), id) != operands.end();
+			};
+		
+		for ( const auto operand : operands ) {
+			const Node& n = Nodes[operand];
+			if ( n.K == zero || (n.K == Kind::Not && contains(n.Children.front())) ) {
+				return constant(zero == Kind::True);
+			} //if ( n.K == zero || (n.K == Kind::Not && contains(n.Children.front())) )
+		} //for ( const auto operand : operands )
+		
+		std::vector<NodeId> kept;
+		for ( auto iter = operands.begin(); iter != operands.end(); ++iter ) {
+			const Node& n = Nodes[*iter];
+			if ( n.K != unit && std::find(operands.begin(), iter, *iter) == iter &&
+			     !(n.K == dual && std::any_of(n.Children.begin(), n.Children.end(), contains)) ) {
+				kept.push_back(*iter);
+			} //if ( n.K != unit && std::find(operands.begin(), iter, *iter) == iter && ... )
+		} //for ( auto iter = operands.begin(); iter != operands.end(); ++iter )
+		
+		if ( kept.empty() ) {
+			return constant(unit == Kind::True);
+		} //if ( kept.empty() )
+		if ( kept.size() == 1 ) {
+			return kept.front();
+		} //if ( kept.size() == 1 )
+		std::sort(kept.begin(), kept.end(), [this](const NodeId id1, const NodeId id2) noexcept {
+				return order(id1, id2) < 0;
+			});
+		return intern({k, std::nullopt, {}, std::move(kept)});
+	}
+	
+	NodeId negationNormalForm(const NodeId id, const bool negated) {
+		if ( const auto cached = cacheEntry(NegationNormalFormCache[negated], id); cached != InvalidNode ) {
+			return cached;
+		} //if ( const auto cached = cacheEntry(NegationNormalFormCache[negated], id); cached != InvalidNode )
+		
+		const Kind k = Nodes[id].K;
+		NodeId ret = id;
+		switch ( k ) {
+			case Kind::Predicate  :
+			case Kind::Equality   : ret = negated ? unary(Kind::Not, std::nullopt, id) : id; break;
+			case Kind::True       :
+			case Kind::False      : ret = negated ? constant(k == Kind::False) : id; break;
+			case Kind::Not        : ret = negationNormalForm(Nodes[id].Children.front(), !negated); break;
+			case Kind::And        :
+			case Kind::Or         : {
+				const Kind target = !negated ? k : k == Kind::And ? Kind::Or : Kind::And;
+				ret = transformed(id, target, negated ? &FormulaDag::negate : &FormulaDag::toNegationNormalForm);
+				break;
+			} //case Kind::And, Kind::Or
+			case Kind::Implies    :
+			case Kind::Equivalent : ret = negationNormalForm(simplified(id), negated); break;
+			case Kind::Exists     :
+			case Kind::ForAll     : {
+				const Kind target = !negated ? k : k == Kind::Exists ? Kind::ForAll : Kind::Exists;
+				const auto child  = negationNormalForm(Nodes[id].Children.front(), negated);
+				ret = unary(target, Nodes[id].N, child);
+				break;
+			} //case Kind::Exists, Kind::ForAll
+		} //switch ( k )
+		
+		cacheEntry(NegationNormalFormCache[negated], id) = ret;
+		return ret;
+	}
+	
+	public:
+	/**
+	 * @brief Returns the id of the node, adding it if no equal node exists.
+	 */
+	NodeId intern(Node node) {
+		for ( const auto child : node.Children ) {
+			if ( child >= Nodes.size() ) {
+				throw std::out_of_range{"Child node does not exist!"};
+			} //if ( child >= Nodes.size() )
+		} //for ( const auto child : node.Children )
+		
+		const auto h = hash(node);
+		for ( auto [iter, end] = Unique.equal_range(h); iter != end; ++iter ) {
+			if ( Nodes[iter->second] == node ) {
+				return iter->second;
+			} //if ( Nodes[iter->second] == node )
+		} //for ( auto [iter, end] = Unique.equal_range(h); iter != end; ++iter )
+		
+		if ( Nodes.size() >= InvalidNode ) {
+			throw std::length_error{"Too many nodes!"};
+		} //if ( Nodes.size() >= InvalidNode )
+		const auto id = static_cast<NodeId>(Nodes.size());
+		Nodes.push_back(std::move(node));
+		Unique.emplace(h, id);
+		return id;
+	}
+	
+	NodeId add(const RtFormula& f) {
+		std::vector<NodeId> children;
+		children.reserve(f.Children.size());
+		for ( const auto& child : f.Children ) {
+			children.push_back(add(child));
+		} //for ( const auto& child : f.Children )
+		return intern({f.K, f.N, f.Terms, std::move(children)});
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	NodeId add(const T& f) {
+		return add(toRuntime(f));
+	}
+	
+	const Node& node(const NodeId id) const {
+		return Nodes.at(id);
+	}
+	
+	std::size_t size(void) const noexcept {
+		return Nodes.size();
+	}
+	
+	/**
+	 * @brief Expands the node into a tree.
+	 */
+	RtFormula toFormula(const NodeId id) const {
+		const Node& n = Nodes.at(id);
+		std::vector<RtFormula> children;
+		children.reserve(n.Children.size());
+		for ( const auto child : n.Children ) {
+			children.push_back(toFormula(child));
+		} //for ( const auto child : n.Children )
+		return {n.K, n.N, n.Terms, std::move(children)};
+	}
+	
+	NodeId simplified(const NodeId id) {
+		if ( const auto cached = cacheEntry(SimplifiedCache, id); cached != InvalidNode ) {
+			return cached;
+		} //if ( const auto cached = cacheEntry(SimplifiedCache, id); cached != InvalidNode )
+		
+		const Kind k = Nodes[id].K;
+		NodeId ret = id;
+		switch ( k ) {
+			case Kind::Predicate  :
+			case Kind::True       :
+			case Kind::False      : break;
+			case Kind::Equality   : {
+				if ( Nodes[id].Terms[0] == Nodes[id].Terms[1] ) {
+					ret = constant(true);
+				} //if ( Nodes[id].Terms[0] == Nodes[id].Terms[1] )
+				break;
+			} //case Kind::Equality
+			case Kind::Not        : {
+				const auto child = Nodes[id].Children.front();
+				if ( Nodes[child].K == Kind::Not ) {
+					ret = simplified(Nodes[child].Children.front());
+					break;
+				} //if ( Nodes[child].K == Kind::Not )
+				
+				const auto inner = simplified(child);
+				const Kind innerKind = Nodes[inner].K;
+				if ( innerKind == Kind::True || innerKind == Kind::False ) {
+					ret = constant(innerKind == Kind::False);
+				} //if ( innerKind == Kind::True || innerKind == Kind::False )
+				else if ( innerKind == Kind::Not ) {
+					ret = Nodes[inner].Children.front();
+				} //else if ( innerKind == Kind::Not )
+				else {
+					ret = unary(Kind::Not, std::nullopt, inner);
+				} //else -> else if ( innerKind == Kind::Not )
+				break;
+			} //case Kind::Not
+			case Kind::And        :
+			case Kind::Or         : ret = simplifiedJunction(k, transformedChildren(id, &FormulaDag::simplified)); break;
+			case Kind::Implies    : {
+				const auto child1 = Nodes[id].Children[0], child2 = Nodes[id].Children[1];
+				ret = simplified(binary(Kind::Or, unary(Kind::Not, std::nullopt, child1), child2));
+				break;
+			} //case Kind::Implies
+			case Kind::Equivalent : {
+				const auto child1 = Nodes[id].Children[0], child2 = Nodes[id].Children[1];
+				const auto left   = simplified(binary(Kind::Implies, child1, child2));
+				const auto right  = simplified(binary(Kind::Implies, child2, child1));
+				ret = simplifiedJunction(Kind::And, {left, right});
+				break;
+			} //case Kind::Equivalent
+			case Kind::Exists     :
+			case Kind::ForAll     : {
+				const auto child = simplified(Nodes[id].Children.front());
+				const Kind childKind = Nodes[child].K;
+				ret = childKind == Kind::True || childKind == Kind::False ? child : unary(k, Nodes[id].N, child);
+				break;
+			} //case Kind::Exists, Kind::ForAll
+		} //switch ( k )
+		
+		cacheEntry(SimplifiedCache, id) = ret;
+		return ret;
+	}
+	
+	NodeId negate(const NodeId id) {
+		return negationNormalForm(id, true);
+	}
+	
+	NodeId toNegationNormalForm(const NodeId id) {
+		return negationNormalForm(id, false);
+	}
+	
+	/**
+	 * @brief Returns the bytes used by the nodes and the unique table, without the heap memory of names.
+	 */
+	std::size_t memoryUsage(void) const noexcept {
+		std::size_t ret = Nodes.capacity() * sizeof(Node) +
+		                  Unique.size() * (sizeof(std::pair<const std::size_t, NodeId>) + 2 * sizeof(void*)) +
+		                  Unique.bucket_count() * sizeof(void*) + SimplifiedCache.capacity() * sizeof(NodeId) +
+		                  (NegationNormalFormCache[0].capacity() + NegationNormalFormCache[1].capacity()) *
+		                  sizeof(NodeId);
+		for ( const auto& n : Nodes ) {
+			ret += n.Terms.capacity() * sizeof(RtTerm) + n.Children.capacity() * sizeof(NodeId);
+		} //for ( const auto& n : Nodes )
+		return ret;
+	}
+};
+
+} //namespace fol
+
+#endif
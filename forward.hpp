@@ -6,6 +6,8 @@
 #ifndef FOL_FORWARD_HPP
 #define FOL_FORWARD_HPP
 
+#include <vector>
+
 namespace fol {
 
 template<char... String>
@@ -27,6 +29,10 @@ struct Predicate;
 template<typename T1, typename T2>
 struct Equality;
 
+struct True;
+
+struct False;
+
 template<typename T>
 struct Not;
 
@@ -36,6 +42,12 @@ struct And;
 template<typename... Ts>
 struct Or;
 
+template<typename T, typename Container = std::vector<T>>
+struct AndN;
+
+template<typename T, typename Container = std::vector<T>>
+struct OrN;
+
 template<typename T1, typename T2>
 struct Implies;
 
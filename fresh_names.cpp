@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks fresh_names.hpp for self-containment.
+ * 
+ */
+
+#include "fresh_names.hpp"
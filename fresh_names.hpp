@@ -0,0 +1,137 @@
+/**
+ * @file
+ * @brief Contains the generator for fresh names, usable from many threads.
+ */
+
+#ifndef FOL_FRESH_NAMES_HPP
+#define FOL_FRESH_NAMES_HPP
+
+#include "name.hpp"
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+namespace fol {
+
+namespace details {
+inline void collectNames(const RtTerm& t, std::unordered_set<std::string>& names) {
+	names.insert(t.Name.string());
+	for ( const auto& arg : t.Args ) {
+		collectNames(arg, names);
+	} //for ( const auto& arg : t.Args )
+	return;
+}
+
+inline void collectNames(const RtFormula& f, std::unordered_set<std::string>& names) {
+	if ( f.N ) {
+		names.insert(f.N->string());
+	} //if ( f.N )
+	for ( const auto& term : f.Terms ) {
+		collectNames(term, names);
+	} //for ( const auto& term : f.Terms )
+	for ( const auto& child : f.Children ) {
+		collectNames(child, names);
+	} //for ( const auto& child : f.Children )
+	return;
+}
+} //namespace details
+
+/**
+ * @brief Hands out unique names from an atomic counter.
+ *
+ * The id n is turned into the n-th name of the sequence "a", "b", ..., "z", "aa", "ab", ..., which is the sequence
+ * RtName::next() walks, prepended by the prefix. Names used in the formulas given to avoid() are skipped. avoid() has
+ * to be called before the generator is shared, afterwards only the counter is written.
+ */
+class FreshNameGenerator {
+	std::string Prefix;
+	std::unordered_set<std::string> Avoid;
+	std::atomic<std::uint64_t> Counter{0};
+	
+	public:
+	/**
+	 * @brief A range of ids reserved for one thread, only touching the shared counter when it is exhausted.
+	 */
+	class Block {
+		FreshNameGenerator *Generator;
+		std::uint64_t Next = 0;
+		std::uint64_t End = 0;
+		std::uint64_t Size;
+		
+		public:
+		Block(FreshNameGenerator& generator, const std::uint64_t size) noexcept : Generator{&generator},
+				Size{std::max<std::uint64_t>(size, 1)} {
+			return;
+		}
+		
+		RtName next(void) {
+			for ( ;; ) {
+				if ( Next == End ) {
+					Next = Generator->Counter.fetch_add(Size, std::memory_order_relaxed);
+					End  = Next + Size;
+				} //if ( Next == End )
+				if ( auto name = Generator->nameOf(Next++); !Generator->Avoid.count(name) ) {
+					return RtName{std::move(name)};
+				} //if ( auto name = Generator->nameOf(Next++); !Generator->Avoid.count(name) )
+			} //for ( ;; )
+		}
+	};
+	
+	explicit FreshNameGenerator(std::string prefix = {}) : Prefix{std::move(prefix)} {
+		return;
+	}
+	
+	void avoid(const RtFormula& f) {
+		details::collectNames(f, Avoid);
+		return;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	void avoid(const T& f) {
+		avoid(toRuntime(f));
+		return;
+	}
+	
+	/**
+	 * @brief Returns the name for the id without reserving it.
+	 */
+	std::string nameOf(std::uint64_t id) const {
+		char buffer[16];
+		char *begin = std::end(buffer);
+		++id;
+		do {
+			--id;
+			*--begin = static_cast<char>('a' + id % 26);
+			id /= 26;
+		} while ( id != 0 );
+		std::string ret;
+		ret.reserve(Prefix.size() + static_cast<std::size_t>(std::end(buffer) - begin));
+		ret.append(Prefix).append(begin, std::end(buffer));
+		return ret;
+	}
+	
+	RtName next(void) {
+		for ( ;; ) {
+			if ( auto name = nameOf(Counter.fetch_add(1, std::memory_order_relaxed)); !Avoid.count(name) ) {
+				return RtName{std::move(name)};
+			} //if ( auto name = nameOf(Counter.fetch_add(1, std::memory_order_relaxed)); !Avoid.count(name) )
+		} //for ( ;; )
+	}
+	
+	Block block(const std::uint64_t size = 1024) noexcept {
+		return {*this, size};
+	}
+};
+
+} //namespace fol
+
+#endif
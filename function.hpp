@@ -8,6 +8,7 @@
 
 #include "helper.hpp"
 #include "name.hpp"
+#include "storage.hpp"
 #include "traits.hpp"
 
 #include <ostream>
@@ -18,7 +19,7 @@
 namespace fol {
 
 template<typename NameT, typename... Args>
-struct Function {
+struct Function : details::StoredN<NameT>, details::StoredA<std::tuple<Args...>> {
 	template<typename Name2, std::size_t... Idx>
 	static constexpr Function<Name2, Args...> fromNameImpl(const Name2& n, const std::tuple<Args...>& t,
 	                                                        std::index_sequence<Idx...>)
@@ -35,8 +36,8 @@ struct Function {
 	static_assert(IsName<NameT>::value, "First template argument must be a name!");
 	static_assert((IsTerm<Args>::value && ...), "All template arguments from the second on have to be terms!");
 	
-	NameT N;
-	std::tuple<Args...> A;
+	using details::StoredN<NameT>::N;
+	using details::StoredA<std::tuple<Args...>>::A;
 	
 	using VariableCount = std::integral_constant<std::size_t, (0 + ... + Args::VariableCount::value)>;
 //	using VariableArray = decltype((ArraySet<0>{} + ... + typename Args::VariableArray{}));
@@ -46,8 +47,9 @@ struct Function {
 	constexpr Function(NameT n, Args... a)
 			noexcept(std::is_nothrow_move_constructible_v<NameT> &&
 			         (std::is_nothrow_move_constructible_v<Args> && ...) &&
-			         noexcept(std::make_tuple(std::move(a)...))) : N{std::move(n)},
-			A{std::make_tuple(std::move(a)...)} {
+			         noexcept(std::make_tuple(std::move(a)...))) :
+			details::StoredN<NameT>{std::move(n)},
+			details::StoredA<std::tuple<Args...>>{std::make_tuple(std::move(a)...)} {
 		return;
 	}
 	
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks grounding.hpp for self-containment.
+ * 
+ */
+
+#include "grounding.hpp"
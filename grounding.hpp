@@ -0,0 +1,554 @@
+/**
+ * @file
+ * @brief Contains the streaming grounding of quantified formulas over a finite domain.
+ */
+
+#ifndef FOL_GROUNDING_HPP
+#define FOL_GROUNDING_HPP
+
+#include "batch.hpp"
+#include "rt_formula.hpp"
+#include "stats.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief Instantiates the quantifiers of a formula with the terms of a finite domain and streams the ground clauses.
+ *
+ * The formula is brought into negation normal form and split at its conjunctions and universal quantifiers into clause
+ * templates, below them only disjunctions, literals, and existential quantifiers are allowed. Every assignment of the
+ * universal variables of a template yields one clause, an existential quantifier becomes the disjunction over the
+ * domain. The assignments are enumerated variable by variable, as soon as a literal which only depends on the bound
+ * variables simplifies to true, all assignments below are skipped. A ground clause is a literal or a disjunction of
+ * literals as accepted by ClauseStore::add(), duplicate literals are removed and tautologies are dropped. An instance
+ * whose literals all simplify to false is the empty clause, which ClauseStore::add() does not accept: it is not given
+ * to the sink but counted in Result::EmptyClauses, the formula is unsatisfiable over the domain if there is one.
+ *
+ * The work items of the threads are the templates times the values of their outermost universal variable. Every thread
+ * buffers a bounded number of clauses and hands them to the sink under a lock, so besides the templates only these
+ * buffers are kept, no matter how many clauses are produced. The order of the clauses is unspecified.
+ */
+class Grounder {
+	public:
+	struct Options {
+		unsigned int Threads        = details::defaultThreadCount();
+		std::size_t BufferedClauses = 1024;
+	};
+	
+	struct Result {
+		std::size_t Clauses = 0;
+		//Complete or partial assignments of the universal variables which were dropped because they are true.
+		std::size_t Pruned  = 0;
+		//Instances whose literals are all false.
+		std::size_t EmptyClauses = 0;
+		
+		bool unsatisfiable(void) const noexcept {
+			return EmptyClauses != 0;
+		}
+	};
+	
+	private:
+	using Kind = RtFormula::Kind;
+	
+	static constexpr std::size_t NoSlot = std::numeric_limits<std::size_t>::max();
+	
+	/**
+	 * @brief A term whose variables are replaced by the slots of their quantifiers.
+	 */
+	struct Pattern {
+		std::size_t Slot;
+		RtName Name;
+		std::vector<Pattern> Args;
+	};
+	
+	/**
+	 * @brief A literal, truth constant, disjunction, or existential quantifier of a clause template.
+	 *
+	 * A quantifier uses Slot for its variable, a literal or constant for the number of universal variables it depends
+	 * on, or NoSlot if it depends on an existential one.
+	 */
+	struct Node {
+		Kind K;
+		bool Negated;
+		std::optional<RtName> N;
+		std::vector<Pattern> Terms;
+		std::vector<Node> Children;
+		std::size_t Slot;
+	};
+	
+	struct Template {
+		std::size_t Universals;
+		std::size_t Slots;
+		Node Body;
+		//Checks[i] are the literals which are known once the first i universal variables are bound.
+		std::vector<std::vector<const Node*>> Checks;
+	};
+	
+	struct Worker {
+		std::vector<std::size_t> Binding;
+		std::vector<RtFormula> Literals;
+		std::vector<RtFormula> Buffer;
+		Result Counts;
+	};
+	
+	std::vector<RtTerm> Domain;
+	Options Opts;
+	
+	static bool isGround(const RtTerm& t) noexcept {
+		return !t.isVariable() && std::all_of(t.Args.begin(), t.Args.end(), &Grounder::isGround);
+	}
+	
+	static Pattern compile(const RtTerm& t, const std::vector<RtName>& scope) {
+		if ( t.isVariable() ) {
+			const auto iter = std::find(scope.rbegin(), scope.rend(), t.Name);
+			if ( iter == scope.rend() ) {
+				throw std::invalid_argument{"Variable " + t.Name.string() + " is not bound by a quantifier!"};
+			} //if ( iter == scope.rend() )
+			return {static_cast<std::size_t>(scope.rend() - iter) - 1, t.Name, {}};
+		} //if ( t.isVariable() )
+		std::vector<Pattern> args;
+		args.reserve(t.Args.size());
+		for ( const auto& arg : t.Args ) {
+			args.push_back(compile(arg, scope));
+		} //for ( const auto& arg : t.Args )
+		return {NoSlot, t.Name, std::move(args)};
+	}
+	
+	static std::size_t dependency(const Pattern& p, const std::size_t universals) noexcept {
+		if ( p.Slot != NoSlot ) {
+			return p.Slot < universals ? p.Slot + 1 : NoSlot;
+		} //if ( p.Slot != NoSlot )
+		std::size_t ret = 0;
+		for ( const auto& arg : p.Args ) {
+			const auto d = dependency(arg, universals);
+			if ( d == NoSlot ) {
+				return NoSlot;
+			} //if ( d == NoSlot )
+			ret = std::max(ret, d);
+		} //for ( const auto& arg : p.Args )
+		return ret;
+	}
+	
+	static Node compileClause(const RtFormula& f, std::vector<RtName>& scope, const std::size_t universals,
+	                          std::size_t& slots) {
+		switch ( f.K ) {
+			case Kind::Predicate  :
+			case Kind::Equality   : {
+				std::vector<Pattern> terms;
+				terms.reserve(f.Terms.size());
+				std::size_t level = 0;
+				for ( const auto& t : f.Terms ) {
+					terms.push_back(compile(t, scope));
+					const auto d = dependency(terms.back(), universals);
+					level = d == NoSlot || level == NoSlot ? NoSlot : std::max(level, d);
+				} //for ( const auto& t : f.Terms )
+				return {f.K, false, f.N, std::move(terms), {}, level};
+			} //case Kind::Predicate, Kind::Equality
+			case Kind::Not        : {
+				auto ret = compileClause(f.Children.front(), scope, universals, slots);
+				ret.Negated = true;
+				return ret;
+			} //case Kind::Not
+			case Kind::True       :
+			case Kind::False      : return {f.K, false, std::nullopt, {}, {}, 0};
+			case Kind::Or         : {
+				std::vector<Node> children;
+				children.reserve(f.Children.size());
+				for ( const auto& child : f.Children ) {
+					children.push_back(compileClause(child, scope, universals, slots));
+				} //for ( const auto& child : f.Children )
+				return {f.K, false, std::nullopt, {}, std::move(children), NoSlot};
+			} //case Kind::Or
+			case Kind::Exists     : {
+				const auto slot = scope.size();
+				scope.push_back(*f.N);
+				slots = std::max(slots, scope.size());
+				std::vector<Node> children;
+				children.push_back(compileClause(f.Children.front(), scope, universals, slots));
+				scope.pop_back();
+				return {f.K, false, std::nullopt, {}, std::move(children), slot};
+			} //case Kind::Exists
+			default               : break;
+		} //switch ( f.K )
+		throw std::invalid_argument{"Formula is not clausal below its universal quantifiers!"};
+	}
+	
+	static void collect(const RtFormula& f, std::vector<RtName>& scope, std::vector<Template>& templates) {
+		switch ( f.K ) {
+			case Kind::True   : return;
+			case Kind::And    : {
+				for ( const auto& child : f.Children ) {
+					collect(child, scope, templates);
+				} //for ( const auto& child : f.Children )
+				return;
+			} //case Kind::And
+			case Kind::ForAll : {
+				scope.push_back(*f.N);
+				collect(f.Children.front(), scope, templates);
+				scope.pop_back();
+				return;
+			} //case Kind::ForAll
+			default           : break;
+		} //switch ( f.K )
+		const auto universals = scope.size();
+		auto slots            = universals;
+		auto body             = compileClause(f, scope, universals, slots);
+		templates.push_back({universals, slots, std::move(body), {}});
+		return;
+	}
+	
+	static void addChecks(const Node& node, std::vector<std::vector<const Node*>>& checks) {
+		if ( node.K == Kind::Or ) {
+			for ( const auto& child : node.Children ) {
+				addChecks(child, checks);
+			} //for ( const auto& child : node.Children )
+		} //if ( node.K == Kind::Or )
+		else if ( node.K != Kind::Exists && node.K != Kind::False && node.Slot != NoSlot ) {
+			checks[node.Slot].push_back(&node);
+		} //else if ( node.K != Kind::Exists && node.K != Kind::False && node.Slot != NoSlot )
+		return;
+	}
+	
+	bool matches(const Pattern& p, const RtTerm& t, const std::vector<std::size_t>& binding) const noexcept {
+		if ( p.Slot != NoSlot ) {
+			return Domain[binding[p.Slot]] == t;
+		} //if ( p.Slot != NoSlot )
+		if ( p.Name != t.Name || p.Args.size() != t.Args.size() || t.isVariable() ) {
+			return false;
+		} //if ( p.Name != t.Name || p.Args.size() != t.Args.size() || t.isVariable() )
+		for ( std::size_t i = 0; i < p.Args.size(); ++i ) {
+			if ( !matches(p.Args[i], t.Args[i], binding) ) {
+				return false;
+			} //if ( !matches(p.Args[i], t.Args[i], binding) )
+		} //for ( std::size_t i = 0; i < p.Args.size(); ++i )
+		return true;
+	}
+	
+	bool same(const Pattern& p1, const Pattern& p2, const std::vector<std::size_t>& binding) const noexcept {
+		if ( p1.Slot != NoSlot ) {
+			//The domain has no duplicates.
+			return p2.Slot != NoSlot ? binding[p1.Slot] == binding[p2.Slot] : matches(p2, Domain[binding[p1.Slot]],
+			                                                                          binding);
+		} //if ( p1.Slot != NoSlot )
+		if ( p2.Slot != NoSlot ) {
+			return matches(p1, Domain[binding[p2.Slot]], binding);
+		} //if ( p2.Slot != NoSlot )
+		if ( p1.Name != p2.Name || p1.Args.size() != p2.Args.size() ) {
+			return false;
+		} //if ( p1.Name != p2.Name || p1.Args.size() != p2.Args.size() )
+		for ( std::size_t i = 0; i < p1.Args.size(); ++i ) {
+			if ( !same(p1.Args[i], p2.Args[i], binding) ) {
+				return false;
+			} //if ( !same(p1.Args[i], p2.Args[i], binding) )
+		} //for ( std::size_t i = 0; i < p1.Args.size(); ++i )
+		return true;
+	}
+	
+	/**
+	 * @brief Returns true if one of the checked literals simplifies to true under the binding.
+	 */
+	bool prunes(const std::vector<const Node*>& checks, const std::vector<std::size_t>& binding) const noexcept {
+		return std::any_of(checks.begin(), checks.end(), [this, &binding](const Node *node) noexcept {
+				return node->K == Kind::True ||
+				       (node->K == Kind::Equality && !node->Negated && same(node->Terms[0], node->Terms[1], binding));
+			});
+	}
+	
+	RtTerm instantiate(const Pattern& p, const std::vector<std::size_t>& binding) const {
+		if ( p.Slot != NoSlot ) {
+			return Domain[binding[p.Slot]];
+		} //if ( p.Slot != NoSlot )
+		std::vector<RtTerm> args;
+		args.reserve(p.Args.size());
+		for ( const auto& arg : p.Args ) {
+			args.push_back(instantiate(arg, binding));
+		} //for ( const auto& arg : p.Args )
+		return {p.Name, std::move(args)};
+	}
+	
+	/**
+	 * @brief Appends the ground literals of the node, returns true as soon as one of them is true.
+	 */
+	bool expand(const Node& node, Worker& worker) const {
+		switch ( node.K ) {
+			case Kind::True      : return true;
+			case Kind::False     : return false;
+			case Kind::Or        : {
+				for ( const auto& child : node.Children ) {
+					if ( expand(child, worker) ) {
+						return true;
+					} //if ( expand(child, worker) )
+				} //for ( const auto& child : node.Children )
+				return false;
+			} //case Kind::Or
+			case Kind::Exists    : {
+				for ( std::size_t value = 0; value < Domain.size(); ++value ) {
+					worker.Binding[node.Slot] = value;
+					if ( expand(node.Children.front(), worker) ) {
+						return true;
+					} //if ( expand(node.Children.front(), worker) )
+				} //for ( std::size_t value = 0; value < Domain.size(); ++value )
+				return false;
+			} //case Kind::Exists
+			case Kind::Equality  : {
+				if ( same(node.Terms[0], node.Terms[1], worker.Binding) ) {
+					return !node.Negated;
+				} //if ( same(node.Terms[0], node.Terms[1], worker.Binding) )
+				auto atom = RtFormula::equality(instantiate(node.Terms[0], worker.Binding),
+				                                instantiate(node.Terms[1], worker.Binding));
+				worker.Literals.push_back(node.Negated ? RtFormula::negation(std::move(atom)) : std::move(atom));
+				return false;
+			} //case Kind::Equality
+			default              : {
+				std::vector<RtTerm> args;
+				args.reserve(node.Terms.size());
+				for ( const auto& t : node.Terms ) {
+					args.push_back(instantiate(t, worker.Binding));
+				} //for ( const auto& t : node.Terms )
+				auto atom = RtFormula::predicate(*node.N, std::move(args));
+				worker.Literals.push_back(node.Negated ? RtFormula::negation(std::move(atom)) : std::move(atom));
+				return false;
+			} //default
+		} //switch ( node.K )
+	}
+	
+	/**
+	 * @brief Builds the clause of the non-empty literals, without duplicates, or nothing if it contains complementary
+	 * literals.
+	 *
+	 * The literals are sorted by the hash of their atom, so only literals with the same hash are compared.
+	 */
+	static std::optional<RtFormula> clauseOf(std::vector<RtFormula>& literals) {
+		const auto atomOf = [](const RtFormula& literal) noexcept -> const RtFormula& {
+				return literal.K == Kind::Not ? literal.Children.front() : literal;
+			};
+		std::vector<std::pair<std::size_t, std::size_t>> order;
+		order.reserve(literals.size());
+		for ( std::size_t i = 0; i < literals.size(); ++i ) {
+			order.emplace_back(std::hash<RtFormula>{}(atomOf(literals[i])), i);
+		} //for ( std::size_t i = 0; i < literals.size(); ++i )
+		std::sort(order.begin(), order.end());
+		
+		std::vector<bool> keep(literals.size(), true);
+		for ( std::size_t first = 0, last = 0; first < order.size(); first = last ) {
+			while ( last < order.size() && order[last].first == order[first].first ) {
+				++last;
+			} //while ( last < order.size() && order[last].first == order[first].first )
+			for ( auto i = first; i < last; ++i ) {
+				const auto& literal = literals[order[i].second];
+				for ( auto j = i + 1; j < last && keep[order[i].second]; ++j ) {
+					const auto& other = literals[order[j].second];
+					if ( keep[order[j].second] && atomOf(literal) == atomOf(other) ) {
+						if ( literal.K != other.K ) {
+							return std::nullopt;
+						} //if ( literal.K != other.K )
+						keep[order[j].second] = false;
+					} //if ( keep[order[j].second] && atomOf(literal) == atomOf(other) )
+				} //for ( auto j = i + 1; j < last && keep[order[i].second]; ++j )
+			} //for ( auto i = first; i < last; ++i )
+		} //for ( std::size_t first = 0, last = 0; first < order.size(); first = last )
+		
+		std::vector<RtFormula> kept;
+		for ( std::size_t i = 0; i < literals.size(); ++i ) {
+			if ( keep[i] ) {
+				kept.push_back(std::move(literals[i]));
+			} //if ( keep[i] )
+		} //for ( std::size_t i = 0; i < literals.size(); ++i )
+		if ( kept.size() == 1 ) {
+			return std::move(kept.front());
+		} //if ( kept.size() == 1 )
+		return RtFormula::disjunction(std::move(kept));
+	}
+	
+	template<typename Flush>
+	void emit(const Template& t, Worker& worker, Flush& flush) const {
+		worker.Literals.clear();
+		std::optional<RtFormula> clause;
+		if ( !expand(t.Body, worker) ) {
+			if ( worker.Literals.empty() ) {
+				++worker.Counts.EmptyClauses;
+				return;
+			} //if ( worker.Literals.empty() )
+			clause = clauseOf(worker.Literals);
+		} //if ( !expand(t.Body, worker) )
+		if ( !clause ) {
+			++worker.Counts.Pruned;
+			return;
+		} //if ( !clause )
+		worker.Buffer.push_back(std::move(*clause));
+		++worker.Counts.Clauses;
+		if ( worker.Buffer.size() >= Opts.BufferedClauses ) {
+			flush(worker);
+		} //if ( worker.Buffer.size() >= Opts.BufferedClauses )
+		return;
+	}
+	
+	/**
+	 * @brief Enumerates the values of the universal variables from level on.
+	 */
+	template<typename Flush>
+	void enumerate(const Template& t, const std::size_t level, Worker& worker, Flush& flush) const {
+		if ( level == t.Universals ) {
+			emit(t, worker, flush);
+			return;
+		} //if ( level == t.Universals )
+		for ( std::size_t value = 0; value < Domain.size(); ++value ) {
+			worker.Binding[level] = value;
+			if ( prunes(t.Checks[level + 1], worker.Binding) ) {
+				++worker.Counts.Pruned;
+			} //if ( prunes(t.Checks[level + 1], worker.Binding) )
+			else {
+				enumerate(t, level + 1, worker, flush);
+			} //else -> if ( prunes(t.Checks[level + 1], worker.Binding) )
+		} //for ( std::size_t value = 0; value < Domain.size(); ++value )
+		return;
+	}
+	
+	public:
+	/**
+	 * @brief Creates a grounder over the given ground terms, duplicates are removed.
+	 */
+	Grounder(std::vector<RtTerm> domain, const Options options) : Opts{options} {
+		std::unordered_set<RtTerm> seen;
+		Domain.reserve(domain.size());
+		for ( auto& t : domain ) {
+			if ( !isGround(t) ) {
+				throw std::invalid_argument{"The domain may only contain ground terms!"};
+			} //if ( !isGround(t) )
+			if ( seen.insert(t).second ) {
+				Domain.push_back(std::move(t));
+			} //if ( seen.insert(t).second )
+		} //for ( auto& t : domain )
+		Opts.BufferedClauses = std::max<std::size_t>(Opts.BufferedClauses, 1);
+		return;
+	}
+	
+	explicit Grounder(std::vector<RtTerm> domain) : Grounder{std::move(domain), Options{}} {
+		return;
+	}
+	
+	const std::vector<RtTerm>& domain(void) const noexcept {
+		return Domain;
+	}
+	
+	/**
+	 * @brief Grounds the closed formula f and calls sink with every ground clause as an RtFormula.
+	 *
+	 * The sink is called from the worker threads, but never concurrently. The first exception thrown by the sink is
+	 * rethrown after all threads have finished. The statistics collector of the calling thread is installed in the
+	 * worker threads.
+	 */
+	template<typename Sink>
+	Result ground(const RtFormula& f, Sink sink) const {
+		std::vector<Template> templates;
+		std::vector<RtName> scope;
+		collect(f.toNegationNormalForm(), scope, templates);
+		
+		std::vector<std::size_t> firstItem{0};
+		firstItem.reserve(templates.size() + 1);
+		for ( auto& t : templates ) {
+			t.Checks.resize(t.Universals + 1);
+			addChecks(t.Body, t.Checks);
+			firstItem.push_back(firstItem.back() + (t.Universals == 0 ? 1 : Domain.size()));
+		} //for ( auto& t : templates )
+		const std::size_t itemCount = firstItem.back();
+		const auto threads = static_cast<unsigned int>(std::min<std::size_t>(std::max(Opts.Threads, 1u),
+		                                                                     std::max<std::size_t>(itemCount, 1)));
+		
+		std::atomic<std::size_t> nextItem{0};
+		std::mutex sinkMutex;
+		std::exception_ptr error;
+		Result ret;
+		stats::Collector *const collector = stats::current();
+		
+		const auto flush = [&sink, &sinkMutex](Worker& worker) {
+				std::lock_guard lock{sinkMutex};
+				for ( auto& clause : worker.Buffer ) {
+					sink(std::move(clause));
+				} //for ( auto& clause : worker.Buffer )
+				worker.Buffer.clear();
+				return;
+			};
+		
+		auto work = [&](void) {
+				const stats::Install install{collector};
+				Worker worker;
+				worker.Buffer.reserve(Opts.BufferedClauses);
+				try {
+					for ( auto item = nextItem++; item < itemCount; item = nextItem++ ) {
+						const auto index = static_cast<std::size_t>(std::upper_bound(firstItem.begin(), firstItem.end(),
+						                                                             item) - firstItem.begin()) - 1;
+						const auto& t = templates[index];
+						worker.Binding.assign(t.Slots, 0);
+						if ( prunes(t.Checks[0], worker.Binding) ) {
+							++worker.Counts.Pruned;
+							continue;
+						} //if ( prunes(t.Checks[0], worker.Binding) )
+						if ( t.Universals == 0 ) {
+							emit(t, worker, flush);
+							continue;
+						} //if ( t.Universals == 0 )
+						worker.Binding[0] = item - firstItem[index];
+						if ( prunes(t.Checks[1], worker.Binding) ) {
+							++worker.Counts.Pruned;
+							continue;
+						} //if ( prunes(t.Checks[1], worker.Binding) )
+						enumerate(t, 1, worker, flush);
+					} //for ( auto item = nextItem++; item < itemCount; item = nextItem++ )
+					flush(worker);
+				} //try
+				catch ( ... ) {
+					nextItem = itemCount;
+					std::lock_guard lock{sinkMutex};
+					if ( !error ) {
+						error = std::current_exception();
+					} //if ( !error )
+				} //catch ( ... )
+				std::lock_guard lock{sinkMutex};
+				ret.Clauses      += worker.Counts.Clauses;
+				ret.Pruned       += worker.Counts.Pruned;
+				ret.EmptyClauses += worker.Counts.EmptyClauses;
+				return;
+			};
+		
+		std::vector<std::thread> pool;
+		pool.reserve(threads - 1);
+		for ( unsigned int i = 1; i < threads; ++i ) {
+			pool.emplace_back(work);
+		} //for ( unsigned int i = 1; i < threads; ++i )
+		work();
+		for ( auto& thread : pool ) {
+			thread.join();
+		} //for ( auto& thread : pool )
+		
+		if ( error ) {
+			std::rethrow_exception(error);
+		} //if ( error )
+		return ret;
+	}
+	
+	template<typename T, typename Sink, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	Result ground(const T& f, Sink sink) const {
+		return ground(toRuntime(f), std::move(sink));
+	}
+};
+
+} //namespace fol
+
+#endif
@@ -7,11 +7,14 @@
 #define FOL_HELPER_HPP
 
 #include "not.hpp"
+#include "order.hpp"
 #include "pretty_printer.hpp"
 #include "traits.hpp"
+#include "truth.hpp"
 
 #include <ostream>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace fol {
@@ -100,7 +103,78 @@ constexpr auto toNegationNormalFormTuple(const std::tuple<Ts...>& t) {
 	return toNegationNormalFormTupleImpl(t, std::index_sequence_for<Ts...>());
 }
 
-} //namespace details
+/**
+ * @brief Whether T is static and one of Ts, i.e. the values are known to be equal.
+ */
+template<typename T, typename... Ts>
+constexpr bool containsStatic(void) noexcept {
+	return IsStatic<T>::value && (std::is_same_v<T, Ts> || ...);
+}
+
+template<template<typename...> class Dual, typename T, typename... Ts>
+struct IsAbsorbed : std::false_type { };
+
+template<template<typename...> class Dual, typename... Vs, typename... Ts>
+struct IsAbsorbed<Dual, Dual<Vs...>, Ts...> : std::bool_constant<(containsStatic<Vs, Ts...>() || ...)> { };
+
+template<typename Tuple, std::size_t I, std::size_t... Js>
+constexpr bool isStaticDuplicate(const std::index_sequence<Js...>) noexcept {
+	return containsStatic<std::tuple_element_t<I, Tuple>, std::tuple_element_t<Js, Tuple>...>();
+}
+
+template<typename Unit, template<typename...> class Dual, std::size_t I, typename... Ts>
+constexpr bool keepOperand(void) noexcept {
+	using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+	return !std::is_same_v<T, Unit> && !IsAbsorbed<Dual, T, Ts...>::value &&
+	       !isStaticDuplicate<std::tuple<Ts...>, I>(std::make_index_sequence<I>());
+}
+
+template<bool Keep, typename T>
+constexpr auto keptOperand(const T& t) {
+	if constexpr ( Keep ) {
+		return std::tuple<T>{t};
+	} //if constexpr ( Keep )
+	else {
+		return std::tuple<>{};
+	} //else -> if constexpr ( Keep )
+}
+
+template<typename Unit, template<typename...> class Dual, typename... Ts, std::size_t... Is>
+constexpr auto keptOperands(const std::tuple<Ts...>& t, const std::index_sequence<Is...>) {
+	return std::tuple_cat(keptOperand<keepOperand<Unit, Dual, Is, Ts...>()>(std::get<Is>(t))...);
+}
+
+/**
+ * @brief Applies the algebraic rules to the already simplified operands of a conjunction or disjunction.
+ *
+ * Unit is the neutral element (True for And), Zero the absorbing one and Dual the other junction. The result is Zero
+ * if it is an operand or an operand and its negation are both present, otherwise units, absorbed dual junctions and
+ * duplicates are dropped. Only static operands are compared, since only their types tell their values apart. The kept
+ * operands are put in canonical order, so commuted junctions simplify to the same type.
+ */
+template<template<typename...> class Junction, typename Unit, typename Zero, template<typename...> class Dual,
+         typename... Ts>
+constexpr auto simplifyJunction(const std::tuple<Ts...>& t) {
+	if constexpr ( (std::is_same_v<Ts, Zero> || ...) || (containsStatic<Not<Ts>, Ts...>() || ...) ) {
+		return Zero{};
+	} //if constexpr ( (std::is_same_v<Ts, Zero> || ...) || (containsStatic<Not<Ts>, Ts...>() || ...) )
+	else {
+		auto kept = keptOperands<Unit, Dual>(t, std::index_sequence_for<Ts...>());
+		constexpr auto size = std::tuple_size_v<decltype(kept)>;
+		if constexpr ( size == 0 ) {
+			return Unit{};
+		} //if constexpr ( size == 0 )
+		else if constexpr ( size == 1 ) {
+			return std::get<0>(kept);
+		} //else if constexpr ( size == 1 )
+		else {
+			return std::apply([](auto... operands) { return Junction<decltype(operands)...>{std::move(operands)...}; },
+			                  canonicalTuple(kept));
+		} //else -> if constexpr ( size == 1 )
+	} //else -> if constexpr ( (std::is_same_v<Ts, Zero> || ...) || (containsStatic<Not<Ts>, Ts...>() || ...) )
+}
+
+} //namespace details
 
 template<typename T>
 std::ostream& operator<<(std::ostream& os, const std::tuple<T>& t) {
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks herbrand.hpp for self-containment.
+ * 
+ */
+
+#include "herbrand.hpp"
@@ -0,0 +1,253 @@
+/**
+ * @file
+ * @brief Contains the lazy enumeration of the Herbrand universe of a formula.
+ */
+
+#ifndef FOL_HERBRAND_HPP
+#define FOL_HERBRAND_HPP
+
+#include "fresh_names.hpp"
+#include "rt_formula.hpp"
+#include "traits.hpp"
+#include "visit.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief Enumerates the ground terms over the function symbols of a formula, ordered by depth.
+ *
+ * All terms of depth d are yielded before the first one of depth d+1, so every term is reached after finitely many
+ * steps. If the formula has no constant a fresh one is added. A yielded term is an id, its arguments are ids of earlier
+ * terms, so every subterm is stored once and shared by all terms containing it. Besides the yielded terms only the
+ * position in the current level is kept, the argument tuples are walked with an odometer and never materialized.
+ */
+class HerbrandEnumerator {
+	public:
+	using TermId = std::uint32_t;
+	
+	struct Options {
+		std::size_t MaxDepth = std::numeric_limits<std::size_t>::max();
+		std::size_t MaxCount = std::numeric_limits<std::size_t>::max();
+	};
+	
+	private:
+	struct Symbol {
+		RtName Name;
+		std::size_t Arity;
+	};
+	
+	struct Term {
+		std::uint32_t Symbol;
+		std::uint32_t Depth;
+		std::size_t Arguments;
+	};
+	
+	std::vector<Symbol> Symbols;
+	std::vector<Term> Terms;
+	std::vector<TermId> Arguments;
+	Options Opts;
+	
+	//The terms [PreviousStart, PreviousEnd) are the previous level, the ones before it are shallower.
+	std::uint32_t Depth             = 0;
+	TermId PreviousStart            = 0;
+	TermId PreviousEnd              = 0;
+	std::size_t CurrentSymbol       = 0;
+	std::size_t Pivot               = 0;
+	std::vector<TermId> Odometer;
+	bool ProducedInLevel            = false;
+	bool Exhausted                  = false;
+	std::size_t Yielded             = 0;
+	
+	static std::vector<Symbol> symbolsOf(const RtFormula& f) {
+		std::vector<Symbol> ret;
+		std::unordered_map<RtName, std::size_t> arities;
+		visit(f, [&ret, &arities](const auto& node) {
+				if constexpr ( std::is_same_v<std::decay_t<decltype(node)>, RtTerm> ) {
+					if ( node.isVariable() ) {
+						return true;
+					} //if ( node.isVariable() )
+					const auto [iter, inserted] = arities.emplace(node.Name, node.Args.size());
+					if ( inserted ) {
+						ret.push_back({node.Name, node.Args.size()});
+					} //if ( inserted )
+					else if ( iter->second != node.Args.size() ) {
+						throw std::invalid_argument{"Function " + node.Name.string() + " has different arities!"};
+					} //else if ( iter->second != node.Args.size() )
+				} //if constexpr ( std::is_same_v<std::decay_t<decltype(node)>, RtTerm> )
+				return true;
+			});
+		return ret;
+	}
+	
+	TermId add(const std::size_t symbol, const TermId *arguments) {
+		if ( Terms.size() >= std::numeric_limits<TermId>::max() ) {
+			throw std::length_error{"Too many ground terms!"};
+		} //if ( Terms.size() >= std::numeric_limits<TermId>::max() )
+		Terms.push_back({static_cast<std::uint32_t>(symbol), Depth, Arguments.size()});
+		Arguments.insert(Arguments.end(), arguments, arguments + Symbols[symbol].Arity);
+		return static_cast<TermId>(Terms.size() - 1);
+	}
+	
+	/**
+	 * @brief Sets the odometer to the first tuple for the current symbol and pivot.
+	 *
+	 * The pivot is the first argument from the previous level, the arguments before it are shallower and the ones
+	 * after it arbitrary, so every tuple with an argument of the previous level is visited exactly once.
+	 */
+	bool resetOdometer(void) {
+		const auto arity = Symbols[CurrentSymbol].Arity;
+		if ( Pivot >= arity || (Pivot > 0 && PreviousStart == 0) ) {
+			return false;
+		} //if ( Pivot >= arity || (Pivot > 0 && PreviousStart == 0) )
+		Odometer.assign(arity, 0);
+		Odometer[Pivot] = PreviousStart;
+		return true;
+	}
+	
+	/**
+	 * @brief Advances the odometer, returns false if the tuples of the current pivot are done.
+	 */
+	bool advanceOdometer(void) {
+		for ( std::size_t i = Odometer.size(); i-- > 0; ) {
+			const TermId begin = i == Pivot ? PreviousStart : 0;
+			const TermId end   = i < Pivot ? PreviousStart : PreviousEnd;
+			if ( ++Odometer[i] < end ) {
+				return true;
+			} //if ( ++Odometer[i] < end )
+			Odometer[i] = begin;
+		} //for ( std::size_t i = Odometer.size(); i-- > 0; )
+		return false;
+	}
+	
+	/**
+	 * @brief Moves to the next symbol and pivot with tuples, or to the next level.
+	 */
+	bool nextPosition(void) {
+		for ( ;; ) {
+			++Pivot;
+			while ( CurrentSymbol < Symbols.size() && !resetOdometer() ) {
+				++CurrentSymbol;
+				Pivot = 0;
+			} //while ( CurrentSymbol < Symbols.size() && !resetOdometer() )
+			if ( CurrentSymbol < Symbols.size() ) {
+				return true;
+			} //if ( CurrentSymbol < Symbols.size() )
+			
+			if ( !ProducedInLevel || Depth >= Opts.MaxDepth ) {
+				return false;
+			} //if ( !ProducedInLevel || Depth >= Opts.MaxDepth )
+			PreviousStart   = PreviousEnd;
+			PreviousEnd     = static_cast<TermId>(Terms.size());
+			ProducedInLevel = false;
+			CurrentSymbol   = 0;
+			Pivot           = std::numeric_limits<std::size_t>::max();
+			++Depth;
+		} //for ( ;; )
+	}
+	
+	public:
+	HerbrandEnumerator(const RtFormula& f, const Options options) : Symbols{symbolsOf(f)}, Opts{options} {
+		const auto isConstant = [](const Symbol& s) noexcept { return s.Arity == 0; };
+		if ( std::none_of(Symbols.begin(), Symbols.end(), isConstant) ) {
+			FreshNameGenerator names{"c"};
+			names.avoid(f);
+			Symbols.insert(Symbols.begin(), {names.next(), 0});
+		} //if ( std::none_of(Symbols.begin(), Symbols.end(), isConstant) )
+		
+		//Depth 0 are the constants, the previous level starts empty so only they have tuples.
+		for ( std::size_t symbol = 0; symbol < Symbols.size() && Terms.size() < Opts.MaxCount; ++symbol ) {
+			if ( Symbols[symbol].Arity == 0 ) {
+				add(symbol, nullptr);
+			} //if ( Symbols[symbol].Arity == 0 )
+		} //for ( std::size_t symbol = 0; symbol < Symbols.size() && Terms.size() < Opts.MaxCount; ++symbol )
+		ProducedInLevel = true;
+		Pivot           = std::numeric_limits<std::size_t>::max();
+		CurrentSymbol   = Symbols.size();
+		Exhausted       = !nextPosition();
+		return;
+	}
+	
+	explicit HerbrandEnumerator(const RtFormula& f) : HerbrandEnumerator{f, Options{}} {
+		return;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	HerbrandEnumerator(const T& f, const Options options) : HerbrandEnumerator{toRuntime(f), options} {
+		return;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	explicit HerbrandEnumerator(const T& f) : HerbrandEnumerator{toRuntime(f), Options{}} {
+		return;
+	}
+	
+	/**
+	 * @brief Returns the next ground term, or nothing once a bound is reached or the universe is finite and complete.
+	 *
+	 * The constants are already enumerated on construction and returned first.
+	 */
+	std::optional<TermId> next(void) {
+		if ( Yielded < Terms.size() ) {
+			return Yielded++;
+		} //if ( Yielded < Terms.size() )
+		if ( Exhausted || Terms.size() >= Opts.MaxCount ) {
+			return std::nullopt;
+		} //if ( Exhausted || Terms.size() >= Opts.MaxCount )
+		
+		const auto ret  = add(CurrentSymbol, Odometer.data());
+		ProducedInLevel = true;
+		if ( !advanceOdometer() ) {
+			Exhausted = !nextPosition();
+		} //if ( !advanceOdometer() )
+		++Yielded;
+		return ret;
+	}
+	
+	std::size_t depth(const TermId id) const {
+		return Terms.at(id).Depth;
+	}
+	
+	const RtName& symbol(const TermId id) const {
+		return Symbols[Terms.at(id).Symbol].Name;
+	}
+	
+	std::pair<const TermId*, const TermId*> arguments(const TermId id) const {
+		const auto& term = Terms.at(id);
+		const auto *begin = Arguments.data() + term.Arguments;
+		return {begin, begin + Symbols[term.Symbol].Arity};
+	}
+	
+	/**
+	 * @brief Expands the term into a tree.
+	 */
+	RtTerm term(const TermId id) const {
+		const auto [begin, end] = arguments(id);
+		std::vector<RtTerm> args;
+		args.reserve(static_cast<std::size_t>(end - begin));
+		for ( auto iter = begin; iter != end; ++iter ) {
+			args.push_back(term(*iter));
+		} //for ( auto iter = begin; iter != end; ++iter )
+		return {symbol(id), std::move(args)};
+	}
+	
+	/**
+	 * @brief Returns the number of stored terms.
+	 */
+	std::size_t size(void) const noexcept {
+		return Terms.size();
+	}
+};
+
+} //namespace fol
+
+#endif
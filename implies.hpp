@@ -9,6 +9,7 @@
 #include "not.hpp"
 #include "or.hpp"
 #include "pretty_printer.hpp"
+#include "storage.hpp"
 #include "traits.hpp"
 
 #include <ostream>
@@ -16,10 +17,10 @@
 namespace fol {
 
 template<typename T1, typename T2>
-struct Implies {
+struct Implies : details::StoredT1<T1>, details::StoredT2<T2> {
 	static_assert(IsFormula<T1>::value && IsFormula<T2>::value, "Both parameters have to be formulas!");
-	T1 t1;
-	T2 t2;
+	using details::StoredT1<T1>::t1;
+	using details::StoredT2<T2>::t2;
 	
 	using VariableCount = std::integral_constant<std::size_t, T1::VariableCount::value + T2::VariableCount::value>;
 //	using VariableArray = decltype(ArraySet<0>{} + typename T1::VariableArray{} + typename T1::VariableArray{});
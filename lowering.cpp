@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks lowering.hpp for self-containment.
+ * 
+ */
+
+#include "lowering.hpp"
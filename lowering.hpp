@@ -0,0 +1,330 @@
+/**
+ * @file
+ * @brief Contains the lowering of static formulas to flat node arrays and the arena they are instantiated in.
+ */
+
+#ifndef FOL_LOWERING_HPP
+#define FOL_LOWERING_HPP
+
+#include "serialization.hpp"
+#include "traits.hpp"
+#include "visit.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief Interns symbols to dense ids, the ids stay valid for the lifetime of the table.
+ */
+class SymbolTable {
+	mutable std::mutex Mutex;
+	std::deque<std::string> Names;
+	std::unordered_map<std::string_view, std::uint32_t> Ids;
+	
+	public:
+	std::uint32_t intern(const std::string_view name) {
+		std::lock_guard lock{Mutex};
+		if ( const auto iter = Ids.find(name); iter != Ids.end() ) {
+			return iter->second;
+		} //if ( const auto iter = Ids.find(name); iter != Ids.end() )
+		if ( Names.size() >= binary::NoSymbol ) {
+			throw std::length_error{"Too many symbols!"};
+		} //if ( Names.size() >= binary::NoSymbol )
+		const auto id = static_cast<std::uint32_t>(Names.size());
+		Ids.emplace(Names.emplace_back(name), id);
+		return id;
+	}
+	
+	std::string_view name(const std::uint32_t id) const {
+		std::lock_guard lock{Mutex};
+		return Names.at(id);
+	}
+	
+	std::size_t size(void) const noexcept {
+		std::lock_guard lock{Mutex};
+		return Names.size();
+	}
+	
+	/**
+	 * @brief The table the lowered static formulas are resolved against.
+	 */
+	static SymbolTable& global(void) {
+		static SymbolTable table;
+		return table;
+	}
+};
+
+namespace details {
+template<char... String>
+struct NameChars {
+	static constexpr char Value[] = {String...};
+};
+
+template<char... String>
+constexpr std::string_view nameView(const Name<String...>) noexcept {
+	return {NameChars<String...>::Value, sizeof...(String)};
+}
+
+template<char... String>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const Variable<String...>& v) noexcept {
+	return {binary::NodeKind::Variable, nameView(v.N)};
+}
+
+template<typename NameT, typename... Args>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const Function<NameT, Args...>& f) noexcept {
+	return {binary::NodeKind::Function, nameView(f.N)};
+}
+
+template<typename NameT, typename... Args>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const Predicate<NameT, Args...>& p) noexcept {
+	return {binary::NodeKind::Predicate, nameView(p.N)};
+}
+
+template<typename T1, typename T2>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const Equality<T1, T2>&) noexcept {
+	return {binary::NodeKind::Equality, {}};
+}
+
+template<typename T>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const Not<T>&) noexcept {
+	return {binary::NodeKind::Not, {}};
+}
+
+template<typename... Ts>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const And<Ts...>&) noexcept {
+	return {binary::NodeKind::And, {}};
+}
+
+template<typename... Ts>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const Or<Ts...>&) noexcept {
+	return {binary::NodeKind::Or, {}};
+}
+
+template<typename T1, typename T2>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const Implies<T1, T2>&) noexcept {
+	return {binary::NodeKind::Implies, {}};
+}
+
+template<typename T1, typename T2>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const Equivalent<T1, T2>&) noexcept {
+	return {binary::NodeKind::Equivalent, {}};
+}
+
+template<typename Var, typename Form>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const Exists<Var, Form>& e) noexcept {
+	return {binary::NodeKind::Exists, nameView(e.V.N)};
+}
+
+template<typename Var, typename Form>
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const ForAll<Var, Form>& f) noexcept {
+	return {binary::NodeKind::ForAll, nameView(f.V.N)};
+}
+
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const True&) noexcept {
+	return {binary::NodeKind::True, {}};
+}
+
+constexpr std::pair<binary::NodeKind, std::string_view> lowered(const False&) noexcept {
+	return {binary::NodeKind::False, {}};
+}
+
+template<std::size_t NodeCount>
+struct LoweringBuilder {
+	std::array<binary::Node, NodeCount> Nodes{};
+	std::array<std::string_view, NodeCount> Symbols{};
+	std::uint32_t NodeIndex   = 0;
+	std::uint32_t SymbolCount = 0;
+	
+	constexpr std::uint32_t symbol(const std::string_view name) noexcept {
+		if ( name.empty() ) {
+			return binary::NoSymbol;
+		} //if ( name.empty() )
+		for ( std::uint32_t id = 0; id < SymbolCount; ++id ) {
+			if ( Symbols[id] == name ) {
+				return id;
+			} //if ( Symbols[id] == name )
+		} //for ( std::uint32_t id = 0; id < SymbolCount; ++id )
+		Symbols[SymbolCount] = name;
+		return SymbolCount++;
+	}
+	
+	template<typename T>
+	constexpr void add(const T& node) noexcept {
+		const auto index         = NodeIndex++;
+		const auto [kind, name]  = lowered(node);
+		const auto& nodeChildren = children(node);
+		Nodes[index] = {kind, symbol(name),
+		                static_cast<std::uint32_t>(std::tuple_size_v<std::decay_t<decltype(nodeChildren)>>), 0};
+		std::apply([this](const auto&... child) { (add(child), ...); }, nodeChildren);
+		Nodes[index].End = NodeIndex;
+		return;
+	}
+};
+
+/**
+ * @brief The compile time lowering of the static formula T.
+ *
+ * The nodes are laid out like in the binary format, but the symbols are indices into Symbols and End is relative to
+ * the root, so the array can be copied to any position.
+ */
+template<typename T>
+struct StaticLowering {
+	static_assert(IsFormula<T>::value && IsStatic<T>::value, "Only static formulas can be lowered!");
+	
+	static constexpr std::size_t NodeCount = fold(T{}, std::size_t{0}, [](std::size_t& count, const auto&) noexcept {
+			++count;
+			return;
+		});
+	
+	static constexpr LoweringBuilder<NodeCount> Built = [](void) {
+			LoweringBuilder<NodeCount> builder;
+			builder.add(T{});
+			return builder;
+		}();
+	
+	/**
+	 * @brief Returns the nodes with the symbols resolved against SymbolTable::global(), which is done once.
+	 */
+	static const std::array<binary::Node, NodeCount>& resolved(void) {
+		static const std::array<binary::Node, NodeCount> nodes = [](void) {
+				std::array<std::uint32_t, NodeCount> ids{};
+				for ( std::uint32_t symbol = 0; symbol < Built.SymbolCount; ++symbol ) {
+					ids[symbol] = SymbolTable::global().intern(Built.Symbols[symbol]);
+				} //for ( std::uint32_t symbol = 0; symbol < Built.SymbolCount; ++symbol )
+				auto ret = Built.Nodes;
+				for ( auto& node : ret ) {
+					if ( node.Symbol != binary::NoSymbol ) {
+						node.Symbol = ids[node.Symbol];
+					} //if ( node.Symbol != binary::NoSymbol )
+				} //for ( auto& node : ret )
+				return ret;
+			}();
+		return nodes;
+	}
+};
+} //namespace details
+
+class FlatFormulaArena;
+
+/**
+ * @brief A node of a formula in a FlatFormulaArena.
+ */
+class FlatFormulaView {
+	const FlatFormulaArena *Arena;
+	std::size_t Root;
+	std::uint32_t Index;
+	
+	friend class FlatFormulaArena;
+	
+	FlatFormulaView(const FlatFormulaArena *arena, const std::size_t root, const std::uint32_t index) noexcept :
+			Arena{arena}, Root{root}, Index{index} {
+		return;
+	}
+	
+	const binary::Node& node(void) const noexcept;
+	
+	public:
+	binary::NodeKind kind(void) const noexcept {
+		return node().Kind;
+	}
+	
+	bool isTerm(void) const noexcept {
+		return kind() == binary::NodeKind::Variable || kind() == binary::NodeKind::Function;
+	}
+	
+	std::optional<std::string_view> symbol(void) const {
+		const auto id = node().Symbol;
+		if ( id == binary::NoSymbol ) {
+			return std::nullopt;
+		} //if ( id == binary::NoSymbol )
+		return SymbolTable::global().name(id);
+	}
+	
+	std::size_t childCount(void) const noexcept {
+		return node().ChildCount;
+	}
+	
+	FlatFormulaView firstChild(void) const noexcept {
+		return {Arena, Root, Index + 1};
+	}
+	
+	FlatFormulaView nextSibling(void) const noexcept {
+		return {Arena, Root, node().End};
+	}
+	
+	RtFormula materialize(void) const {
+		return details::materializeFormula(*this);
+	}
+};
+
+/**
+ * @brief Holds the nodes of many formulas in one array.
+ *
+ * A static formula is lowered at compile time, adding it to the arena copies its precomputed nodes with one memcpy.
+ */
+class FlatFormulaArena {
+	std::vector<binary::Node> Nodes;
+	std::vector<std::size_t> Roots;
+	
+	friend class FlatFormulaView;
+	
+	public:
+	template<typename T, std::enable_if_t<IsFormula<T>::value && IsStatic<T>::value>* = nullptr>
+	std::size_t add(const T&) {
+		const auto& nodes = details::StaticLowering<T>::resolved();
+		const auto root   = Nodes.size();
+		Nodes.resize(root + nodes.size());
+		std::memcpy(Nodes.data() + root, nodes.data(), sizeof(nodes));
+		Roots.push_back(root);
+		return Roots.size() - 1;
+	}
+	
+	std::size_t size(void) const noexcept {
+		return Roots.size();
+	}
+	
+	std::size_t nodeCount(void) const noexcept {
+		return Nodes.size();
+	}
+	
+	FlatFormulaView root(const std::size_t index) const {
+		return {this, Roots.at(index), 0};
+	}
+	
+	RtFormula formula(const std::size_t index) const {
+		return root(index).materialize();
+	}
+	
+	void reserve(const std::size_t formulas, const std::size_t nodes) {
+		Roots.reserve(formulas);
+		Nodes.reserve(nodes);
+		return;
+	}
+	
+	void clear(void) noexcept {
+		Roots.clear();
+		Nodes.clear();
+		return;
+	}
+};
+
+inline const binary::Node& FlatFormulaView::node(void) const noexcept {
+	return Arena->Nodes[Root + Index];
+}
+
+} //namespace fol
+
+#endif
@@ -1,22 +1,203 @@
 #include "and.hpp"
 #include "asserts.hpp"
+#include "batch.hpp"
+#include "bdd.hpp"
+#include "bytecode.hpp"
+#include "clause_store.hpp"
+#include "congruence_closure.hpp"
+#include "datalog.hpp"
+#include "editable_formula.hpp"
+#include "egraph.hpp"
 #include "equality.hpp"
+#include "equivalence.hpp"
 #include "equivalent.hpp"
+#include "evaluation.hpp"
 #include "exists.hpp"
 #include "forall.hpp"
+#include "formula_dag.hpp"
+#include "fresh_names.hpp"
 #include "function.hpp"
+#include "grounding.hpp"
+#include "herbrand.hpp"
 #include "implies.hpp"
+#include "lowering.hpp"
+#include "memory.hpp"
+#include "miniscoping.hpp"
+#include "nary_junction.hpp"
 #include "not.hpp"
 #include "or.hpp"
+#include "order.hpp"
 #include "predicate.hpp"
 #include "pretty_printer.hpp"
+#include "rt_formula.hpp"
+#include "serialization.hpp"
+#include "small_vector.hpp"
+#include "stats.hpp"
+#include "subsumption.hpp"
+#include "truth.hpp"
+#include "truth_table.hpp"
 #include "variable.hpp"
+#include "visit.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
 
 using namespace fol;
 
+/**
+ * @brief Reads the text written by PrettyPrinter back, as the baseline for loading a rule base.
+ *
+ * The text does not tell variables from constants, terms without arguments are read as variables. Bound variable names
+ * must not contain 'A' or 'E', because chained quantifiers are written without a separator.
+ */
+class TextParser {
+	std::string_view Text;
+	std::size_t Pos = 0;
+	
+	explicit TextParser(const std::string_view text) noexcept : Text{text} {
+		return;
+	}
+	
+	static bool isNameChar(const char c) noexcept {
+		return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+	}
+	
+	void skipSpaces(void) noexcept {
+		while ( Pos < Text.size() && Text[Pos] == ' ' ) {
+			++Pos;
+		} //while ( Pos < Text.size() && Text[Pos] == ' ' )
+		return;
+	}
+	
+	std::string readName(void) {
+		const auto start = Pos;
+		while ( Pos < Text.size() && isNameChar(Text[Pos]) ) {
+			++Pos;
+		} //while ( Pos < Text.size() && isNameChar(Text[Pos]) )
+		return std::string{Text.substr(start, Pos - start)};
+	}
+	
+	std::vector<RtTerm> readArguments(void) {
+		std::vector<RtTerm> args;
+		if ( Pos < Text.size() && Text[Pos] == '(' ) {
+			do {
+				++Pos;
+				skipSpaces();
+				args.push_back(readTerm());
+			} while ( Text[Pos] == ',' );
+			++Pos;
+		} //if ( Pos < Text.size() && Text[Pos] == '(' )
+		return args;
+	}
+	
+	static RtTerm toTerm(std::string name, std::vector<RtTerm> args) {
+		return args.empty() ? RtTerm{RtVariable{std::move(name)}} : RtTerm{RtName{std::move(name)}, std::move(args)};
+	}
+	
+	RtTerm readTerm(void) {
+		auto name = readName();
+		return toTerm(std::move(name), readArguments());
+	}
+	
+	RtFormula readUnit(void) {
+		skipSpaces();
+		const char c = Text[Pos];
+		if ( c == '-' ) {
+			++Pos;
+			return RtFormula::negation(readUnit());
+		} //if ( c == '-' )
+		if ( c == '(' || c == '[' || c == '{' ) {
+			++Pos;
+			auto ret = readFormula();
+			++Pos;
+			return ret;
+		} //if ( c == '(' || c == '[' || c == '{' )
+		
+		auto end = Pos;
+		while ( end < Text.size() && isNameChar(Text[end]) ) {
+			++end;
+		} //while ( end < Text.size() && isNameChar(Text[end]) )
+		if ( end < Text.size() && Text[end] == ':' ) {
+			std::vector<std::pair<char, std::string>> quantifiers;
+			for ( auto start = Pos; start < end; ) {
+				auto nameEnd = start + 1;
+				while ( nameEnd < end && Text[nameEnd] != 'A' && Text[nameEnd] != 'E' ) {
+					++nameEnd;
+				} //while ( nameEnd < end && Text[nameEnd] != 'A' && Text[nameEnd] != 'E' )
+				quantifiers.emplace_back(Text[start], Text.substr(start + 1, nameEnd - start - 1));
+				start = nameEnd;
+			} //for ( auto start = Pos; start < end; )
+			Pos      = end + 1;
+			auto ret = readUnit();
+			for ( auto iter = quantifiers.rbegin(); iter != quantifiers.rend(); ++iter ) {
+				ret = iter->first == 'A' ? RtFormula::forAll(RtVariable{iter->second}, std::move(ret)) :
+				                           RtFormula::exists(RtVariable{iter->second}, std::move(ret));
+			} //for ( auto iter = quantifiers.rbegin(); iter != quantifiers.rend(); ++iter )
+			return ret;
+		} //if ( end < Text.size() && Text[end] == ':' )
+		
+		auto name = readName();
+		auto args = readArguments();
+		skipSpaces();
+		if ( Pos < Text.size() && Text[Pos] == '=' ) {
+			++Pos;
+			skipSpaces();
+			auto lhs = toTerm(std::move(name), std::move(args));
+			return RtFormula::equality(std::move(lhs), readTerm());
+		} //if ( Pos < Text.size() && Text[Pos] == '=' )
+		if ( args.empty() && (name == "true" || name == "false") ) {
+			return RtFormula::constant(name == "true");
+		} //if ( args.empty() && (name == "true" || name == "false") )
+		return RtFormula::predicate(RtName{std::move(name)}, std::move(args));
+	}
+	
+	RtFormula readFormula(void) {
+		std::vector<RtFormula> operands;
+		operands.push_back(readUnit());
+		char op = '&';
+		for ( ;; ) {
+			skipSpaces();
+			if ( Pos == Text.size() || Text[Pos] == ')' || Text[Pos] == ']' || Text[Pos] == '}' ) {
+				break;
+			} //if ( Pos == Text.size() || Text[Pos] == ')' || Text[Pos] == ']' || Text[Pos] == '}' )
+			op   = Text[Pos] == '-' ? '>' : Text[Pos];
+			Pos += op == '<' ? 3 : op == '>' ? 2 : 1;
+			operands.push_back(readUnit());
+		} //for ( ;; )
+		if ( operands.size() == 1 ) {
+			return std::move(operands.front());
+		} //if ( operands.size() == 1 )
+		switch ( op ) {
+			case '|' : return RtFormula::disjunction(std::move(operands));
+			case '>' : return RtFormula::implication(std::move(operands[0]), std::move(operands[1]));
+			case '<' : return RtFormula::equivalence(std::move(operands[0]), std::move(operands[1]));
+			default  : return RtFormula::conjunction(std::move(operands));
+		} //switch ( op )
+	}
+	
+	public:
+	static RtFormula parse(const std::string_view text) {
+		return TextParser{text}.readFormula();
+	}
+};
+
 int main(void) {
 	constexpr Variable<'x'> x;
 	constexpr Variable<'F', 'o', 'o'> foo;
@@ -182,5 +363,1273 @@ int main(void) {
 	         <<"Normal:     "<<PrettyPrinter{formula}<<std::endl
 	         <<"Simplified: "<<PrettyPrinter{simplified}<<std::endl
 	         <<"NNF:        "<<PrettyPrinter{nnf}<<std::endl;
+	const auto toString = [](const auto& t) {
+			std::ostringstream os;
+			os<<t;
+			return os.str();
+		};
+	
+	const auto rtFormula    = toRuntime(formula);
+	const auto rtSimplified = rtFormula.simplified();
+	const auto rtNnf        = rtFormula.toNegationNormalForm();
+	assert(rtSimplified == toRuntime(simplified));
+	assert(rtNnf == toRuntime(nnf));
+	assert(toString(PrettyPrinter{rtFormula}) == toString(PrettyPrinter{formula}));
+	assert(toString(PrettyPrinter{rtNnf}) == toString(PrettyPrinter{nnf}));
+	assert(toString(toRuntime(andOr)) == toString(andOr));
+	
+	std::cout<<std::endl
+	         <<"   ==== Rt Formula  ===="<<std::endl
+	         <<std::endl
+	         <<"Normal:     "<<PrettyPrinter{rtFormula}<<' '<<sizeof(rtFormula)<<std::endl
+	         <<"Simplified: "<<PrettyPrinter{rtSimplified}<<std::endl
+	         <<"NNF:        "<<PrettyPrinter{rtNnf}<<std::endl;
+	
+	ClauseStore clauses;
+	const auto c1 = clauses.add(Or{lovesPred(x), Not{lovesPred(y)}});
+	const auto c2 = clauses.add(Or{Not{lovesPred(x)}, lovesPred(z), Equality{x, y}});
+	const auto c3 = clauses.add(Not{lovesPred(x)});
+	assert(clauses.atomCount() == 4);
+	assert(clauses.toFormula(c1) == toRuntime(Or{lovesPred(x), Not{lovesPred(y)}}));
+	assert(*clauses.begin(c3) == ClauseStore::negated(*clauses.begin(c1)));
+	clauses.remove(c1);
+	assert(clauses.needsCompaction() == false);
+	clauses.remove(c2);
+	assert(clauses.needsCompaction());
+	const auto newIndices = clauses.compact();
+	assert(newIndices[c1] == ClauseStore::InvalidClause && newIndices[c2] == ClauseStore::InvalidClause);
+	assert(newIndices[c3] == 0 && clauses.size() == 1);
+	assert(clauses.toFormula(0) == toRuntime(Or{Not{lovesPred(x)}}));
+	
+	bool unknownAtomThrown = false;
+	try {
+		const ClauseStore::Literal unknown[] = {ClauseStore::makeLiteral(4, false)};
+		clauses.add(std::begin(unknown), std::end(unknown));
+	} //try
+	catch ( const std::invalid_argument& ) {
+		unknownAtomThrown = true;
+	} //catch ( const std::invalid_argument& )
+	assert(unknownAtomThrown && clauses.size() == 1);
+	
+	std::vector<ClauseStore::Literal> atomLiterals;
+	for ( int i = 0; i < 1000; ++i ) {
+		const RtTerm constant{RtName{"c" + std::to_string(i)}};
+		atomLiterals.push_back(clauses.literal(RtFormula::predicate(RtName{"P"}, {constant})));
+	} //for ( int i = 0; i < 1000; ++i )
+	assert(clauses.atomCount() == 1004);
+	constexpr int generatedClauses = 100000;
+	for ( int i = 0; i < generatedClauses; ++i ) {
+		const ClauseStore::Literal literals[] = {
+			i % 2 == 0 ? ClauseStore::negated(atomLiterals[static_cast<std::size_t>(i % 1000)]) :
+			             atomLiterals[static_cast<std::size_t>(i % 1000)],
+			i % 3 == 0 ? ClauseStore::negated(atomLiterals[static_cast<std::size_t>(i % 997)]) :
+			             atomLiterals[static_cast<std::size_t>(i % 997)],
+			i % 5 == 0 ? ClauseStore::negated(atomLiterals[static_cast<std::size_t>(i % 991)]) :
+			             atomLiterals[static_cast<std::size_t>(i % 991)]};
+		clauses.add(std::begin(literals), std::end(literals));
+	} //for ( int i = 0; i < generatedClauses; ++i )
+	assert(clauses.toFormula(static_cast<ClauseStore::ClauseIndex>(clauses.size() - 1)).Children.size() == 3);
+	std::cout<<std::endl
+	         <<"Clause store: "<<clauses.liveClauses()<<" clauses, "<<clauses.literalCount()<<" literals, "
+	         <<static_cast<double>(clauses.memoryUsage()) / static_cast<double>(clauses.literalCount())
+	         <<" bytes per literal"<<std::endl;
+	
+	std::vector<RtFormula> batch;
+	for ( int i = 0; i < 20000; ++i ) {
+		batch.push_back(toRuntime(ForAll{RtVariable{"x" + std::to_string(i)}, innerFormula}));
+	} //for ( int i = 0; i < 20000; ++i )
+	const auto serialNnf = toNegationNormalFormBatch(batch, 1);
+	assert(serialNnf.size() == batch.size());
+	assert(serialNnf[42] == batch[42].toNegationNormalForm());
+	assert(simplifiedBatch(batch)[4242] == batch[4242].simplified());
+	
+	//Doubles the threads up to the core count, which is measured as well when it is no power of two.
+	const auto nextThreads = [cores = details::defaultThreadCount()](const unsigned int threads) noexcept {
+			return threads < cores ? std::min(2 * threads, cores) : cores + 1;
+		};
+	std::cout<<std::endl<<"Batch NNF of "<<batch.size()<<" formulas:"<<std::endl;
+	for ( unsigned int threads = 1; threads <= details::defaultThreadCount(); threads = nextThreads(threads) ) {
+		const auto start  = std::chrono::steady_clock::now();
+		const auto result = toNegationNormalFormBatch(batch, threads);
+		const auto end    = std::chrono::steady_clock::now();
+		assert(result == serialNnf);
+		std::cout<<threads<<" threads: "<<std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+		         <<" us"<<std::endl;
+	} //for ( unsigned int threads = 1; threads <= details::defaultThreadCount(); threads = nextThreads(threads) )
+	
+	FormulaDag dag;
+	const auto dagFormula = dag.add(formula);
+	assert(dag.add(formula) == dagFormula);
+	assert(dag.toFormula(dagFormula) == rtFormula);
+	assert(dag.toFormula(dag.simplified(dagFormula)) == rtSimplified);
+	assert(dag.toFormula(dag.toNegationNormalForm(dagFormula)) == rtNnf);
+	assert(dag.toFormula(dag.negate(dagFormula)) == rtFormula.negate());
+	
+	auto shared = toRuntime(Implies{lovesPred(x), lovesPred(y)});
+	for ( int i = 0; i < 8; ++i ) {
+		auto q = RtFormula::predicate(RtName{"q" + std::to_string(i)});
+		shared = RtFormula::equivalence(RtFormula::conjunction({shared, std::move(q)}), RtFormula::negation(shared));
+	} //for ( int i = 0; i < 8; ++i )
+	
+	const auto countNodes = [](const RtFormula& f) {
+			std::size_t ret = 0;
+			std::vector<const RtFormula*> stack{&f};
+			while ( !stack.empty() ) {
+				const RtFormula *current = stack.back();
+				stack.pop_back();
+				++ret;
+				for ( const auto& child : current->Children ) {
+					stack.push_back(&child);
+				} //for ( const auto& child : current->Children )
+			} //while ( !stack.empty() )
+			return ret;
+		};
+	
+	const auto treeStart   = std::chrono::steady_clock::now();
+	const auto treeNnf     = shared.toNegationNormalForm();
+	const auto treeEnd     = std::chrono::steady_clock::now();
+	FormulaDag sharedDag;
+	const auto dagStart    = std::chrono::steady_clock::now();
+	const auto sharedNnf   = sharedDag.toNegationNormalForm(sharedDag.add(shared));
+	const auto dagEnd      = std::chrono::steady_clock::now();
+	assert(sharedDag.toFormula(sharedNnf) == treeNnf);
+	std::cout<<std::endl
+	         <<"Shared formula: "<<countNodes(shared)<<" tree nodes, NNF "<<countNodes(treeNnf)<<" tree nodes in "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(treeEnd - treeStart).count()<<" us"<<std::endl
+	         <<"Hash-consed:    "<<sharedDag.size()<<" DAG nodes incl. NNF, "<<sharedDag.memoryUsage()<<" bytes in "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(dagEnd - dagStart).count()<<" us"<<std::endl;
+	
+	constexpr auto p = Predicate{Name<'p'>{}};
+	constexpr auto q = Predicate{Name<'q'>{}};
+	const auto corpus = std::make_tuple(And{p, Or{p, q}}, Or{p, Not{p}, q}, Equivalent{p, p},
+	                                    And{lovesPred(x), True{}, lovesPred(x)},
+	                                    ForAll{x, Or{Equality{x, x}, lovesPred(x)}}, Implies{And{p, q}, Or{q, False{}}},
+	                                    Not{Exists{y, And{lovesPred(y), Not{lovesPred(y)}}}});
+	std::size_t corpusNodes = 0, simplifiedCorpusNodes = 0;
+	std::apply([&](const auto&... forms) {
+			const auto check = [&](const auto& form) {
+					const auto rtForm = toRuntime(form);
+					const auto rtSimple = rtForm.simplified();
+					assert(toRuntime(form.simplified()) == rtSimple);
+					assert(dag.toFormula(dag.simplified(dag.add(rtForm))) == rtSimple);
+					corpusNodes           += countNodes(rtForm);
+					simplifiedCorpusNodes += countNodes(rtSimple);
+					std::cout<<form<<" => "<<form.simplified()<<" ("<<sizeof(form)<<" -> "<<sizeof(form.simplified())
+					         <<" bytes)"<<std::endl;
+					return;
+				};
+			(check(forms), ...);
+			return;
+		}, corpus);
+	assert(sharedDag.toFormula(sharedDag.simplified(sharedDag.add(shared))) == shared.simplified());
+	std::cout<<"Corpus nodes: "<<corpusNodes<<" -> "<<simplifiedCorpusNodes<<std::endl;
+	
+	const auto textPath   = (std::filesystem::temp_directory_path() / "fol_rule_base.txt").string();
+	const auto binaryPath = (std::filesystem::temp_directory_path() / "fol_rule_base.bin").string();
+	{
+		std::ofstream text{textPath};
+		for ( const auto& f : batch ) {
+			text<<PrettyPrinter{f}<<'\n';
+		} //for ( const auto& f : batch )
+		BinaryWriter writer;
+		for ( const auto& f : batch ) {
+			writer.add(f);
+		} //for ( const auto& f : batch )
+		writer.add(RtFormula::constant(true));
+		writer.write(binaryPath);
+	}
+	
+	//Loading is timed from opening the file to having every formula as RtFormula, the checks come afterwards.
+	const auto textStart = std::chrono::steady_clock::now();
+	std::vector<RtFormula> textFormulas;
+	{
+		std::ifstream text{textPath};
+		for ( std::string line; std::getline(text, line); ) {
+			textFormulas.push_back(TextParser::parse(line));
+		} //for ( std::string line; std::getline(text, line); )
+	}
+	const auto textEnd = std::chrono::steady_clock::now();
+	
+	{
+		const auto binaryStart = std::chrono::steady_clock::now();
+		MappedFormulaFile mapped{binaryPath};
+		const auto binaryOpened = std::chrono::steady_clock::now();
+		std::vector<RtFormula> binaryFormulas;
+		binaryFormulas.reserve(mapped.size());
+		for ( std::size_t i = 0; i < mapped.size(); ++i ) {
+			binaryFormulas.push_back(mapped.formula(i));
+		} //for ( std::size_t i = 0; i < mapped.size(); ++i )
+		const auto binaryEnd = std::chrono::steady_clock::now();
+		
+		assert(textFormulas.size() == batch.size());
+		assert(std::equal(batch.begin(), batch.end(), textFormulas.begin()));
+		assert(binaryFormulas.size() == batch.size() + 1);
+		assert(std::equal(batch.begin(), batch.end(), binaryFormulas.begin()));
+		assert(binaryFormulas.back() == RtFormula::constant(true));
+		assert(mapped.root(7).kind() == binary::NodeKind::ForAll);
+		assert(mapped.root(7).symbol() == "x7");
+		const auto quantifiedTruth = RtFormula::forAll(RtVariable{"x"},
+		                                               RtFormula::exists(RtVariable{"y"}, RtFormula::constant(true)));
+		assert(TextParser::parse("-(a = f(b)) & AxEy: (true)") ==
+		       RtFormula::conjunction({RtFormula::negation(RtFormula::equality(RtVariable{"a"},
+		                                                                       RtTerm{RtName{"f"}, {RtVariable{"b"}}})),
+		                               quantifiedTruth}));
+		std::cout<<std::endl<<"Loading "<<batch.size()<<" formulas:"<<std::endl
+		         <<"Text read and parse:      "
+		         <<std::chrono::duration_cast<std::chrono::microseconds>(textEnd - textStart).count()<<" us"<<std::endl
+		         <<"Binary map:               "
+		         <<std::chrono::duration_cast<std::chrono::microseconds>(binaryOpened - binaryStart).count()<<" us"
+		         <<std::endl
+		         <<"Materialize all formulas: "
+		         <<std::chrono::duration_cast<std::chrono::microseconds>(binaryEnd - binaryOpened).count()<<" us"
+		         <<std::endl;
+	}
+	std::remove(textPath.c_str());
+	std::remove(binaryPath.c_str());
+	
+	BinaryWriter corruptWriter;
+	corruptWriter.add(batch[7]);
+	const auto image = corruptWriter.bytes();
+	binary::Header imageHeader;
+	std::memcpy(&imageHeader, image.data(), sizeof(imageHeader));
+	const std::size_t imageRoots = sizeof(binary::Header) + (imageHeader.SymbolCount + 1u) * sizeof(std::uint32_t);
+	const std::size_t imageNodes = imageRoots + imageHeader.RootCount * sizeof(std::uint32_t);
+	const auto patched = [&image](const std::size_t offset, const std::uint32_t value) {
+			auto ret = image;
+			std::memcpy(ret.data() + offset, &value, sizeof(value));
+			return ret;
+		};
+	const auto rejects = [&patched](const std::size_t offset, const std::uint32_t value) {
+			const auto corrupt = patched(offset, value);
+			try {
+				FormulaImage{corrupt.data(), corrupt.size()};
+			} //try
+			catch ( const std::invalid_argument& ) {
+				return true;
+			} //catch ( const std::invalid_argument& )
+			return false;
+		};
+	assert(FormulaImage(image.data(), image.size()).formula(0) == batch[7]);
+	assert(rejects(imageRoots, imageHeader.NodeCount));
+	assert(rejects(sizeof(binary::Header) + sizeof(std::uint32_t), imageHeader.SymbolBytes + 1));
+	assert(rejects(imageNodes + offsetof(binary::Node, Symbol), imageHeader.SymbolCount));
+	assert(rejects(imageNodes + offsetof(binary::Node, End), imageHeader.NodeCount + 1));
+	assert(rejects(imageNodes + offsetof(binary::Node, ChildCount), 2));
+	
+	const auto imageNode = [&image, imageNodes](const std::size_t index) {
+			binary::Node ret;
+			std::memcpy(&ret, image.data() + imageNodes + index * sizeof(binary::Node), sizeof(ret));
+			return ret;
+		};
+	const auto kindAt = [imageNodes](const std::size_t index) noexcept {
+			return imageNodes + index * sizeof(binary::Node) + offsetof(binary::Node, Kind);
+		};
+	const auto kind = [](const binary::NodeKind k) noexcept { return static_cast<std::uint32_t>(k); };
+	std::size_t unaryPredicate = 0, variableNode = 0;
+	for ( std::size_t index = imageHeader.NodeCount; index-- > 0; ) {
+		const auto node = imageNode(index);
+		if ( node.Kind == binary::NodeKind::Predicate && node.ChildCount == 1 ) {
+			unaryPredicate = index;
+		} //if ( node.Kind == binary::NodeKind::Predicate && node.ChildCount == 1 )
+		if ( node.Kind == binary::NodeKind::Variable ) {
+			variableNode = index;
+		} //if ( node.Kind == binary::NodeKind::Variable )
+	} //for ( std::size_t index = imageHeader.NodeCount; index-- > 0; )
+	assert(imageNode(0).Kind == binary::NodeKind::ForAll && unaryPredicate != 0 && variableNode != 0);
+	const auto existsImage = patched(kindAt(0), kind(binary::NodeKind::Exists));
+	assert(FormulaImage(existsImage.data(), existsImage.size()).formula(0) ==
+	       RtFormula::exists(RtVariable{"x7"}, batch[7].Children.front()));
+	assert(rejects(kindAt(0), kind(binary::NodeKind::Implies)));
+	assert(rejects(kindAt(0), kind(binary::NodeKind::Function)));
+	assert(rejects(kindAt(1), kind(binary::NodeKind::Function)));
+	assert(rejects(kindAt(variableNode), kind(binary::NodeKind::True)));
+	assert(rejects(kindAt(unaryPredicate), kind(binary::NodeKind::Equality)));
+	
+	FreshNameGenerator freshNames;
+	for ( std::uint64_t id = 0; id < 1000; ++id ) {
+		assert(RtName{freshNames.nameOf(id)}.next() == RtName{freshNames.nameOf(id + 1)});
+	} //for ( std::uint64_t id = 0; id < 1000; ++id )
+	freshNames.avoid(formula);
+	assert(freshNames.next() == RtName{"a"});
+	assert(freshNames.next() == RtName{"b"});
+	for ( int i = 0; i < 21; ++i ) {
+		assert(freshNames.next() != RtName{"x"});
+	} //for ( int i = 0; i < 21; ++i )
+	
+	constexpr unsigned int nameThreads = 8;
+	constexpr int namesPerThread = 20000;
+	std::vector<std::vector<RtName>> freshPerThread(nameThreads);
+	std::vector<std::thread> nameWorkers;
+	const auto freshStart = std::chrono::steady_clock::now();
+	for ( unsigned int t = 0; t < nameThreads; ++t ) {
+		nameWorkers.emplace_back([&freshNames, &freshPerThread, t](void) {
+				auto block = freshNames.block();
+				for ( int i = 0; i < namesPerThread; ++i ) {
+					freshPerThread[t].push_back(i % 2 ? block.next() : freshNames.next());
+				} //for ( int i = 0; i < namesPerThread; ++i )
+				return;
+			});
+	} //for ( unsigned int t = 0; t < nameThreads; ++t )
+	for ( auto& worker : nameWorkers ) {
+		worker.join();
+	} //for ( auto& worker : nameWorkers )
+	const auto freshEnd = std::chrono::steady_clock::now();
+	
+	std::unordered_set<RtName> uniqueNames;
+	for ( const auto& names : freshPerThread ) {
+		uniqueNames.insert(names.begin(), names.end());
+	} //for ( const auto& names : freshPerThread )
+	assert(uniqueNames.size() == nameThreads * namesPerThread);
+	assert(!uniqueNames.count(RtName{"x"}) && !uniqueNames.count(RtName{"Loves"}));
+	std::cout<<std::endl<<nameThreads * namesPerThread<<" fresh names from "<<nameThreads<<" threads: "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(freshEnd - freshStart).count()<<" us"<<std::endl;
+	
+	stats::Collector collector;
+	{
+		const stats::Install install{&collector};
+		std::ostringstream printed;
+		printed<<rtFormula.toNegationNormalForm()<<PrettyPrinter{rtFormula.simplified()};
+		toNegationNormalFormBatch(batch);
+	}
+	const auto nnfStats = collector.stats(stats::Pass::NegationNormalForm);
+	if constexpr ( stats::Enabled ) {
+		assert(nnfStats.Calls == batch.size() + 1);
+		assert(nnfStats.Visits[static_cast<std::size_t>(RtFormula::Kind::ForAll)] >= batch.size());
+		assert(nnfStats.MaxDepth > 1 && nnfStats.Allocations > 0);
+		assert(collector.stats(stats::Pass::Print).Calls == 2);
+		assert(collector.stats(stats::Pass::Simplify).Calls == 1);
+		assert(collector.events().size() == batch.size() + 4);
+		
+		const auto tracePath = (std::filesystem::temp_directory_path() / "fol_trace.json").string();
+		std::ofstream trace{tracePath};
+		collector.writeChromeTrace(trace);
+		std::cout<<std::endl<<"NNF statistics of "<<nnfStats.Calls<<" passes: "<<nnfStats.visits()<<" visits, "
+		         <<nnfStats.Allocations<<" allocations ("<<nnfStats.Bytes<<" bytes), max depth "<<nnfStats.MaxDepth
+		         <<", "<<std::chrono::duration_cast<std::chrono::microseconds>(nnfStats.Elapsed).count()<<" us"
+		         <<std::endl
+		         <<"Chrome trace written to "<<tracePath<<std::endl;
+	} //if constexpr ( stats::Enabled )
+	else {
+		assert(nnfStats.Calls == 0 && collector.events().empty());
+	} //else -> if constexpr ( stats::Enabled )
+	
+	const auto staticUsage = memoryUsage(formula);
+	assert(staticUsage.InlineBytes == sizeof(formula) && staticUsage.HeapBytes == 0);
+	assert(staticUsage.nodes() == memoryUsage(rtFormula).nodes());
+	assert(staticUsage.nodes(RtFormula::Kind::Exists) == 1);
+	const auto twiceUsage = memoryUsage(RtFormula::conjunction({rtFormula, rtFormula}));
+	assert(twiceUsage.nodes() == 2 * staticUsage.nodes() + 1 && twiceUsage.Formulas == 1);
+	assert(twiceUsage.SharedBytes > 0 && twiceUsage.SharedBytes < twiceUsage.bytes() / 2);
+	assert(memoryUsage(RtFormula::predicate(RtName{std::string(64, 'P')})).HeapBytes == 65);
+	assert(memoryUsage(RtFormula::predicate(RtName{"P"})).HeapBytes == 0);
+	const Predicate<RtName, RtVariable> longAtom{RtName{std::string(64, 'P')}, RtVariable{std::string(32, 'x')}};
+	const And mixedAtoms{longAtom, Not{longAtom}};
+	const auto mixedUsage = memoryUsage(mixedAtoms);
+	assert(mixedUsage.InlineBytes == sizeof(mixedAtoms) && mixedUsage.HeapBytes == 2 * (65 + 33));
+	assert(mixedUsage.SharedBytes == sizeof(longAtom) + 65 + 33);
+	assert(mixedUsage.nodes() == memoryUsage(toRuntime(mixedAtoms)).nodes() && mixedUsage.Terms == 2);
+	std::cout<<std::endl<<"Memory of the batch rule base:"<<std::endl<<memoryUsage(batch);
+	
+	assert(atomCount(rtFormula) == atomCount(formula));
+	assert(fold(rtFormula, 0, [](int& count, const auto&) { ++count; return; }) ==
+	       fold(formula, 0, [](int& count, const auto&) { ++count; return; }));
+	
+	constexpr int deepNesting = 100000;
+	RtFormula deep = RtFormula::predicate(RtName{"P"}, {RtVariable{"x"}});
+	for ( int i = 0; i < deepNesting; ++i ) {
+		deep = RtFormula::negation(std::move(deep));
+	} //for ( int i = 0; i < deepNesting; ++i )
+	assert(fold(deep, 0, [](int& count, const auto& node) {
+			count += std::is_same_v<std::decay_t<decltype(node)>, RtFormula> ? 1 : 0;
+			return;
+		}) == deepNesting + 1);
+	assert(atomCount(deep) == 1);
+	
+	FlatFormulaArena arena;
+	arena.add(formula);
+	arena.add(Not{formula});
+	assert(arena.size() == 2 && arena.formula(0) == rtFormula);
+	assert(arena.formula(1) == RtFormula::negation(rtFormula));
+	assert(arena.root(1).firstChild().materialize() == rtFormula);
+	
+	constexpr int instantiations = 100000;
+	arena.clear();
+	arena.reserve(instantiations, instantiations * details::StaticLowering<std::decay_t<decltype(formula)>>::NodeCount);
+	const auto lowerStart = std::chrono::steady_clock::now();
+	for ( int i = 0; i < instantiations; ++i ) {
+		arena.add(formula);
+	} //for ( int i = 0; i < instantiations; ++i )
+	const auto lowerEnd = std::chrono::steady_clock::now();
+	std::vector<RtFormula> converted;
+	converted.reserve(instantiations);
+	for ( int i = 0; i < instantiations; ++i ) {
+		converted.push_back(toRuntime(formula));
+	} //for ( int i = 0; i < instantiations; ++i )
+	const auto convertEnd = std::chrono::steady_clock::now();
+	assert(arena.formula(instantiations - 1) == converted.back());
+	std::cout<<std::endl<<instantiations<<" instantiations of the lowered formula: "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(lowerEnd - lowerStart).count()<<" us, toRuntime: "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(convertEnd - lowerEnd).count()<<" us"<<std::endl;
+	
+	Interpretation world{5};
+	world.definePredicate(RtName{"Animal"}, 1, [](const Interpretation::Element *args) { return args[0] != 2; });
+	world.definePredicate(RtName{"Loves"}, 2, [](const Interpretation::Element *args) {
+			return (args[0] + 2 * args[1]) % 3 != 0;
+		});
+	world.defineFunction(RtName{"f"}, 1, [](const Interpretation::Element *args) { return (args[0] + 1) % 5; });
+	
+	constexpr auto animalPred = [](auto t) { return Predicate{Name<'A', 'n', 'i', 'm', 'a', 'l'>{}, t}; };
+	constexpr auto mixedFormula = Equivalent{Exists{z, Equality{Function{Name<'f'>{}, z}, x}},
+	                                         Or{And{lovesPred(x, x), True{}}, Not{animalPred(x)}}};
+	for ( const auto& checked : {toRuntime(innerFormula), toRuntime(mixedFormula)} ) {
+		const CompiledFormula compiled{checked, world};
+		auto machine = compiled.machine(world);
+		assert(compiled.freeVariables().size() == 1 && compiled.freeVariables().front() == RtName{"x"});
+		for ( Interpretation::Element element = 0; element < world.domainSize(); ++element ) {
+			Assignment assignment{{RtName{"x"}, element}};
+			assert(machine.run(&element) == evaluate(checked, world, assignment));
+		} //for ( Interpretation::Element element = 0; element < world.domainSize(); ++element )
+	} //for ( const auto& checked : {toRuntime(innerFormula), toRuntime(mixedFormula)} )
+	Assignment emptyAssignment;
+	assert(CompiledFormula(formula, world).machine(world).run(std::vector<Interpretation::Element>{}) ==
+	       evaluate(formula, world, emptyAssignment));
+	
+	constexpr int evaluations = 200000;
+	const CompiledFormula compiledInner{innerFormula, world};
+	auto innerMachine = compiledInner.machine(world);
+	const auto evaluationStart = std::chrono::steady_clock::now();
+	std::size_t treeTrue = 0, bytecodeTrue = 0;
+	Assignment benchmarkAssignment{{RtName{"x"}, 0}};
+	for ( int i = 0; i < evaluations; ++i ) {
+		benchmarkAssignment[RtName{"x"}] = static_cast<Interpretation::Element>(i % 5);
+		treeTrue += evaluate(rtFormula.Children.front(), world, benchmarkAssignment) ? 1u : 0u;
+	} //for ( int i = 0; i < evaluations; ++i )
+	const auto treeEvaluationEnd = std::chrono::steady_clock::now();
+	for ( int i = 0; i < evaluations; ++i ) {
+		const auto element = static_cast<Interpretation::Element>(i % 5);
+		bytecodeTrue += innerMachine.run(&element) ? 1u : 0u;
+	} //for ( int i = 0; i < evaluations; ++i )
+	const auto bytecodeEvaluationEnd = std::chrono::steady_clock::now();
+	assert(treeTrue == bytecodeTrue);
+	const auto perSecond = [](const auto duration) {
+			return static_cast<long long>(evaluations / std::chrono::duration<double>(duration).count());
+		};
+	std::cout<<std::endl<<"Evaluations per second, tree: "<<perSecond(treeEvaluationEnd - evaluationStart)
+	         <<", bytecode ("<<compiledInner.code().size()<<" instructions): "
+	         <<perSecond(bytecodeEvaluationEnd - treeEvaluationEnd)<<std::endl;
+	
+	assert((TruthTable{Or{p, Not{p}}}.isTautology()));
+	assert((!TruthTable{And{p, Not{p}}}.isSatisfiable()));
+	assert((!TruthTable{Implies{p, q}}.value(1) && TruthTable{Implies{p, q}}.value(2)));
+	assert((TruthTable{And{p, q}}.modelCount() == 1));
+	assert((TruthTable{toRuntime(And{p, q}), {RtName{"p"}, RtName{"q"}, RtName{"r"}}}.modelCount() == 2));
+	const auto singleAnd = [](RtFormula f) { return RtFormula::conjunction({std::move(f)}); };
+	assert(TruthTable{singleAnd(singleAnd(singleAnd(toRuntime(And{p, q}))))}.modelCount() == 1);
+	assert(TruthTable{singleAnd(toRuntime(Or{p, q}))}.modelCount() == 3);
+	assert((TruthTable{RtFormula::disjunction({singleAnd(toRuntime(Not{p})), singleAnd(toRuntime(And{p, q}))})} ==
+	        TruthTable{toRuntime(Implies{p, q})}));
+	assert((arePropositionallyEquivalent(toRuntime(Not{And{p, q}}), toRuntime(Or{Not{p}, Not{q}}))));
+	assert((!arePropositionallyEquivalent(toRuntime(Implies{p, q}), toRuntime(Implies{q, p}))));
+	
+	const auto propositionalFormula = [](const std::size_t variables, const std::size_t leaves) {
+			std::vector<RtFormula> level;
+			for ( std::size_t i = 0; i < leaves; ++i ) {
+				auto atom = RtFormula::predicate(RtName{"p" + std::to_string((i * 7) % variables)});
+				level.push_back(i % 3 ? std::move(atom) : RtFormula::negation(std::move(atom)));
+			} //for ( std::size_t i = 0; i < leaves; ++i )
+			for ( std::size_t round = 0; level.size() > 1; ++round ) {
+				std::vector<RtFormula> next;
+				for ( std::size_t i = 0; i + 1 < level.size(); i += 2 ) {
+					switch ( (i / 2 + round) % 4 ) {
+						case 0 : next.push_back(RtFormula::conjunction({level[i], level[i + 1]})); break;
+						case 1 : next.push_back(RtFormula::disjunction({level[i], level[i + 1]})); break;
+						case 2 : next.push_back(RtFormula::implication(level[i], level[i + 1])); break;
+						case 3 : next.push_back(RtFormula::equivalence(level[i], level[i + 1])); break;
+					} //switch ( (i / 2 + round) % 4 )
+				} //for ( std::size_t i = 0; i + 1 < level.size(); i += 2 )
+				if ( level.size() % 2 ) {
+					next.push_back(std::move(level.back()));
+				} //if ( level.size() % 2 )
+				level = std::move(next);
+			} //for ( std::size_t round = 0; level.size() > 1; ++round )
+			return std::move(level.front());
+		};
+	const char *bestBackendName = TruthTable::bestBackend() == TruthTable::Backend::AVX512 ? "AVX-512" :
+	                              TruthTable::bestBackend() == TruthTable::Backend::AVX2   ? "AVX2" : "scalar";
+	std::cout<<std::endl<<"Truth tables (scalar against "<<bestBackendName<<"):"<<std::endl;
+	for ( const auto& [variables, leaves] : {std::pair{8, 64}, std::pair{14, 256}, std::pair{20, 1024}} ) {
+		const auto propositional = propositionalFormula(static_cast<std::size_t>(variables),
+		                                                static_cast<std::size_t>(leaves));
+		const auto scalarStart = std::chrono::steady_clock::now();
+		const TruthTable scalarTable{propositional, TruthTable::Backend::Scalar};
+		const auto vectorStart = std::chrono::steady_clock::now();
+		const TruthTable vectorTable{propositional};
+		const auto vectorEnd = std::chrono::steady_clock::now();
+		const auto scalarTime = std::chrono::duration_cast<std::chrono::microseconds>(vectorStart - scalarStart);
+		const auto vectorTime = std::chrono::duration_cast<std::chrono::microseconds>(vectorEnd - vectorStart);
+		assert(scalarTable == vectorTable);
+		assert((TruthTable{propositional, TruthTable::Backend::AVX2} == scalarTable));
+		std::cout<<variables<<" variables, "<<leaves<<" leaves: "
+		         <<scalarTime.count()<<" us scalar vs "<<vectorTime.count()<<" us "<<bestBackendName<<", "
+		         <<vectorTable.modelCount()<<" models"<<std::endl;
+	} //for ( const auto& [variables, leaves] : {std::pair{8, 64}, std::pair{14, 256}, std::pair{20, 1024}} )
+	
+	{
+		BddManager bdds;
+		const auto pq = bdds.build(And{p, q});
+		assert((bdds.build(Not{And{p, q}}) == bdds.build(Or{Not{p}, Not{q}})));
+		assert((bdds.build(Or{p, Not{p}}).isTrue() && bdds.build(And{p, Not{p}}).isFalse()));
+		assert((bdds.build(Implies{p, q}) == ((!bdds.variable(RtName{"p"})) | bdds.variable(RtName{"q"}))));
+		assert((bdds.build(Equivalent{p, q}) == bdds.build(Equivalent{Not{q}, Not{p}})));
+		assert((pq.nodeCount() == 3 && static_cast<std::size_t>(pq.satCount()) == 1));
+		const Bdd empty;
+		bool emptyThrown = false;
+		try {
+			empty & pq;
+		} //try
+		catch ( const std::logic_error& ) {
+			emptyThrown = true;
+		} //catch ( const std::logic_error& )
+		assert(emptyThrown && empty.nodeCount() == 0 && empty != pq);
+		
+		BddManager randomBdds;
+		const auto propositional = propositionalFormula(14, 256);
+		const auto diagram       = randomBdds.build(propositional);
+		assert((static_cast<std::size_t>(diagram.satCount()) == TruthTable{propositional}.modelCount()));
+		const auto live = randomBdds.nodeCount();
+		assert((randomBdds.collectGarbage() > 0 && randomBdds.nodeCount() < live));
+		assert((randomBdds.build(propositional) == diagram));
+	}
+	
+	//(a1 & b1) | ... | (an & bn) is linear with the pairs next to each other and exponential with all a before all b.
+	std::vector<RtFormula> pairs;
+	for ( int i = 1; i <= 12; ++i ) {
+		pairs.push_back(RtFormula::conjunction({RtFormula::predicate(RtName{"a" + std::to_string(i)}),
+		                                        RtFormula::predicate(RtName{"b" + std::to_string(i)})}));
+	} //for ( int i = 1; i <= 12; ++i )
+	const auto pairFormula = RtFormula::disjunction(std::move(pairs));
+	std::cout<<std::endl<<"BDD nodes and time by variable order:"<<std::endl;
+	for ( const auto& [orderName, order] : {std::pair{"appearance", BddManager::VariableOrder::Appearance},
+	                                        std::pair{"frequency", BddManager::VariableOrder::Frequency},
+	                                        std::pair{"alphabetical", BddManager::VariableOrder::Alphabetical}} ) {
+		BddManager bdds;
+		const auto bddStart   = std::chrono::steady_clock::now();
+		const auto pairBdd    = bdds.build(pairFormula, order);
+		const auto bddMiddle  = std::chrono::steady_clock::now();
+		const auto randomBdd  = bdds.build(propositionalFormula(20, 1024), order);
+		const auto bddEnd     = std::chrono::steady_clock::now();
+		std::cout<<orderName<<": pairs "<<pairBdd.nodeCount()<<" nodes in "
+		         <<std::chrono::duration_cast<std::chrono::microseconds>(bddMiddle - bddStart).count()<<" us, random "
+		         <<randomBdd.nodeCount()<<" nodes in "
+		         <<std::chrono::duration_cast<std::chrono::microseconds>(bddEnd - bddMiddle).count()<<" us"<<std::endl;
+	} //for ( const auto& [orderName, order] : {...} )
+	
+	EquivalenceChecker checker;
+	const auto structural = checker.check(Implies{p, q}, Or{Not{p}, q});
+	assert((structural.V == Verdict::Equivalent && structural.Stage == EquivalenceStage::Structural));
+	assert((checker.check(ForAll{x, lovesPred(x)}, Not{Exists{x, Not{lovesPred(x)}}}).Stage ==
+	        EquivalenceStage::Structural));
+	const auto swapped = checker.check(Implies{p, q}, Implies{q, p});
+	assert((swapped.V == Verdict::NotEquivalent && swapped.Stage == EquivalenceStage::Simulation));
+	const auto commuted = checker.check(And{p, Or{q, lovesPred(x)}}, Or{And{lovesPred(x), p}, And{p, q}});
+	assert((commuted.V == Verdict::Equivalent && commuted.Stage == EquivalenceStage::Propositional));
+	assert((checker.check(Exists{y, Equality{x, y}}, True{}).V == Verdict::Unknown));
+	assert((areEquivalent(RtFormula::negation(RtFormula::negation(toRuntime(p))), p)));
+	
+	EquivalenceChecker batchChecker;
+	for ( const auto& f : batch ) {
+		assert((batchChecker.check(f, f.toNegationNormalForm()).V == Verdict::Equivalent));
+		assert((batchChecker.check(f, RtFormula::negation(f)).V == Verdict::NotEquivalent));
+		assert((batchChecker.check(f.Children.front(), rtFormula.Children.front()).V == Verdict::Equivalent));
+	} //for ( const auto& f : batch )
+	std::cout<<std::endl<<"Equivalence queries decided per stage:"<<std::endl;
+	for ( const auto& [stageName, stage] : {std::pair{"structural", EquivalenceStage::Structural},
+	                                        std::pair{"simulation", EquivalenceStage::Simulation},
+	                                        std::pair{"propositional", EquivalenceStage::Propositional},
+	                                        std::pair{"undecided", EquivalenceStage::Undecided}} ) {
+		std::cout<<stageName<<": "<<batchChecker.decided(stage)<<" in "
+		         <<std::chrono::duration_cast<std::chrono::microseconds>(batchChecker.elapsed(stage)).count()<<" us"
+		         <<std::endl;
+	} //for ( const auto& [stageName, stage] : {...} )
+	
+	//A balanced tree over the batch, so the junctions stay binary and the leaves deep.
+	std::vector<RtFormula> ruleLevel = batch;
+	while ( ruleLevel.size() > 1 ) {
+		std::vector<RtFormula> nextLevel;
+		for ( std::size_t i = 0; i + 1 < ruleLevel.size(); i += 2 ) {
+			nextLevel.push_back(i % 4 ? RtFormula::disjunction({std::move(ruleLevel[i]), std::move(ruleLevel[i + 1])}) :
+			                            RtFormula::conjunction({std::move(ruleLevel[i]), std::move(ruleLevel[i + 1])}));
+		} //for ( std::size_t i = 0; i + 1 < ruleLevel.size(); i += 2 )
+		if ( ruleLevel.size() % 2 ) {
+			nextLevel.push_back(std::move(ruleLevel.back()));
+		} //if ( ruleLevel.size() % 2 )
+		ruleLevel = std::move(nextLevel);
+	} //while ( ruleLevel.size() > 1 )
+	const auto ruleBase = std::move(ruleLevel.front());
+	EditableFormula editable{ruleBase};
+	assert((editable.formula(editable.root()) == ruleBase));
+	assert((editable.dag().toFormula(editable.simplified(editable.root())) == ruleBase.simplified()));
+	
+	constexpr int edits = 20;
+	std::chrono::nanoseconds incrementalTime{0}, fullTime{0};
+	for ( int edit = 0; edit < edits; ++edit ) {
+		auto leaf = editable.root();
+		for ( unsigned int path = static_cast<unsigned int>(edit) * 2654435761u;
+		      editable.kind(leaf) != RtFormula::Kind::Predicate; path >>= 1 ) {
+			const auto& children = editable.children(leaf);
+			leaf = children[path % children.size()];
+		} //for ( unsigned int path = ...; editable.kind(leaf) != RtFormula::Kind::Predicate; path >>= 1 )
+		
+		const auto incrementalStart = std::chrono::steady_clock::now();
+		editable.replace(leaf, RtFormula::predicate(RtName{"Edited" + std::to_string(edit)}, {RtVariable{"x"}}));
+		const auto incrementalSimplified = editable.simplified(editable.root());
+		const auto incrementalNormalForm = editable.toNegationNormalForm(editable.root());
+		const auto incrementalEnd = std::chrono::steady_clock::now();
+		
+		const auto edited     = editable.formula(editable.root());
+		const auto fullStart  = std::chrono::steady_clock::now();
+		const auto fullSimple = edited.simplified();
+		const auto fullNormal = edited.toNegationNormalForm();
+		const auto fullEnd    = std::chrono::steady_clock::now();
+		assert((editable.dag().toFormula(incrementalSimplified) == fullSimple));
+		assert((editable.dag().toFormula(incrementalNormalForm) == fullNormal));
+		incrementalTime += incrementalEnd - incrementalStart;
+		fullTime        += fullEnd - fullStart;
+	} //for ( int edit = 0; edit < edits; ++edit )
+	std::cout<<std::endl<<"Edit to normal forms of "<<batch.size()<<" rules, incremental: "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(incrementalTime).count() / edits
+	         <<" us, from the root: "<<std::chrono::duration_cast<std::chrono::microseconds>(fullTime).count() / edits
+	         <<" us"<<std::endl;
+	
+	const RtTerm groundableTerm{RtName{"g"}, {RtTerm{RtName{"f"}, {RtVariable{"x"}}}, RtTerm{RtName{"a"}}}};
+	const auto groundable = RtFormula::predicate(RtName{"P"}, {groundableTerm});
+	constexpr auto unbounded = std::numeric_limits<std::size_t>::max();
+	HerbrandEnumerator universe{groundable, HerbrandEnumerator::Options{2, unbounded}};
+	std::vector<std::size_t> termsPerDepth(3, 0);
+	std::unordered_set<RtTerm> groundTerms;
+	std::size_t lastDepth = 0;
+	while ( const auto id = universe.next() ) {
+		assert(universe.depth(*id) >= lastDepth);
+		lastDepth = universe.depth(*id);
+		++termsPerDepth[lastDepth];
+		groundTerms.insert(universe.term(*id));
+	} //while ( const auto id = universe.next() )
+	assert((termsPerDepth == std::vector<std::size_t>{1, 2, 10} && groundTerms.size() == 13));
+	assert((groundTerms.count(RtTerm{RtName{"g"}, {RtTerm{RtName{"f"}, {RtTerm{RtName{"a"}}}}, RtTerm{RtName{"a"}}}})));
+	
+	HerbrandEnumerator withoutConstant{ForAll{x, lovesPred(Function{Name<'s'>{}, x})},
+	                                   HerbrandEnumerator::Options{3, unbounded}};
+	std::size_t unaryTerms = 0;
+	while ( withoutConstant.next() ) {
+		++unaryTerms;
+	} //while ( withoutConstant.next() )
+	assert((unaryTerms == 4 && withoutConstant.term(3).Args.front().Args.front().Args.front().Args.empty()));
+	
+	constexpr std::size_t herbrandTerms = 1000000;
+	HerbrandEnumerator bigUniverse{groundable, HerbrandEnumerator::Options{unbounded, herbrandTerms}};
+	const auto herbrandStart = std::chrono::steady_clock::now();
+	std::size_t enumerated = 0;
+	while ( bigUniverse.next() ) {
+		++enumerated;
+	} //while ( bigUniverse.next() )
+	const auto herbrandEnd = std::chrono::steady_clock::now();
+	assert(enumerated == herbrandTerms);
+	std::cout<<std::endl<<enumerated<<" ground terms up to depth "<<bigUniverse.depth(herbrandTerms - 1)<<": "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(herbrandEnd - herbrandStart).count()<<" us"
+	         <<std::endl;
+	
+	std::vector<RtTerm> domain;
+	for ( int i = 0; i < 4; ++i ) {
+		domain.push_back(RtTerm{RtName{"c" + std::to_string(i)}});
+	} //for ( int i = 0; i < 4; ++i )
+	domain.push_back(domain.front());
+	const RtVariable gx{"x"}, gy{"y"}, gz{"z"};
+	const auto edge = [](RtTerm t1, RtTerm t2) {
+			return RtFormula::predicate(RtName{"Edge"}, {std::move(t1), std::move(t2)});
+		};
+	const auto groundingFormula = RtFormula::conjunction({
+		RtFormula::forAll(gx, RtFormula::forAll(gy, RtFormula::disjunction({
+			RtFormula::equality(gx, gy), RtFormula::negation(edge(gx, gy)), RtFormula::exists(gz, edge(gy, gz))}))),
+		RtFormula::forAll(gx, RtFormula::forAll(gy, RtFormula::disjunction({edge(gx, gy),
+		                                                                    RtFormula::negation(edge(gy, gx))})))});
+	const Grounder serialGrounder{domain, Grounder::Options{1, 1024}};
+	assert(serialGrounder.domain().size() == 4);
+	std::unordered_set<RtFormula> serialClauses, parallelClauses;
+	const auto serialGround = serialGrounder.ground(groundingFormula, [&serialClauses](RtFormula clause) {
+			serialClauses.insert(std::move(clause));
+			return;
+		});
+	const auto parallelGround = Grounder{domain, Grounder::Options{4, 3}}.ground(groundingFormula,
+		[&parallelClauses](RtFormula clause) {
+			parallelClauses.insert(std::move(clause));
+			return;
+		});
+	assert(serialGround.Clauses == 24 && serialGround.Pruned == 8);
+	assert(parallelGround.Clauses == 24 && parallelGround.Pruned == 8);
+	assert(serialClauses.size() == 24 && serialClauses == parallelClauses);
+	assert((serialClauses.count(RtFormula::disjunction({RtFormula::equality(domain[0], domain[1]),
+	                                                    RtFormula::negation(edge(domain[0], domain[1])),
+	                                                    edge(domain[1], domain[0]), edge(domain[1], domain[1]),
+	                                                    edge(domain[1], domain[2]), edge(domain[1], domain[3])}))));
+	ClauseStore groundStore;
+	serialGrounder.ground(groundingFormula, [&groundStore](const RtFormula& clause) {
+			groundStore.add(clause);
+			return;
+		});
+	assert(groundStore.liveClauses() == 24 && groundStore.atomCount() == 28);
+	std::size_t irreflexiveClauses = 0;
+	const auto irreflexiveFormula = RtFormula::forAll(gx, RtFormula::negation(RtFormula::equality(gx, gx)));
+	const auto irreflexive = serialGrounder.ground(irreflexiveFormula,
+		[&irreflexiveClauses, &groundStore](const RtFormula& clause) {
+			groundStore.add(clause);
+			++irreflexiveClauses;
+			return;
+		});
+	assert(irreflexive.unsatisfiable() && irreflexive.EmptyClauses == 4 && irreflexive.Clauses == 0);
+	assert(irreflexiveClauses == 0 && !serialGround.unsatisfiable());
+	
+	bool unboundThrown = false, notClausalThrown = false;
+	try {
+		serialGrounder.ground(edge(gx, domain[0]), [](const RtFormula&) { return; });
+	} //try
+	catch ( const std::invalid_argument& ) {
+		unboundThrown = true;
+	} //catch ( const std::invalid_argument& )
+	try {
+		serialGrounder.ground(RtFormula::forAll(gx, RtFormula::disjunction({edge(gx, gx),
+			RtFormula::conjunction({edge(gx, domain[0]), edge(domain[0], gx)})})), [](const RtFormula&) { return; });
+	} //try
+	catch ( const std::invalid_argument& ) {
+		notClausalThrown = true;
+	} //catch ( const std::invalid_argument& )
+	assert(unboundThrown && notClausalThrown);
+	
+	std::vector<RtTerm> bigDomain;
+	for ( int i = 0; i < 1000; ++i ) {
+		bigDomain.push_back(RtTerm{RtName{"c" + std::to_string(i)}});
+	} //for ( int i = 0; i < 1000; ++i )
+	const auto reachability = RtFormula::forAll(gx, RtFormula::forAll(gy, RtFormula::disjunction({
+		RtFormula::equality(gx, gy), RtFormula::negation(edge(gx, gy)),
+		RtFormula::predicate(RtName{"Reach"}, {gx, gy})})));
+	std::cout<<std::endl<<"Grounding over "<<bigDomain.size()<<" constants:"<<std::endl;
+	for ( unsigned int threads = 1; threads <= details::defaultThreadCount(); threads = nextThreads(threads) ) {
+		std::size_t streamed = 0;
+		const auto start  = std::chrono::steady_clock::now();
+		const auto result = Grounder{bigDomain, Grounder::Options{threads, 1024}}.ground(reachability,
+			[&streamed](const RtFormula&) {
+				++streamed;
+				return;
+			});
+		const auto end    = std::chrono::steady_clock::now();
+		assert(result.Clauses == streamed && streamed == bigDomain.size() * (bigDomain.size() - 1));
+		std::cout<<threads<<" threads: "<<streamed<<" clauses in "
+		         <<std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()<<" us"<<std::endl;
+	} //for ( unsigned int threads = 1; threads <= details::defaultThreadCount(); threads = nextThreads(threads) )
+	
+	const auto unary = [](const char *name, RtTerm t) { return RtFormula::predicate(RtName{name}, {std::move(t)}); };
+	const auto nullary = RtFormula::predicate(RtName{"Q"});
+	assert((freeVariables(RtFormula::conjunction({RtFormula::forAll(gx, edge(gx, gy)), edge(gz, gx)})) ==
+	        std::vector<RtName>{RtName{"y"}, RtName{"z"}, RtName{"x"}}));
+	assert(freeVariables(formula).empty() && freeVariables(innerFormula) == std::vector<RtName>{RtName{"x"}});
+	assert(miniscoped(RtFormula::forAll(gx, nullary)) == nullary);
+	assert((miniscoped(RtFormula::forAll(gx, RtFormula::conjunction({unary("P", gx), nullary}))) ==
+	        RtFormula::conjunction({RtFormula::forAll(gx, unary("P", gx)), nullary})));
+	assert((miniscoped(RtFormula::exists(gx, RtFormula::disjunction({unary("P", gx), unary("R", gx)}))) ==
+	        RtFormula::disjunction({RtFormula::exists(gx, unary("P", gx)), RtFormula::exists(gx, unary("R", gx))})));
+	assert((miniscoped(RtFormula::forAll(gx, RtFormula::disjunction({unary("P", gx), nullary}))) ==
+	        RtFormula::disjunction({nullary, RtFormula::forAll(gx, unary("P", gx))})));
+	assert((miniscoped(RtFormula::forAll(gx, RtFormula::exists(gx, unary("P", gx)))) ==
+	        RtFormula::exists(gx, unary("P", gx))));
+	assert(miniscoped(formula) == rtFormula.toNegationNormalForm());
+	
+	const auto scoped = RtFormula::forAll(gx, RtFormula::forAll(gy, RtFormula::forAll(gz, RtFormula::conjunction({
+		edge(gx, gy), RtFormula::exists(RtVariable{"w"}, edge(gz, RtVariable{"w"}))}))));
+	const auto minimal = miniscoped(scoped);
+	assert((minimal == RtFormula::conjunction({RtFormula::forAll(gx, RtFormula::forAll(gy, edge(gx, gy))),
+		RtFormula::forAll(gz, RtFormula::exists(RtVariable{"w"}, edge(gz, RtVariable{"w"})))})));
+	assert(skolemArity(scoped) == 3 && skolemArity(minimal) == 1);
+	assert(EquivalenceChecker{}.check(scoped, minimal).V != Verdict::NotEquivalent);
+	const Grounder scopeGrounder{std::vector<RtTerm>(bigDomain.begin(), bigDomain.begin() + 20)};
+	const auto countClauses = [](const RtFormula&) { return; };
+	const auto scopedGround  = scopeGrounder.ground(scoped, countClauses);
+	const auto minimalGround = scopeGrounder.ground(minimal, countClauses);
+	assert(scopedGround.Clauses == 2 * 20 * 20 * 20 && minimalGround.Clauses == 20 * 20 + 20);
+	std::cout<<std::endl<<"Miniscoping: Skolem arity "<<skolemArity(scoped)<<" -> "<<skolemArity(minimal)
+	         <<", ground clauses over 20 constants "<<scopedGround.Clauses<<" -> "<<minimalGround.Clauses<<std::endl;
+	
+	std::size_t batchArity = 0, miniscopedArity = 0;
+	const auto miniscopeStart = std::chrono::steady_clock::now();
+	for ( const auto& f : batch ) {
+		const auto g     = miniscoped(f);
+		batchArity      += skolemArity(f);
+		miniscopedArity += skolemArity(g);
+	} //for ( const auto& f : batch )
+	const auto miniscopeEnd = std::chrono::steady_clock::now();
+	assert(miniscopedArity < batchArity);
+	std::cout<<"Miniscoping of "<<batch.size()<<" rules, Skolem arity "<<batchArity<<" -> "<<miniscopedArity<<": "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(miniscopeEnd - miniscopeStart).count()<<" us"
+	         <<std::endl;
+	
+	const RtTerm ta{RtName{"a"}}, tb{RtName{"b"}};
+	assert(subsumes(unary("P", gx), RtFormula::disjunction({unary("P", ta), nullary})));
+	assert(!subsumes(RtFormula::disjunction({unary("P", gx), unary("P", gy)}), unary("P", ta)));
+	assert(!subsumes(edge(gx, gx), edge(ta, tb)) && subsumes(edge(gx, gx), edge(tb, tb)));
+	assert(subsumes(RtFormula::equality(gx, ta), RtFormula::disjunction({nullary, RtFormula::equality(ta, tb)})));
+	assert(subsumes(RtFormula::disjunction({RtFormula::equality(gx, gy), unary("P", gy)}),
+	                RtFormula::disjunction({RtFormula::equality(ta, tb), unary("P", ta)})));
+	assert(subsumes(RtFormula::disjunction({RtFormula::equality(gx, gy), unary("P", gy)}),
+	                RtFormula::disjunction({RtFormula::equality(tb, ta), unary("P", ta)})));
+	assert(!subsumes(RtFormula::negation(unary("P", gx)), unary("P", ta)));
+	assert(subsumes(p, Or{q, p}) && !subsumes(Or{q, p}, p));
+	
+	SubsumptionIndex subsumption;
+	subsumption.add(unary("P", gx));
+	const RtTerm fx{RtName{"f"}, {gx}};
+	subsumption.add(RtFormula::disjunction({unary("Q", fx), RtFormula::negation(unary("R", gx))}));
+	subsumption.add(RtFormula::disjunction({unary("P", ta), unary("Q", tb)}));
+	assert(subsumption.findSubsuming(RtFormula::disjunction({unary("R", ta), unary("P", tb)})) == 0u);
+	assert((subsumption.findSubsumed(unary("P", gx)) == std::vector<SubsumptionIndex::ClauseId>{0, 2}));
+	assert((subsumption.findSubsumed(unary("Q", fx)) == std::vector<SubsumptionIndex::ClauseId>{1}));
+	assert(!subsumption.findSubsuming(unary("Q", RtTerm{RtName{"f"}, {ta}})));
+	assert(!subsumption.findSubsuming(unary("Unknown", ta)) && subsumption.findSubsumed(unary("Unknown", gx)).empty());
+	subsumption.remove(0);
+	assert(subsumption.findSubsuming(RtFormula::disjunction({nullary, unary("Q", tb), unary("P", ta)})) == 2u);
+	assert(!subsumption.findSubsuming(unary("P", tb)) && subsumption.liveClauses() == 2);
+	SubsumptionIndex reflexiveEdges;
+	reflexiveEdges.add(edge(gx, gx));
+	const RtTerm tc{RtName{"c"}}, td{RtName{"d"}};
+	assert(!reflexiveEdges.findSubsuming(edge(tc, td)) && !subsumes(edge(gx, gx), edge(tc, td)));
+	assert(reflexiveEdges.findSubsuming(edge(tc, tc)) == 0u);
+	
+	std::mt19937 clauseRandom{4242};
+	const auto randomClause = [&clauseRandom](void) {
+			const auto pick = [&clauseRandom](const std::size_t count) {
+					return std::uniform_int_distribution<std::size_t>{0, count - 1}(clauseRandom);
+				};
+			const auto randomTerm = [&pick](void) {
+					RtTerm t = pick(4) == 0 ? RtTerm{RtVariable{std::string(1, "xyz"[pick(3)])}} :
+					                          RtTerm{RtName{"a" + std::to_string(pick(16))}};
+					for ( auto depth = pick(4); depth > 1; --depth ) {
+						t = RtTerm{RtName{"f" + std::to_string(pick(4))}, {std::move(t)}};
+					} //for ( auto depth = pick(4); depth > 1; --depth )
+					return t;
+				};
+			std::vector<RtFormula> literals;
+			for ( auto count = pick(3) + 1; count > 0; --count ) {
+				const auto predicate = pick(64);
+				std::vector<RtTerm> args;
+				for ( auto arity = predicate % 2 + 1; arity > 0; --arity ) {
+					args.push_back(randomTerm());
+				} //for ( auto arity = predicate % 2 + 1; arity > 0; --arity )
+				auto atom = RtFormula::predicate(RtName{"P" + std::to_string(predicate)}, std::move(args));
+				literals.push_back(pick(2) == 0 ? RtFormula::negation(std::move(atom)) : std::move(atom));
+			} //for ( auto count = pick(3) + 1; count > 0; --count )
+			return literals.size() == 1 ? std::move(literals.front()) : RtFormula::disjunction(std::move(literals));
+		};
+	
+	constexpr std::size_t indexedClauses = 1000000, subsumptionQueries = 200, linearQueries = 10;
+	SubsumptionIndex featureIndex, linearIndex{SubsumptionIndex::Options{0}};
+	const auto indexStart = std::chrono::steady_clock::now();
+	for ( std::size_t i = 0; i < indexedClauses; ++i ) {
+		const auto c = randomClause();
+		featureIndex.add(c);
+		linearIndex.add(c);
+	} //for ( std::size_t i = 0; i < indexedClauses; ++i )
+	const auto indexEnd  = std::chrono::steady_clock::now();
+	const auto indexTime = std::chrono::duration_cast<std::chrono::milliseconds>(indexEnd - indexStart).count();
+	std::vector<RtFormula> subsumptionQuerySet;
+	for ( std::size_t i = 0; i < subsumptionQueries; ++i ) {
+		subsumptionQuerySet.push_back(randomClause());
+	} //for ( std::size_t i = 0; i < subsumptionQueries; ++i )
+	
+	std::size_t forwardHits = 0, backwardHits = 0;
+	const auto forwardStart = std::chrono::steady_clock::now();
+	for ( const auto& c : subsumptionQuerySet ) {
+		forwardHits += featureIndex.findSubsuming(c) ? 1u : 0u;
+	} //for ( const auto& c : subsumptionQuerySet )
+	const auto backwardStart = std::chrono::steady_clock::now();
+	for ( const auto& c : subsumptionQuerySet ) {
+		backwardHits += featureIndex.findSubsumed(c).size();
+	} //for ( const auto& c : subsumptionQuerySet )
+	const auto backwardEnd = std::chrono::steady_clock::now();
+	
+	auto linearForward = backwardEnd - backwardEnd, linearBackward = linearForward;
+	for ( std::size_t i = 0; i < linearQueries; ++i ) {
+		const auto& c     = subsumptionQuerySet[i];
+		const auto start  = std::chrono::steady_clock::now();
+		const auto linear = linearIndex.findSubsuming(c);
+		const auto middle = std::chrono::steady_clock::now();
+		const auto all    = linearIndex.findSubsumed(c);
+		linearForward  += middle - start;
+		linearBackward += std::chrono::steady_clock::now() - middle;
+		assert(linear.has_value() == featureIndex.findSubsuming(c).has_value());
+		assert(all == featureIndex.findSubsumed(c));
+	} //for ( std::size_t i = 0; i < linearQueries; ++i )
+	const auto perQuery = [](const auto duration, const std::size_t queries) {
+			return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() /
+			       static_cast<long long>(queries);
+		};
+	std::cout<<std::endl<<"Subsumption index of "<<indexedClauses<<" clauses, "<<featureIndex.trieNodes()
+	         <<" trie nodes, built in "<<indexTime<<" ms"<<std::endl<<"Forward query: "
+	         <<perQuery(backwardStart - forwardStart, subsumptionQueries)
+	         <<" us indexed, "<<perQuery(linearForward, linearQueries)<<" us linear, "<<forwardHits<<" of "
+	         <<subsumptionQueries<<" subsumed"<<std::endl<<"Backward query: "
+	         <<perQuery(backwardEnd - backwardStart, subsumptionQueries)<<" us indexed, "
+	         <<perQuery(linearBackward, linearQueries)<<" us linear, "<<backwardHits<<" subsumed clauses"<<std::endl;
+	
+	const auto fApply = [](RtTerm t) { return RtTerm{RtName{"f"}, {std::move(t)}}; };
+	CongruenceClosure closure;
+	const auto fa = closure.add(fApply(ta)), fb = closure.add(fApply(tb));
+	assert(closure.size() == 4 && !closure.equal(fa, fb));
+	closure.push();
+	closure.merge(ta, tb);
+	assert(closure.equal(fa, fb) && closure.equal(fApply(fApply(ta)), fApply(fApply(tb))) && closure.level() == 1);
+	closure.pop();
+	assert(!closure.equal(fa, fb) && closure.size() == 4 && closure.level() == 0);
+	closure.merge(fApply(fApply(fApply(ta))), ta);
+	closure.merge(fApply(fApply(fApply(fApply(fApply(ta))))), ta);
+	assert(closure.equal(fa, closure.add(ta)) && !closure.equal(fb, closure.add(tb)));
+	closure.merge(Equality{Function{Name<'c'>{}}, Function{Name<'d'>{}}});
+	assert(closure.equal(RtTerm{RtName{"g"}, {RtTerm{RtName{"c"}}}}, RtTerm{RtName{"g"}, {RtTerm{RtName{"d"}}}}));
+	assert(!closure.equal(RtTerm{RtName{"g"}, {RtTerm{RtName{"c"}}}}, RtTerm{RtName{"g"}, {ta}}));
+	bool variableThrown = false;
+	try {
+		closure.add(gx);
+	} //try
+	catch ( const std::invalid_argument& ) {
+		variableThrown = true;
+	} //catch ( const std::invalid_argument& )
+	assert(variableThrown);
+	
+	constexpr std::size_t chainLength = 200000;
+	CongruenceClosure chain;
+	std::vector<CongruenceClosure::TermId> chainConstants, chainApplications;
+	for ( std::size_t i = 0; i < chainLength; ++i ) {
+		const RtTerm constant{RtName{"c" + std::to_string(i)}};
+		chainConstants.push_back(chain.add(constant));
+		chainApplications.push_back(chain.add(RtTerm{RtName{"g"}, {fApply(constant), constant}}));
+	} //for ( std::size_t i = 0; i < chainLength; ++i )
+	chain.push();
+	const auto chainStart = std::chrono::steady_clock::now();
+	for ( std::size_t i = 1; i < chainLength; ++i ) {
+		chain.merge(chainConstants[i - 1], chainConstants[i]);
+	} //for ( std::size_t i = 1; i < chainLength; ++i )
+	const auto chainEnd = std::chrono::steady_clock::now();
+	assert(chain.merges() == 3 * (chainLength - 1));
+	assert(chain.equal(chainApplications.front(), chainApplications.back()));
+	chain.pop();
+	const auto chainPopped = std::chrono::steady_clock::now();
+	assert(!chain.equal(chainApplications.front(), chainApplications.back()));
+	const auto chainTime = std::chrono::duration_cast<std::chrono::microseconds>(chainEnd - chainStart).count();
+	std::cout<<std::endl<<"Congruence closure of a chain of "<<chainLength<<" constants: "<<chain.merges()
+	         <<" merges in "<<chainTime<<" us, "<<static_cast<long long>(chain.merges()) * 1000000 / chainTime
+	         <<" merges per second, backtracked in "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(chainPopped - chainEnd).count()<<" us"<<std::endl;
+	
+	constexpr auto r = Predicate{Name<'r'>{}};
+	//A time limit no test reaches, so the exact results do not depend on the speed of the machine.
+	const EGraph::Options untimed{10000, 32, std::chrono::hours{1}};
+	const auto saturatedUntimed = [&untimed](const auto& f, const EGraph::Cost model = EGraph::Cost::Size) {
+			return saturated(f, model, untimed);
+		};
+	assert(saturatedUntimed(And{p, Or{p, q}}) == toRuntime(p));
+	assert(saturatedUntimed(Equivalent{p, q}) == toRuntime(Equivalent{p, q}));
+	assert(saturatedUntimed(ForAll{x, Or{Equality{x, x}, lovesPred(x)}}) == RtFormula::constant(true));
+	assert(countNodes(saturatedUntimed(Not{And{Not{p}, Not{q}}})) == 3);
+	assert(countNodes(saturatedUntimed(Or{And{p, q}, And{r, p}})) == 5);
+	assert(countNodes(saturatedUntimed(And{ForAll{x, lovesPred(x)}, ForAll{x, Implies{p, lovesPred(x, x)}}})) == 6);
+	assert(saturatedUntimed(ForAll{x, Not{lovesPred(x)}}, EGraph::Cost::Size).K == RtFormula::Kind::ForAll);
+	assert(saturatedUntimed(ForAll{x, Not{lovesPred(x)}}, EGraph::Cost::Evaluation).K == RtFormula::Kind::Not);
+	EGraph tautology{untimed};
+	const auto tautologyRoot = tautology.add(Implies{And{p, q}, Or{q, r}});
+	assert(tautology.saturate().Reason == EGraph::StopReason::Saturated);
+	assert(tautology.extract(tautologyRoot) == RtFormula::constant(true));
+	EGraph pending;
+	const auto pendingRoot = pending.add(And{p, q});
+	pending.merge(pending.add(p), pending.add(q));
+	bool pendingThrown = false;
+	try {
+		pending.extract(pendingRoot);
+	} //try
+	catch ( const std::logic_error& ) {
+		pendingThrown = true;
+	} //catch ( const std::logic_error& )
+	pending.rebuild();
+	assert(pendingThrown && countNodes(pending.extract(pendingRoot)) == 3);
+	EGraph limited{EGraph::Options{200, 32, std::chrono::seconds{10}}};
+	const auto limitedInput = propositionalFormula(6, 64);
+	const auto limitedRoot  = limited.add(limitedInput);
+	assert(limited.saturate().Reason == EGraph::StopReason::NodeLimit);
+	assert((areEquivalent(limited.extract(limitedRoot), limitedInput).V == Verdict::Equivalent));
+	
+	std::vector<RtFormula> saturationCorpus;
+	std::apply([&saturationCorpus](const auto&... forms) {
+			(saturationCorpus.push_back(toRuntime(forms)), ...);
+			return;
+		}, corpus);
+	for ( std::size_t leaves = 8; leaves <= 128; leaves *= 2 ) {
+		saturationCorpus.push_back(propositionalFormula(6, leaves));
+	} //for ( std::size_t leaves = 8; leaves <= 128; leaves *= 2 )
+	saturationCorpus.insert(saturationCorpus.end(), batch.begin(), batch.begin() + 50);
+	saturationCorpus.push_back(shared);
+	
+	std::size_t saturationInput = 0, simplifiedOutput = 0, saturatedOutput = 0;
+	std::vector<RtFormula> simplifiedForms, saturatedForms;
+	const auto simplifyStart = std::chrono::steady_clock::now();
+	for ( const auto& f : saturationCorpus ) {
+		simplifiedForms.push_back(f.simplified());
+	} //for ( const auto& f : saturationCorpus )
+	const auto saturateStart = std::chrono::steady_clock::now();
+	for ( const auto& f : saturationCorpus ) {
+		saturatedForms.push_back(saturated(f));
+	} //for ( const auto& f : saturationCorpus )
+	const auto saturateEnd = std::chrono::steady_clock::now();
+	EquivalenceChecker saturationChecker;
+	for ( std::size_t i = 0; i < saturationCorpus.size(); ++i ) {
+		saturationInput  += countNodes(saturationCorpus[i]);
+		simplifiedOutput += countNodes(simplifiedForms[i]);
+		saturatedOutput  += countNodes(saturatedForms[i]);
+		assert(countNodes(saturatedForms[i]) <= countNodes(saturationCorpus[i]));
+		assert((saturationChecker.check(saturationCorpus[i], saturatedForms[i]).V != Verdict::NotEquivalent));
+	} //for ( std::size_t i = 0; i < saturationCorpus.size(); ++i )
+	std::cout<<std::endl<<"Simplification of "<<saturationCorpus.size()<<" formulas with "<<saturationInput
+	         <<" nodes:"<<std::endl<<"simplified(): "<<simplifiedOutput<<" nodes in "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(saturateStart - simplifyStart).count()<<" us"
+	         <<std::endl<<"saturated():  "<<saturatedOutput<<" nodes in "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(saturateEnd - saturateStart).count()<<" us"
+	         <<std::endl;
+	
+	const auto commutedRuntime = RtFormula::conjunction({toRuntime(Or{q, p}), toRuntime(lovesPred(y)),
+	                                                     toRuntime(Or{p, q, False{}})});
+	assert(commutedRuntime.simplified() == toRuntime(And{Or{q, p}, lovesPred(y)}.simplified()));
+	assert(dag.toFormula(dag.simplified(dag.add(commutedRuntime))) == commutedRuntime.simplified());
+	std::vector<RtFormula> literals{toRuntime(p), toRuntime(Not{q}), toRuntime(r), toRuntime(lovesPred(x))};
+	std::sort(literals.begin(), literals.end());
+	assert((literals.front() == toRuntime(p) && literals.back() == toRuntime(lovesPred(x))));
+	std::set<RtFormula> commutedShapes, canonicalShapes;
+	do {
+		const auto disjunction = RtFormula::disjunction(literals);
+		commutedShapes.insert(disjunction);
+		canonicalShapes.insert(disjunction.simplified());
+	} while ( std::next_permutation(literals.begin(), literals.end()) );
+	assert(commutedShapes.size() == 24 && canonicalShapes.size() == 1);
+	std::cout<<std::endl<<"Commuted disjunctions: "<<commutedShapes.size()<<" shapes, "<<canonicalShapes.size()
+	         <<" after simplified()"<<std::endl;
+	
+	assert((AndN<std::decay_t<decltype(p)>>{p, p, p}.simplified().size() == 1));
+	assert((AndN<True>{True{}, True{}}.simplified().size() == 0 && OrN<True>{True{}, True{}}.simplified().size() == 1));
+	using GroundAtom = Predicate<Name<'P'>, Function<RtName>>;
+	const auto groundAtom = [](const std::size_t i) {
+			return GroundAtom{Name<'P'>{}, Function{RtName{"c" + std::to_string(i)}}};
+		};
+	const AndN<GroundAtom> smallConjunction{groundAtom(2), groundAtom(1), groundAtom(2)};
+	assert(smallConjunction.simplified() == smallConjunction);
+	assert(toRuntime(smallConjunction.negate()) == toRuntime(smallConjunction).negate());
+	assert(toRuntime(smallConjunction.negate().negate()) == toRuntime(smallConjunction));
+	std::ostringstream homogeneousText, runtimeText;
+	homogeneousText<<smallConjunction<<" / "<<OrN<GroundAtom>{}<<" / "<<PrettyPrinter{smallConjunction.negate(), 0};
+	runtimeText<<toRuntime(smallConjunction)<<" / "<<False{}<<" / ("<<toRuntime(smallConjunction.negate())<<')';
+	assert(homogeneousText.str() == runtimeText.str());
+	const auto conjunctionUsage = memoryUsage(smallConjunction);
+	assert(conjunctionUsage.InlineBytes == sizeof(smallConjunction) && conjunctionUsage.nodes() == 4);
+	assert(conjunctionUsage.HeapBytes == smallConjunction.ts.capacity() * sizeof(GroundAtom));
+	assert(conjunctionUsage.SharedBytes == sizeof(GroundAtom));
+	
+	OrN<Not<GroundAtom>, SmallVector<Not<GroundAtom>, 4>> smallClause;
+	for ( std::size_t i = 0; i < 4; ++i ) {
+		smallClause.ts.push_back(Not<GroundAtom>{groundAtom(i)});
+	} //for ( std::size_t i = 0; i < 4; ++i )
+	const auto inlineClause = smallClause;
+	assert(memoryUsage(inlineClause).HeapBytes == 0);
+	smallClause.ts.push_back(smallClause.ts.front());
+	assert(inlineClause.ts.isInline() && !smallClause.ts.isInline() && smallClause.ts.back() == inlineClause.ts[0]);
+	assert(smallClause.negate().ts.isInline() == false && inlineClause.negate().ts.isInline());
+	assert(toRuntime(inlineClause.negate()) == toRuntime(inlineClause).negate());
+	
+	constexpr std::size_t homogeneousOperands = 10000;
+	AndN<GroundAtom> groundConjunction;
+	groundConjunction.ts.reserve(homogeneousOperands);
+	for ( std::size_t i = 0; i < homogeneousOperands; ++i ) {
+		groundConjunction.ts.push_back(groundAtom(i));
+	} //for ( std::size_t i = 0; i < homogeneousOperands; ++i )
+	const auto runtimeConjunction = toRuntime(groundConjunction);
+	const auto homogeneousStart   = std::chrono::steady_clock::now();
+	const auto homogeneousNegated = groundConjunction.negate();
+	const auto homogeneousNnf     = groundConjunction.toNegationNormalForm();
+	const auto runtimeStart       = std::chrono::steady_clock::now();
+	const auto runtimeNegated     = runtimeConjunction.negate();
+	const auto runtimeNnf         = runtimeConjunction.toNegationNormalForm();
+	const auto runtimeEnd         = std::chrono::steady_clock::now();
+	//Not the same work: AndN does not compare operands with runtime names, RtFormula removes duplicates pairwise.
+	const auto homogeneousSimple  = groundConjunction.simplified();
+	const auto runtimeSimpleStart = std::chrono::steady_clock::now();
+	const auto runtimeSimple      = runtimeConjunction.simplified();
+	const auto runtimeSimpleEnd   = std::chrono::steady_clock::now();
+	assert(homogeneousSimple.size() == homogeneousOperands && runtimeSimple.Children.size() == homogeneousOperands);
+	assert(toRuntime(homogeneousNegated) == runtimeNegated && toRuntime(homogeneousNnf) == runtimeNnf);
+	std::cout<<std::endl<<"Conjunction of "<<homogeneousOperands<<" ground atoms, negated and NNF: "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(runtimeStart - homogeneousStart).count()
+	         <<" us as AndN, "<<std::chrono::duration_cast<std::chrono::microseconds>(runtimeEnd - runtimeStart).count()
+	         <<" us as RtFormula ("<<sizeof(GroundAtom)<<" against "<<sizeof(RtFormula)<<" bytes per operand)"
+	         <<std::endl
+	         <<"Simplified: "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(runtimeSimpleStart - runtimeEnd).count()
+	         <<" us as AndN, which skips the deduplication of operands with runtime names, "
+	         <<std::chrono::duration_cast<std::chrono::microseconds>(runtimeSimpleEnd - runtimeSimpleStart).count()
+	         <<" us as RtFormula, which deduplicates pairwise"<<std::endl;
+	
+	constexpr auto edgeAtom        = [](auto t1, auto t2) { return Predicate{Name<'E'>{}, t1, t2}; };
+	constexpr auto pathAtom        = [](auto t1, auto t2) { return Predicate{Name<'T'>{}, t1, t2}; };
+	constexpr auto nodeAtom        = [](auto t) { return Predicate{Name<'N'>{}, t}; };
+	constexpr auto unreachableAtom = [](auto t1, auto t2) { return Predicate{Name<'U'>{}, t1, t2}; };
+	const auto addClosure = [&](DatalogEngine& engine) {
+			engine.add(ForAll{x, ForAll{y, Implies{edgeAtom(x, y), pathAtom(x, y)}}});
+			engine.add(ForAll{x, ForAll{y, ForAll{z, Implies{And{pathAtom(x, y), edgeAtom(y, z)}, pathAtom(x, z)}}}});
+			return;
+		};
+	
+	DatalogEngine smallProgram;
+	addClosure(smallProgram);
+	smallProgram.add(ForAll{x, ForAll{y, Implies{And{nodeAtom(x), nodeAtom(y), Not{pathAtom(x, y)}},
+	                                             unreachableAtom(x, y)}}});
+	smallProgram.add(edgeAtom(Function{Name<'a'>{}}, Function{Name<'b'>{}}));
+	smallProgram.addFact(RtName{"E"}, {RtName{"b"}, RtName{"c"}});
+	smallProgram.addFact(RtName{"E"}, {RtName{"d"}, RtName{"d"}});
+	for ( const char node : {'a', 'b', 'c', 'd'} ) {
+		smallProgram.addFact(RtName{"N"}, {RtName{node}});
+	} //for ( const char node : {'a', 'b', 'c', 'd'} )
+	const auto smallReport = smallProgram.evaluate();
+	assert(smallReport.Strata == 2 && smallReport.Derived == 4 + 12);
+	assert(smallProgram.size(RtName{"T"}) == 4 && smallProgram.size(RtName{"U"}) == 12);
+	assert(smallProgram.contains(pathAtom(Function{Name<'a'>{}}, Function{Name<'c'>{}})));
+	assert(!smallProgram.contains(pathAtom(Function{Name<'c'>{}}, Function{Name<'a'>{}})));
+	assert(smallProgram.contains(unreachableAtom(Function{Name<'c'>{}}, Function{Name<'a'>{}})));
+	assert(!smallProgram.contains(unreachableAtom(Function{Name<'d'>{}}, Function{Name<'d'>{}})));
+	assert(smallProgram.facts(RtName{"T"}).front() ==
+	       toRuntime(pathAtom(Function{Name<'a'>{}}, Function{Name<'b'>{}})));
+	
+	bool unstratifiedThrown = false, unrestrictedThrown = false, evaluatedThrown = false;
+	DatalogEngine unstratifiedProgram;
+	unstratifiedProgram.add(ForAll{x, Implies{And{nodeAtom(x), Not{pathAtom(x, x)}}, pathAtom(x, x)}});
+	try {
+		unstratifiedProgram.evaluate();
+	} //try
+	catch ( const std::invalid_argument& ) {
+		unstratifiedThrown = true;
+	} //catch ( const std::invalid_argument& )
+	try {
+		smallProgram.add(ForAll{x, Implies{Not{nodeAtom(x)}, nodeAtom(x)}});
+	} //try
+	catch ( const std::logic_error& ) {
+		evaluatedThrown = true;
+	} //catch ( const std::logic_error& )
+	try {
+		DatalogEngine{}.add(ForAll{x, ForAll{y, Implies{nodeAtom(x), pathAtom(x, y)}}});
+	} //try
+	catch ( const std::invalid_argument& ) {
+		unrestrictedThrown = true;
+	} //catch ( const std::invalid_argument& )
+	assert(unstratifiedThrown && unrestrictedThrown && evaluatedThrown);
+	
+	constexpr std::size_t closureNodes = 300;
+	DatalogEngine semiNaiveClosure, naiveClosure{DatalogEngine::Options{false}};
+	for ( auto engine : {&semiNaiveClosure, &naiveClosure} ) {
+		addClosure(*engine);
+		for ( std::size_t i = 1; i < closureNodes; ++i ) {
+			engine->addFact(RtName{"E"}, {RtName{"n" + std::to_string(i - 1)}, RtName{"n" + std::to_string(i)}});
+		} //for ( std::size_t i = 1; i < closureNodes; ++i )
+	} //for ( auto engine : {&semiNaiveClosure, &naiveClosure} )
+	const auto closureStart      = std::chrono::steady_clock::now();
+	const auto semiNaiveReport   = semiNaiveClosure.evaluate();
+	const auto closureNaiveStart = std::chrono::steady_clock::now();
+	const auto naiveReport       = naiveClosure.evaluate();
+	const auto closureEnd        = std::chrono::steady_clock::now();
+	assert(semiNaiveClosure.size(RtName{"T"}) == closureNodes * (closureNodes - 1) / 2);
+	assert(naiveClosure.size(RtName{"T"}) == semiNaiveClosure.size(RtName{"T"}));
+	assert(semiNaiveReport.Iterations == naiveReport.Iterations);
+	std::cout<<std::endl<<"Transitive closure of a chain of "<<closureNodes<<" nodes: "
+	         <<semiNaiveClosure.size(RtName{"T"})<<" paths in "<<semiNaiveReport.Iterations<<" iterations, "
+	         <<std::chrono::duration_cast<std::chrono::milliseconds>(closureNaiveStart - closureStart).count()
+	         <<" ms semi-naive, "
+	         <<std::chrono::duration_cast<std::chrono::milliseconds>(closureEnd - closureNaiveStart).count()
+	         <<" ms naive"<<std::endl;
+	
+	//Andersen style points-to analysis: v = new o, v = w, x.f = y, and x = y.f.
+	constexpr auto newAtom     = [](auto t1, auto t2) { return Predicate{Name<'N', 'e', 'w'>{}, t1, t2}; };
+	constexpr auto assignAtom  = [](auto t1, auto t2) {
+			return Predicate{Name<'A', 's', 's', 'i', 'g', 'n'>{}, t1, t2};
+		};
+	constexpr auto storeAtom   = [](auto t1, auto t2, auto t3) {
+			return Predicate{Name<'S', 't', 'o', 'r', 'e'>{}, t1, t2, t3};
+		};
+	constexpr auto loadAtom    = [](auto t1, auto t2, auto t3) {
+			return Predicate{Name<'L', 'o', 'a', 'd'>{}, t1, t2, t3};
+		};
+	constexpr auto pointsAtom  = [](auto t1, auto t2) { return Predicate{Name<'P', 't'>{}, t1, t2}; };
+	constexpr auto heapAtom    = [](auto t1, auto t2, auto t3) { return Predicate{Name<'H', 'p', 't'>{}, t1, t2, t3}; };
+	constexpr auto varAtom     = [](auto t) { return Predicate{Name<'V', 'a', 'r'>{}, t}; };
+	constexpr auto pointerAtom = [](auto t) { return Predicate{Name<'P', 'o', 'i', 'n', 't', 'e', 'r'>{}, t}; };
+	constexpr auto unsetAtom   = [](auto t) { return Predicate{Name<'U', 'n', 's', 'e', 't'>{}, t}; };
+	constexpr auto o = Variable<'o'>{};
+	constexpr auto f = Variable<'f'>{};
+	constexpr auto w = Variable<'w'>{};
+	
+	constexpr std::size_t pointsToVariables = 4000, pointsToObjects = 400, pointsToFields = 4;
+	std::mt19937 pointsToRandom{2024};
+	std::uniform_int_distribution<std::size_t> randomVariable{0, pointsToVariables - 1};
+	std::uniform_int_distribution<std::size_t> randomField{0, pointsToFields - 1};
+	const auto variableName = [](const std::size_t i) { return RtName{"v" + std::to_string(i)}; };
+	std::vector<std::pair<RtName, std::vector<RtName>>> pointsToFacts;
+	for ( std::size_t i = 0; i < pointsToVariables; ++i ) {
+		pointsToFacts.push_back({RtName{"Var"}, {variableName(i)}});
+	} //for ( std::size_t i = 0; i < pointsToVariables; ++i )
+	for ( std::size_t i = 0; i < pointsToObjects; ++i ) {
+		pointsToFacts.push_back({RtName{"New"}, {variableName(randomVariable(pointsToRandom)),
+		                                         RtName{"o" + std::to_string(i)}}});
+	} //for ( std::size_t i = 0; i < pointsToObjects; ++i )
+	for ( std::size_t i = 0; i < pointsToVariables; ++i ) {
+		pointsToFacts.push_back({RtName{"Assign"}, {variableName(randomVariable(pointsToRandom)),
+		                                            variableName(randomVariable(pointsToRandom))}});
+	} //for ( std::size_t i = 0; i < pointsToVariables; ++i )
+	for ( std::size_t i = 0; i < pointsToVariables / 8; ++i ) {
+		const auto field = RtName{"f" + std::to_string(randomField(pointsToRandom))};
+		pointsToFacts.push_back({RtName{"Store"}, {variableName(randomVariable(pointsToRandom)), field,
+		                                           variableName(randomVariable(pointsToRandom))}});
+		pointsToFacts.push_back({RtName{"Load"}, {variableName(randomVariable(pointsToRandom)),
+		                                          variableName(randomVariable(pointsToRandom)), field}});
+	} //for ( std::size_t i = 0; i < pointsToVariables / 8; ++i )
+	
+	DatalogEngine semiNaivePointsTo, naivePointsTo{DatalogEngine::Options{false}};
+	for ( auto engine : {&semiNaivePointsTo, &naivePointsTo} ) {
+		engine->add(ForAll{x, ForAll{o, Implies{newAtom(x, o), pointsAtom(x, o)}}});
+		engine->add(ForAll{x, ForAll{w, ForAll{o, Implies{And{assignAtom(x, w), pointsAtom(w, o)},
+		                                                  pointsAtom(x, o)}}}});
+		engine->add(ForAll{x, ForAll{f, ForAll{y, ForAll{z, ForAll{o, Implies{
+			And{storeAtom(x, f, y), pointsAtom(x, z), pointsAtom(y, o)}, heapAtom(z, f, o)}}}}}});
+		engine->add(ForAll{x, ForAll{y, ForAll{f, ForAll{z, ForAll{o, Implies{
+			And{loadAtom(x, y, f), pointsAtom(y, z), heapAtom(z, f, o)}, pointsAtom(x, o)}}}}}});
+		engine->add(ForAll{x, ForAll{o, Implies{pointsAtom(x, o), pointerAtom(x)}}});
+		engine->add(ForAll{x, Implies{And{varAtom(x), Not{pointerAtom(x)}}, unsetAtom(x)}});
+		for ( const auto& [relation, args] : pointsToFacts ) {
+			engine->addFact(relation, args);
+		} //for ( const auto& [relation, args] : pointsToFacts )
+	} //for ( auto engine : {&semiNaivePointsTo, &naivePointsTo} )
+	const auto pointsToStart      = std::chrono::steady_clock::now();
+	const auto pointsToReport     = semiNaivePointsTo.evaluate();
+	const auto pointsToNaiveStart = std::chrono::steady_clock::now();
+	naivePointsTo.evaluate();
+	const auto pointsToEnd        = std::chrono::steady_clock::now();
+	assert(pointsToReport.Strata == 2);
+	for ( const auto relation : {"Pt", "Hpt", "Unset"} ) {
+		assert(semiNaivePointsTo.size(RtName{relation}) == naivePointsTo.size(RtName{relation}));
+	} //for ( const auto relation : {"Pt", "Hpt", "Unset"} )
+	assert(semiNaivePointsTo.size(RtName{"Pointer"}) + semiNaivePointsTo.size(RtName{"Unset"}) == pointsToVariables);
+	std::cout<<"Points-to analysis of "<<pointsToFacts.size()<<" facts: "<<semiNaivePointsTo.size(RtName{"Pt"})
+	         <<" points-to and "<<semiNaivePointsTo.size(RtName{"Hpt"})<<" heap facts in "<<pointsToReport.Iterations
+	         <<" iterations, "
+	         <<std::chrono::duration_cast<std::chrono::milliseconds>(pointsToNaiveStart - pointsToStart).count()
+	         <<" ms semi-naive, "
+	         <<std::chrono::duration_cast<std::chrono::milliseconds>(pointsToEnd - pointsToNaiveStart).count()
+	         <<" ms naive"<<std::endl;
 	return 0;
 }
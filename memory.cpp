@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks memory.hpp for self-containment.
+ * 
+ */
+
+#include "memory.hpp"
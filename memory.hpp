@@ -0,0 +1,369 @@
+/**
+ * @file
+ * @brief Contains the memory accounting of formulas and rule bases.
+ */
+
+#ifndef FOL_MEMORY_HPP
+#define FOL_MEMORY_HPP
+
+#include "name.hpp"
+#include "rt_formula.hpp"
+#include "small_vector.hpp"
+#include "traits.hpp"
+#include "visit.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace fol {
+
+/**
+ * @brief The memory of one formula or a whole rule base.
+ *
+ * Inline bytes are the objects themselves, heap bytes everything they own: child and term vectors (with their unused
+ * capacity) and names not fitting into the small string buffer. Shared bytes are those of subformulas equal to an
+ * earlier one, that is what a FormulaDag would not have to store again.
+ */
+struct MemoryUsage {
+	static constexpr std::size_t KindCount = static_cast<std::size_t>(RtFormula::Kind::False) + 1;
+	
+	std::size_t Formulas    = 0;
+	std::size_t Terms       = 0;
+	std::size_t InlineBytes = 0;
+	std::size_t HeapBytes   = 0;
+	std::size_t SharedBytes = 0;
+	std::array<std::size_t, KindCount> Nodes{};
+	
+	std::size_t bytes(void) const noexcept {
+		return InlineBytes + HeapBytes;
+	}
+	
+	std::size_t uniqueBytes(void) const noexcept {
+		return bytes() - SharedBytes;
+	}
+	
+	std::size_t nodes(void) const noexcept {
+		return std::accumulate(Nodes.begin(), Nodes.end(), std::size_t{0});
+	}
+	
+	std::size_t nodes(const RtFormula::Kind k) const noexcept {
+		return Nodes[static_cast<std::size_t>(k)];
+	}
+	
+	/**
+	 * @brief Adds the usage of another formula, sharing between the two is not detected.
+	 */
+	MemoryUsage& operator+=(const MemoryUsage& m) noexcept {
+		Formulas    += m.Formulas;
+		Terms       += m.Terms;
+		InlineBytes += m.InlineBytes;
+		HeapBytes   += m.HeapBytes;
+		SharedBytes += m.SharedBytes;
+		for ( std::size_t kind = 0; kind < KindCount; ++kind ) {
+			Nodes[kind] += m.Nodes[kind];
+		} //for ( std::size_t kind = 0; kind < KindCount; ++kind )
+		return *this;
+	}
+	
+	/**
+	 * @brief Prints a capacity planning report.
+	 */
+	friend std::ostream& operator<<(std::ostream& os, const MemoryUsage& m) {
+		constexpr std::array<const char*, KindCount> kindNames{"Predicate", "Equality", "Not", "And", "Or", "Implies",
+		                                                        "Equivalent", "Exists", "ForAll", "True", "False"};
+		const auto percent = [&m](const std::size_t bytes) noexcept {
+				return m.bytes() == 0 ? 0.0 : 100.0 * static_cast<double>(bytes) / static_cast<double>(m.bytes());
+			};
+		
+		os<<"Formulas:     "<<m.Formulas<<std::endl
+		  <<"Nodes:        "<<m.nodes()<<" (";
+		const char *delimiter = "";
+		for ( std::size_t kind = 0; kind < KindCount; ++kind ) {
+			if ( m.Nodes[kind] != 0 ) {
+				os<<delimiter<<kindNames[kind]<<' '<<m.Nodes[kind];
+				delimiter = ", ";
+			} //if ( m.Nodes[kind] != 0 )
+		} //for ( std::size_t kind = 0; kind < KindCount; ++kind )
+		const auto flags = os.flags();
+		os<<')'<<std::endl
+		  <<"Terms:        "<<m.Terms<<std::endl
+		  <<"Inline bytes: "<<m.InlineBytes<<std::endl
+		  <<"Heap bytes:   "<<m.HeapBytes<<std::endl
+		  <<"Total bytes:  "<<m.bytes()<<std::endl<<std::fixed<<std::setprecision(1)
+		  <<"Shared bytes: "<<m.SharedBytes<<" ("<<percent(m.SharedBytes)<<"%)"<<std::endl
+		  <<"Unique bytes: "<<m.uniqueBytes()<<" ("<<percent(m.uniqueBytes())<<"%)"<<std::endl;
+		os.flags(flags);
+		return os;
+	}
+};
+
+namespace details {
+inline std::size_t heapBytes(const RtName& name) noexcept {
+	const auto& string = name.string();
+	return string.capacity() > std::string{}.capacity() ? string.capacity() + 1 : 0;
+}
+
+/**
+ * @brief Walks the formulas bottom up, hashing every subformula once to find the repeated ones.
+ */
+class MemoryAccounting {
+	MemoryUsage Usage;
+	std::unordered_multimap<std::size_t, const RtFormula*> Seen;
+	
+	struct Subformula {
+		std::size_t Hash;
+		std::size_t Bytes;
+		std::size_t SharedBytes;
+	};
+	
+	std::size_t termBytes(const RtTerm& t) noexcept {
+		++Usage.Terms;
+		std::size_t ret = heapBytes(t.Name) + t.Args.capacity() * sizeof(RtTerm);
+		for ( const auto& arg : t.Args ) {
+			ret += termBytes(arg);
+		} //for ( const auto& arg : t.Args )
+		return ret;
+	}
+	
+	Subformula visit(const RtFormula& f) {
+		++Usage.Nodes[static_cast<std::size_t>(f.K)];
+		Subformula ret{static_cast<std::size_t>(f.K),
+		               sizeof(RtFormula) + (f.Children.capacity() - f.Children.size()) * sizeof(RtFormula) +
+		               f.Terms.capacity() * sizeof(RtTerm), 0};
+		if ( f.N ) {
+			ret.Hash   = hashCombine(ret.Hash, std::hash<RtName>{}(*f.N));
+			ret.Bytes += heapBytes(*f.N);
+		} //if ( f.N )
+		for ( const auto& term : f.Terms ) {
+			ret.Hash   = hashCombine(ret.Hash, std::hash<RtTerm>{}(term));
+			ret.Bytes += termBytes(term);
+		} //for ( const auto& term : f.Terms )
+		for ( const auto& child : f.Children ) {
+			const auto sub   = visit(child);
+			ret.Hash         = hashCombine(ret.Hash, sub.Hash);
+			ret.Bytes       += sub.Bytes;
+			ret.SharedBytes += sub.SharedBytes;
+		} //for ( const auto& child : f.Children )
+		
+		for ( auto [iter, end] = Seen.equal_range(ret.Hash); iter != end; ++iter ) {
+			if ( *iter->second == f ) {
+				ret.SharedBytes = ret.Bytes;
+				return ret;
+			} //if ( *iter->second == f )
+		} //for ( auto [iter, end] = Seen.equal_range(ret.Hash); iter != end; ++iter )
+		Seen.emplace(ret.Hash, &f);
+		return ret;
+	}
+	
+	public:
+	/**
+	 * @brief Accounts a formula, which has to outlive the accounting.
+	 */
+	void add(const RtFormula& f) {
+		const auto sub = visit(f);
+		++Usage.Formulas;
+		Usage.InlineBytes += sizeof(RtFormula);
+		Usage.HeapBytes   += sub.Bytes - sizeof(RtFormula);
+		Usage.SharedBytes += sub.SharedBytes;
+		return;
+	}
+	
+	const MemoryUsage& usage(void) const noexcept {
+		return Usage;
+	}
+	
+	MemoryUsage& usage(void) noexcept {
+		return Usage;
+	}
+};
+
+template<typename T>
+struct IsJunctionN : std::false_type { };
+
+template<typename T, typename Container>
+struct IsJunctionN<AndN<T, Container>> : std::true_type { };
+
+template<typename T, typename Container>
+struct IsJunctionN<OrN<T, Container>> : std::true_type { };
+
+/**
+ * @brief Walks a formula with runtime names in its own layout.
+ *
+ * The nodes are inline in their parent, only runtime names and the operands of AndN and OrN own heap memory. Static
+ * subformulas own nothing and are never counted as shared, the others are compared by their runtime form.
+ */
+class MixedMemoryAccounting {
+	std::unordered_multimap<std::size_t, RtFormula> Seen;
+	
+	struct Subformula {
+		std::size_t HeapBytes;
+		std::size_t SharedBytes;
+	};
+	
+	static std::size_t hash(const RtFormula& f) {
+		std::size_t ret = static_cast<std::size_t>(f.K);
+		if ( f.N ) {
+			ret = hashCombine(ret, std::hash<RtName>{}(*f.N));
+		} //if ( f.N )
+		for ( const auto& term : f.Terms ) {
+			ret = hashCombine(ret, std::hash<RtTerm>{}(term));
+		} //for ( const auto& term : f.Terms )
+		for ( const auto& child : f.Children ) {
+			ret = hashCombine(ret, hash(child));
+		} //for ( const auto& child : f.Children )
+		return ret;
+	}
+	
+	template<typename T>
+	static std::size_t nameBytes(const T& name) noexcept {
+		if constexpr ( std::is_same_v<T, RtName> ) {
+			return heapBytes(name);
+		} //if constexpr ( std::is_same_v<T, RtName> )
+		else if constexpr ( std::is_same_v<T, RtVariable> ) {
+			return heapBytes(name.Name);
+		} //else if constexpr ( std::is_same_v<T, RtVariable> )
+		else {
+			return 0;
+		} //else -> else if constexpr ( std::is_same_v<T, RtVariable> )
+	}
+	
+	template<typename T>
+	static std::size_t termBytes(const T& t) noexcept {
+		if constexpr ( IsVariable<T>::value ) {
+			return nameBytes(t);
+		} //if constexpr ( IsVariable<T>::value )
+		else {
+			return nameBytes(t.N) + std::apply([](const auto&... args) noexcept {
+					return (std::size_t{0} + ... + termBytes(args));
+				}, t.A);
+		} //else -> if constexpr ( IsVariable<T>::value )
+	}
+	
+	template<typename NameT, typename... Args>
+	static std::size_t atomBytes(const Predicate<NameT, Args...>& p) noexcept {
+		return nameBytes(p.N) + std::apply([](const auto&... args) noexcept {
+				return (std::size_t{0} + ... + termBytes(args));
+			}, p.A);
+	}
+	
+	template<typename T1, typename T2>
+	static std::size_t atomBytes(const Equality<T1, T2>& e) noexcept {
+		return termBytes(e.Term1) + termBytes(e.Term2);
+	}
+	
+	template<typename Container>
+	static std::size_t containerBytes(const Container& operands) noexcept {
+		return operands.capacity() * sizeof(typename Container::value_type);
+	}
+	
+	template<typename U, std::size_t N>
+	static std::size_t containerBytes(const SmallVector<U, N>& operands) noexcept {
+		return operands.isInline() ? 0 : operands.capacity() * sizeof(U);
+	}
+	
+	public:
+	/**
+	 * @brief Returns the heap bytes of the formula and of its subformulas equal to an earlier one the shared bytes,
+	 * inline and heap.
+	 */
+	template<typename T>
+	Subformula account(const T& f) {
+		Subformula ret{0, 0};
+		if constexpr ( !IsStatic<T>::value ) {
+			const auto add = [&ret](const Subformula sub) noexcept {
+					ret.HeapBytes   += sub.HeapBytes;
+					ret.SharedBytes += sub.SharedBytes;
+					return;
+				};
+			if constexpr ( IsAtom<T>::value ) {
+				ret.HeapBytes = atomBytes(f);
+			} //if constexpr ( IsAtom<T>::value )
+			else if constexpr ( IsQuantifier<T>::value ) {
+				ret.HeapBytes = nameBytes(f.V);
+				add(account(f.F));
+			} //else if constexpr ( IsQuantifier<T>::value )
+			else if constexpr ( IsJunctionN<T>::value ) {
+				ret.HeapBytes = containerBytes(f.ts);
+				for ( const auto& operand : f.ts ) {
+					add(account(operand));
+				} //for ( const auto& operand : f.ts )
+			} //else if constexpr ( IsJunctionN<T>::value )
+			else {
+				std::apply([this, &add](const auto&... children) { (add(account(children)), ...); return; },
+				           children(f));
+			} //else -> else if constexpr ( IsJunctionN<T>::value )
+			
+			auto image           = toRuntime(f);
+			const auto imageHash = hash(image);
+			for ( auto [iter, end] = Seen.equal_range(imageHash); iter != end; ++iter ) {
+				if ( iter->second == image ) {
+					ret.SharedBytes = sizeof(T) + ret.HeapBytes;
+					return ret;
+				} //if ( iter->second == image )
+			} //for ( auto [iter, end] = Seen.equal_range(imageHash); iter != end; ++iter )
+			Seen.emplace(imageHash, std::move(image));
+		} //if constexpr ( !IsStatic<T>::value )
+		return ret;
+	}
+};
+} //namespace details
+
+inline MemoryUsage memoryUsage(const RtFormula& f) {
+	details::MemoryAccounting accounting;
+	accounting.add(f);
+	return accounting.usage();
+}
+
+/**
+ * @brief Returns the usage of a rule base, subformulas repeated in different rules count as shared.
+ */
+inline MemoryUsage memoryUsage(const std::vector<RtFormula>& rules) {
+	details::MemoryAccounting accounting;
+	for ( const auto& rule : rules ) {
+		accounting.add(rule);
+	} //for ( const auto& rule : rules )
+	
+	auto& usage = accounting.usage();
+	usage.InlineBytes  = sizeof(rules);
+	usage.HeapBytes   += rules.capacity() * sizeof(RtFormula);
+	return usage;
+}
+
+/**
+ * @brief Returns the usage of a static formula, which owns no heap memory and only consists of its inline bytes.
+ */
+template<typename T, std::enable_if_t<IsFormula<T>::value && IsStatic<T>::value>* = nullptr>
+MemoryUsage memoryUsage(const T& f) {
+	auto usage = memoryUsage(toRuntime(f));
+	usage.InlineBytes = sizeof(T);
+	usage.HeapBytes   = 0;
+	usage.SharedBytes = 0;
+	return usage;
+}
+
+/**
+ * @brief Returns the usage of a formula with runtime names, whose nodes are inline and only the names and the operands
+ * of AndN and OrN own heap memory.
+ */
+template<typename T, std::enable_if_t<IsFormula<T>::value && !IsStatic<T>::value>* = nullptr>
+MemoryUsage memoryUsage(const T& f) {
+	auto usage     = memoryUsage(toRuntime(f));
+	const auto sub = details::MixedMemoryAccounting{}.account(f);
+	usage.InlineBytes = sizeof(T);
+	usage.HeapBytes   = sub.HeapBytes;
+	usage.SharedBytes = sub.SharedBytes;
+	return usage;
+}
+
+} //namespace fol
+
+#endif
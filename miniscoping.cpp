@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks miniscoping.hpp for self-containment.
+ * 
+ */
+
+#include "miniscoping.hpp"
@@ -0,0 +1,192 @@
+/**
+ * @file
+ * @brief Contains the free variables of formulas and the miniscoping of quantifiers.
+ */
+
+#ifndef FOL_MINISCOPING_HPP
+#define FOL_MINISCOPING_HPP
+
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+namespace details {
+inline bool occursIn(const RtName& name, const RtTerm& t) noexcept {
+	if ( t.isVariable() ) {
+		return t.Name == name;
+	} //if ( t.isVariable() )
+	return std::any_of(t.Args.begin(), t.Args.end(), [&name](const RtTerm& arg) noexcept {
+			return occursIn(name, arg);
+		});
+}
+
+inline void collectFreeVariables(const RtTerm& t, const std::vector<RtName>& bound, std::vector<RtName>& free) {
+	if ( t.isVariable() ) {
+		if ( std::find(bound.begin(), bound.end(), t.Name) == bound.end() &&
+		     std::find(free.begin(), free.end(), t.Name) == free.end() ) {
+			free.push_back(t.Name);
+		} //if ( std::find(bound.begin(), bound.end(), t.Name) == bound.end() && ... )
+		return;
+	} //if ( t.isVariable() )
+	for ( const auto& arg : t.Args ) {
+		collectFreeVariables(arg, bound, free);
+	} //for ( const auto& arg : t.Args )
+	return;
+}
+
+inline void collectFreeVariables(const RtFormula& f, std::vector<RtName>& bound, std::vector<RtName>& free) {
+	for ( const auto& t : f.Terms ) {
+		collectFreeVariables(t, bound, free);
+	} //for ( const auto& t : f.Terms )
+	if ( f.isQuantifier() ) {
+		bound.push_back(*f.N);
+	} //if ( f.isQuantifier() )
+	for ( const auto& child : f.Children ) {
+		collectFreeVariables(child, bound, free);
+	} //for ( const auto& child : f.Children )
+	if ( f.isQuantifier() ) {
+		bound.pop_back();
+	} //if ( f.isQuantifier() )
+	return;
+}
+} //namespace details
+
+/**
+ * @brief Returns whether the variable name occurs free in f, i.e. not in the scope of a quantifier binding it.
+ */
+inline bool occursFree(const RtName& name, const RtFormula& f) noexcept {
+	if ( f.isQuantifier() && *f.N == name ) {
+		return false;
+	} //if ( f.isQuantifier() && *f.N == name )
+	return std::any_of(f.Terms.begin(), f.Terms.end(), [&name](const RtTerm& t) noexcept {
+				return details::occursIn(name, t);
+			}) ||
+	       std::any_of(f.Children.begin(), f.Children.end(), [&name](const RtFormula& child) noexcept {
+				return occursFree(name, child);
+			});
+}
+
+namespace details {
+/**
+ * @brief Moves the quantifier of kind k binding name into the already miniscoped formula f as far as possible.
+ *
+ * A universal quantifier is distributed over a conjunction, an existential one over a disjunction. Over the dual
+ * junction the operands without the variable are moved out of the scope, the quantifier is dropped if the variable
+ * does not occur at all.
+ */
+inline RtFormula pushQuantifier(const RtFormula::Kind k, const RtName& name, RtFormula f) {
+	using Kind = RtFormula::Kind;
+	if ( !occursFree(name, f) ) {
+		return f;
+	} //if ( !occursFree(name, f) )
+	
+	const Kind distributes = k == Kind::ForAll ? Kind::And : Kind::Or;
+	if ( f.K == distributes ) {
+		for ( auto& child : f.Children ) {
+			child = pushQuantifier(k, name, std::move(child));
+		} //for ( auto& child : f.Children )
+		return f;
+	} //if ( f.K == distributes )
+	
+	if ( f.K == (k == Kind::ForAll ? Kind::Or : Kind::And) ) {
+		std::vector<RtFormula> outside, inside;
+		for ( auto& child : f.Children ) {
+			(occursFree(name, child) ? inside : outside).push_back(std::move(child));
+		} //for ( auto& child : f.Children )
+		if ( !outside.empty() ) {
+			RtFormula scope = inside.size() == 1 ? std::move(inside.front()) : RtFormula{f.K, std::nullopt, {},
+			                                                                             std::move(inside)};
+			outside.push_back(pushQuantifier(k, name, std::move(scope)));
+			return {f.K, std::nullopt, {}, std::move(outside)};
+		} //if ( !outside.empty() )
+		f.Children = std::move(inside);
+	} //if ( f.K == (k == Kind::ForAll ? Kind::Or : Kind::And) )
+	
+	std::vector<RtFormula> children;
+	children.push_back(std::move(f));
+	return {k, name, {}, std::move(children)};
+}
+} //namespace details
+
+/**
+ * @brief Returns the free variables of f, in the order of their first occurrence.
+ */
+inline std::vector<RtName> freeVariables(const RtFormula& f) {
+	std::vector<RtName> bound, ret;
+	details::collectFreeVariables(f, bound, ret);
+	return ret;
+}
+
+template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+std::vector<RtName> freeVariables(const T& f) {
+	return freeVariables(toRuntime(f));
+}
+
+/**
+ * @brief Returns the negation normal form of f with every quantifier moved as far inwards as possible.
+ *
+ * The formula is miniscoped bottom up, so a quantifier is pushed into its already miniscoped body. A universal
+ * quantifier is distributed over conjunctions, an existential one over disjunctions, from the dual junctions the
+ * operands without the variable are moved out, and quantifiers whose variable does not occur are dropped. The result
+ * is equivalent to f, but an existential quantifier is in the scope of fewer universal ones, so its Skolem function
+ * gets fewer arguments.
+ */
+inline RtFormula miniscoped(const RtFormula& f) {
+	using Kind = RtFormula::Kind;
+	const auto miniscope = [](const auto& self, const RtFormula& g) -> RtFormula {
+			switch ( g.K ) {
+				case Kind::And    :
+				case Kind::Or     : {
+					std::vector<RtFormula> children;
+					children.reserve(g.Children.size());
+					for ( const auto& child : g.Children ) {
+						children.push_back(self(self, child));
+					} //for ( const auto& child : g.Children )
+					return {g.K, std::nullopt, {}, std::move(children)};
+				} //case Kind::And, Kind::Or
+				case Kind::Exists :
+				case Kind::ForAll : return details::pushQuantifier(g.K, *g.N, self(self, g.Children.front()));
+				default           : return g;
+			} //switch ( g.K )
+		};
+	return miniscope(miniscope, f.toNegationNormalForm());
+}
+
+template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+RtFormula miniscoped(const T& f) {
+	return miniscoped(toRuntime(f));
+}
+
+/**
+ * @brief Returns the summed up arity of the Skolem functions for the existential quantifiers of f.
+ *
+ * Every existential quantifier of the negation normal form is counted with the number of universal quantifiers it is
+ * in the scope of.
+ */
+inline std::size_t skolemArity(const RtFormula& f) {
+	using Kind = RtFormula::Kind;
+	const auto count = [](const auto& self, const RtFormula& g, const std::size_t universals) -> std::size_t {
+			std::size_t ret = g.K == Kind::Exists ? universals : 0;
+			for ( const auto& child : g.Children ) {
+				ret += self(self, child, universals + (g.K == Kind::ForAll ? 1 : 0));
+			} //for ( const auto& child : g.Children )
+			return ret;
+		};
+	return count(count, f.toNegationNormalForm(), 0);
+}
+
+template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+std::size_t skolemArity(const T& f) {
+	return skolemArity(toRuntime(f));
+}
+
+} //namespace fol
+
+#endif
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <ostream>
 #include <stdexcept>
 #include <string>
@@ -192,6 +193,13 @@ class RtName {
 		return;
 	}
 	
+	template<char... String>
+	RtName(const fol::Name<String...>) : Name{String...} { return; }
+	
+	const std::string& string(void) const noexcept {
+		return Name;
+	}
+	
 	RtName prev(void) const & {
 		return RtName{*this}.prev();
 	}
@@ -257,6 +265,23 @@ class RtName {
 		return !(n1 == n2);
 	}
 	
+	/**
+	 * @brief The canonical order of n1 and n2, negative if n1 comes first, zero if they are equal.
+	 *
+	 * Shorter names come first, so most names are told apart by their length without looking at the characters.
+	 */
+	static int order(const RtName& n1, const RtName& n2) noexcept {
+		if ( n1.Name.size() != n2.Name.size() ) {
+			return n1.Name.size() < n2.Name.size() ? -1 : 1;
+		} //if ( n1.Name.size() != n2.Name.size() )
+		const int ret = n1.Name.compare(n2.Name);
+		return ret < 0 ? -1 : ret > 0 ? 1 : 0;
+	}
+	
+	friend bool operator<(const RtName& n1, const RtName& n2) noexcept {
+		return order(n1, n2) < 0;
+	}
+	
 	friend std::ostream& operator<<(std::ostream& os, const RtName& n) noexcept {
 		return os<<n.Name;
 	}
@@ -290,4 +315,13 @@ bool operator!=(const Name<String...> n, const RtName& rt) noexcept {
 
 } //namespace fol
 
+namespace std {
+template<>
+struct hash<fol::RtName> {
+	std::size_t operator()(const fol::RtName& n) const noexcept {
+		return std::hash<std::string>{}(n.string());
+	}
+};
+} //namespace std
+
 #endif
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks nary_junction.hpp for self-containment.
+ * 
+ */
+
+#include "nary_junction.hpp"
@@ -0,0 +1,301 @@
+/**
+ * @file
+ * @brief Contains the and and the or over a runtime number of operands of one type.
+ */
+
+#ifndef FOL_NARY_JUNCTION_HPP
+#define FOL_NARY_JUNCTION_HPP
+
+#include "forward.hpp"
+
+#include "not.hpp"
+#include "pretty_printer.hpp"
+#include "rt_formula.hpp"
+#include "small_vector.hpp"
+#include "traits.hpp"
+#include "truth.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+namespace details {
+/**
+ * @brief The container of the same kind as Container for elements of type U.
+ */
+template<typename Container, typename U>
+struct Rebind;
+
+template<typename T, typename Allocator, typename U>
+struct Rebind<std::vector<T, Allocator>, U> {
+	using Type = std::vector<U>;
+};
+
+template<typename T, std::size_t N, typename U>
+struct Rebind<SmallVector<T, N>, U> {
+	using Type = SmallVector<U, N>;
+};
+
+/**
+ * @brief Transforms the operands in one pass into a container of the same kind.
+ */
+template<typename Container, typename Transform>
+auto transformedOperands(const Container& operands, Transform transform) {
+	using U = std::decay_t<decltype(transform(*operands.begin()))>;
+	typename Rebind<Container, U>::Type ret;
+	ret.reserve(operands.size());
+	for ( const auto& operand : operands ) {
+		ret.push_back(transform(operand));
+	} //for ( const auto& operand : operands )
+	return ret;
+}
+
+/**
+ * @brief Applies the algebraic rules of simplifyJunction() to the already simplified operands.
+ *
+ * All operands have the same type, so the rules only depend on it: units are all dropped, a zero is the only operand
+ * kept, and of static operands, which are all equal, one is kept. Like in the static junctions operands with runtime
+ * names are not compared.
+ */
+template<typename Unit, typename Zero, typename Container>
+void simplifyOperands(Container& operands) {
+	using T = typename Container::value_type;
+	if constexpr ( std::is_same_v<T, Unit> ) {
+		operands.clear();
+	} //if constexpr ( std::is_same_v<T, Unit> )
+	else if constexpr ( std::is_same_v<T, Zero> || IsStatic<T>::value ) {
+		if ( operands.size() > 1 ) {
+			operands.erase(operands.begin() + 1, operands.end());
+		} //if ( operands.size() > 1 )
+	} //else if constexpr ( std::is_same_v<T, Zero> || IsStatic<T>::value )
+	return;
+}
+
+/**
+ * @brief Prints the operands joined by the delimiter, no operands as the unit.
+ */
+template<typename Unit, typename Container>
+std::ostream& printOperands(std::ostream& os, const Container& operands, const char *delimiter) {
+	if ( operands.empty() ) {
+		return os<<Unit{};
+	} //if ( operands.empty() )
+	const char *separator = "";
+	for ( const auto& operand : operands ) {
+		os<<separator<<operand;
+		separator = delimiter;
+	} //for ( const auto& operand : operands )
+	return os;
+}
+
+template<typename Unit, typename Container>
+std::ostream& prettyPrintOperands(std::ostream& os, const Container& operands, const int index,
+                                  const char *delimiter) {
+	if ( operands.empty() ) {
+		return os<<Unit{};
+	} //if ( operands.empty() )
+	const bool withParanthesis = index != -1;
+	if ( withParanthesis ) {
+		os<<PrettyParanthesis[static_cast<std::size_t>(index)].first;
+	} //if ( withParanthesis )
+	const auto nextIndex  = (index + 1) % static_cast<int>(PrettyParanthesis.size());
+	const char *separator = "";
+	for ( const auto& operand : operands ) {
+		os<<separator<<PrettyPrinter{operand, nextIndex};
+		separator = delimiter;
+	} //for ( const auto& operand : operands )
+	if ( withParanthesis ) {
+		os<<PrettyParanthesis[static_cast<std::size_t>(index)].second;
+	} //if ( withParanthesis )
+	return os;
+}
+
+template<typename Container>
+std::vector<RtFormula> toRuntimeOperands(const Container& operands) {
+	std::vector<RtFormula> ret;
+	ret.reserve(operands.size());
+	for ( const auto& operand : operands ) {
+		ret.push_back(toRuntime(operand));
+	} //for ( const auto& operand : operands )
+	return ret;
+}
+} //namespace details
+
+/**
+ * @brief A conjunction of any number of operands of the type T, stored contiguously in Container.
+ *
+ * Container is a std::vector or a SmallVector. Without operands it is true. The transformations are linear passes over
+ * the operands and return an AndN, or an OrN for negate(), of the transformed operand type in the same kind of
+ * container.
+ */
+template<typename T, typename Container>
+struct AndN {
+	static_assert(IsFormula<T>::value, "The operands have to be formulas!");
+	static_assert(std::is_same_v<typename Container::value_type, T>, "The container has to store the operands!");
+	
+	//Of one operand, the number of operands is only known at runtime.
+	using VariableCount = typename T::VariableCount;
+	
+	Container ts;
+	
+	AndN(void) = default;
+	
+	explicit AndN(Container operands) noexcept(std::is_nothrow_move_constructible_v<Container>) :
+			ts{std::move(operands)} {
+		return;
+	}
+	
+	AndN(const std::initializer_list<T> operands) : ts(operands.begin(), operands.end()) {
+		return;
+	}
+	
+	std::size_t size(void) const noexcept {
+		return ts.size();
+	}
+	
+	auto simplified(void) const {
+		auto operands = details::transformedOperands(ts, [](const T& t) { return t.simplified(); });
+		details::simplifyOperands<True, False>(operands);
+		return AndN<typename decltype(operands)::value_type, decltype(operands)>{std::move(operands)};
+	}
+	
+	auto negate(void) const {
+		auto operands = details::transformedOperands(ts, [](const T& t) { return Not<T>{t}.toNegationNormalForm(); });
+		return OrN<typename decltype(operands)::value_type, decltype(operands)>{std::move(operands)};
+	}
+	
+	auto toNegationNormalForm(void) const {
+		auto operands = details::transformedOperands(ts, [](const T& t) { return t.toNegationNormalForm(); });
+		return AndN<typename decltype(operands)::value_type, decltype(operands)>{std::move(operands)};
+	}
+	
+	friend std::ostream& operator<<(std::ostream& os, const AndN& a) {
+		return details::printOperands<True>(os, a.ts, " & ");
+	}
+};
+
+/**
+ * @brief A disjunction of any number of operands of the type T, stored contiguously in Container.
+ *
+ * The dual of AndN, without operands it is false.
+ */
+template<typename T, typename Container>
+struct OrN {
+	static_assert(IsFormula<T>::value, "The operands have to be formulas!");
+	static_assert(std::is_same_v<typename Container::value_type, T>, "The container has to store the operands!");
+	
+	//Of one operand, the number of operands is only known at runtime.
+	using VariableCount = typename T::VariableCount;
+	
+	Container ts;
+	
+	OrN(void) = default;
+	
+	explicit OrN(Container operands) noexcept(std::is_nothrow_move_constructible_v<Container>) :
+			ts{std::move(operands)} {
+		return;
+	}
+	
+	OrN(const std::initializer_list<T> operands) : ts(operands.begin(), operands.end()) {
+		return;
+	}
+	
+	std::size_t size(void) const noexcept {
+		return ts.size();
+	}
+	
+	auto simplified(void) const {
+		auto operands = details::transformedOperands(ts, [](const T& t) { return t.simplified(); });
+		details::simplifyOperands<False, True>(operands);
+		return OrN<typename decltype(operands)::value_type, decltype(operands)>{std::move(operands)};
+	}
+	
+	auto negate(void) const {
+		auto operands = details::transformedOperands(ts, [](const T& t) { return Not<T>{t}.toNegationNormalForm(); });
+		return AndN<typename decltype(operands)::value_type, decltype(operands)>{std::move(operands)};
+	}
+	
+	auto toNegationNormalForm(void) const {
+		auto operands = details::transformedOperands(ts, [](const T& t) { return t.toNegationNormalForm(); });
+		return OrN<typename decltype(operands)::value_type, decltype(operands)>{std::move(operands)};
+	}
+	
+	friend std::ostream& operator<<(std::ostream& os, const OrN& o) {
+		return details::printOperands<False>(os, o.ts, " | ");
+	}
+};
+
+template<typename Container>
+AndN(Container) -> AndN<typename Container::value_type, Container>;
+
+template<typename Container>
+OrN(Container) -> OrN<typename Container::value_type, Container>;
+
+template<typename T1, typename C1, typename T2, typename C2>
+bool operator==(const AndN<T1, C1>& a1, const AndN<T2, C2>& a2) {
+	return std::equal(a1.ts.begin(), a1.ts.end(), a2.ts.begin(), a2.ts.end(),
+	                  [](const T1& t1, const T2& t2) { return t1 == t2; });
+}
+
+template<typename T1, typename C1, typename T2, typename C2>
+bool operator!=(const AndN<T1, C1>& a1, const AndN<T2, C2>& a2) {
+	return !(a1 == a2);
+}
+
+template<typename T1, typename C1, typename T2, typename C2>
+bool operator==(const OrN<T1, C1>& o1, const OrN<T2, C2>& o2) {
+	return std::equal(o1.ts.begin(), o1.ts.end(), o2.ts.begin(), o2.ts.end(),
+	                  [](const T1& t1, const T2& t2) { return t1 == t2; });
+}
+
+template<typename T1, typename C1, typename T2, typename C2>
+bool operator!=(const OrN<T1, C1>& o1, const OrN<T2, C2>& o2) {
+	return !(o1 == o2);
+}
+
+template<typename T, typename Container>
+RtFormula toRuntime(const AndN<T, Container>& a) {
+	return RtFormula::conjunction(details::toRuntimeOperands(a.ts));
+}
+
+template<typename T, typename Container>
+RtFormula toRuntime(const OrN<T, Container>& o) {
+	return RtFormula::disjunction(details::toRuntimeOperands(o.ts));
+}
+
+template<typename T, typename Container>
+struct PrettyPrinter<AndN<T, Container>> {
+	const AndN<T, Container>& A;
+	const int Index;
+	
+	PrettyPrinter(const AndN<T, Container>& a, int index = -1) : A{a}, Index{index} {
+		return;
+	}
+	
+	std::ostream& prettyPrint(std::ostream& os) const {
+		return details::prettyPrintOperands<True>(os, A.ts, Index, " & ");
+	}
+};
+
+template<typename T, typename Container>
+struct PrettyPrinter<OrN<T, Container>> {
+	const OrN<T, Container>& O;
+	const int Index;
+	
+	PrettyPrinter(const OrN<T, Container>& o, int index = -1) : O{o}, Index{index} {
+		return;
+	}
+	
+	std::ostream& prettyPrint(std::ostream& os) const {
+		return details::prettyPrintOperands<False>(os, O.ts, Index, " | ");
+	}
+};
+
+} //namespace fol
+
+#endif
@@ -7,16 +7,19 @@
 #define FOL_NOT_HPP
 
 #include "pretty_printer.hpp"
+#include "storage.hpp"
 #include "traits.hpp"
+#include "truth.hpp"
 
 #include <ostream>
+#include <type_traits>
 
 namespace fol {
 
 template<typename T>
-struct Not {
+struct Not : details::StoredT<T> {
 	static_assert(IsFormula<T>::value, "The negation must contain a formula!");
-	T t;
+	using details::StoredT<T>::t;
 	
 	using VariableCount = typename T::VariableCount;
 //	using VariableArray = typename T::VariableArray;
@@ -27,7 +30,16 @@ struct Not {
 		} //if constexpr ( IsNot<T>::value )
 		else {
 			auto inner = t.simplified();
-			return Not<std::decay_t<decltype(inner)>>{inner};
+			using Inner = std::decay_t<decltype(inner)>;
+			if constexpr ( IsTruth<Inner>::value ) {
+				return inner.negate();
+			} //if constexpr ( IsTruth<Inner>::value )
+			else if constexpr ( IsNot<Inner>::value ) {
+				return inner.t;
+			} //else if constexpr ( IsNot<Inner>::value )
+			else {
+				return Not<Inner>{inner};
+			} //else -> else if constexpr ( IsNot<Inner>::value )
 		} //else -> if constexpr ( IsNot<T>::value )
 	}
 	
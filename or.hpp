@@ -6,11 +6,12 @@
 #ifndef FOL_OR_HPP
 #define FOL_OR_HPP
 
+#include "and.hpp"
 #include "forward.hpp"
 
-#include "and.hpp"
 #include "helper.hpp"
 #include "pretty_printer.hpp"
+#include "storage.hpp"
 #include "traits.hpp"
 
 #include <ostream>
@@ -19,7 +20,7 @@
 namespace fol {
 
 template<typename... Ts>
-struct Or {
+struct Or : details::StoredTs<std::tuple<Ts...>> {
 	private:
 	template<typename... Tx, std::size_t... Idx>
 	static constexpr Or<Tx...> fromTupleImpl(std::tuple<Tx...> t, const std::index_sequence<Idx...>) {
@@ -29,19 +30,20 @@ struct Or {
 	public:
 	static_assert((IsFormula<Ts>::value && ...), "All parameters have to be formulas!");
 	
-	std::tuple<Ts...> ts;
+	using details::StoredTs<std::tuple<Ts...>>::ts;
 	
 	using VariableCount = std::integral_constant<std::size_t, (0 + ... + Ts::VariableCount::value)>;
 //	using VariableArray = decltype((ArraySet<0>{} + ... + typename Ts::VariableArray{}));
 	
 	constexpr Or(void) = default;
 	constexpr Or(Ts... t) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...) &&
-	                               noexcept(std::make_tuple(std::move(t)...))) : ts{std::make_tuple(std::move(t)...)} {
+	                               noexcept(std::make_tuple(std::move(t)...))) :
+			details::StoredTs<std::tuple<Ts...>>{std::make_tuple(std::move(t)...)} {
 		return;
 	}
 	
 	constexpr auto simplified(void) const {
-		return fromTuple(details::simplifiedTuple(ts));
+		return details::simplifyJunction<Or, False, True, And>(details::simplifiedTuple(ts));
 	}
 	
 	constexpr auto negate(void) const {
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks order.hpp for self-containment.
+ * 
+ */
+
+#include "order.hpp"
@@ -0,0 +1,262 @@
+/**
+ * @file
+ * @brief Contains the canonical order of the static formulas.
+ */
+
+#ifndef FOL_ORDER_HPP
+#define FOL_ORDER_HPP
+
+#include "forward.hpp"
+
+#include "traits.hpp"
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace fol {
+
+namespace details {
+template<typename T>
+struct OrderTag { };
+
+/**
+ * @brief The rank of the kind of a node, the same as the value of RtTerm::Kind and RtFormula::Kind. Names are only
+ * compared with names.
+ */
+template<typename T>
+struct OrderRank;
+
+template<char... String>
+struct OrderRank<Name<String...>> : std::integral_constant<int, 0> { };
+
+template<char c, char... String>
+struct OrderRank<Variable<c, String...>> : std::integral_constant<int, 0> { };
+
+template<typename Name, typename... Args>
+struct OrderRank<Function<Name, Args...>> : std::integral_constant<int, 1> { };
+
+template<typename Name, typename... Args>
+struct OrderRank<Predicate<Name, Args...>> : std::integral_constant<int, 0> { };
+
+template<typename T1, typename T2>
+struct OrderRank<Equality<T1, T2>> : std::integral_constant<int, 1> { };
+
+template<typename... Ts>
+struct OrderRank<And<Ts...>> : std::integral_constant<int, 3> { };
+
+template<typename... Ts>
+struct OrderRank<Or<Ts...>> : std::integral_constant<int, 4> { };
+
+template<typename T1, typename T2>
+struct OrderRank<Implies<T1, T2>> : std::integral_constant<int, 5> { };
+
+template<typename T1, typename T2>
+struct OrderRank<Equivalent<T1, T2>> : std::integral_constant<int, 6> { };
+
+template<typename Var, typename Form>
+struct OrderRank<Exists<Var, Form>> : std::integral_constant<int, 7> { };
+
+template<typename Var, typename Form>
+struct OrderRank<ForAll<Var, Form>> : std::integral_constant<int, 8> { };
+
+template<>
+struct OrderRank<True> : std::integral_constant<int, 9> { };
+
+template<>
+struct OrderRank<False> : std::integral_constant<int, 10> { };
+
+/**
+ * @brief Strips the negations of T and counts them.
+ */
+template<typename T>
+struct Negations {
+	using Type = T;
+	static constexpr std::size_t Count = 0;
+};
+
+template<typename T>
+struct Negations<Not<T>> {
+	using Type = typename Negations<T>::Type;
+	static constexpr std::size_t Count = Negations<T>::Count + 1;
+};
+
+template<typename T1, typename T2>
+constexpr int staticOrder(void) noexcept;
+
+constexpr int compareValues(const std::size_t v1, const std::size_t v2) noexcept {
+	return v1 == v2 ? 0 : v1 < v2 ? -1 : 1;
+}
+
+/**
+ * @brief Orders shorter names first, names of the same length by their characters, like the order of RtName.
+ */
+template<char... String1, char... String2>
+constexpr int compareStatic(const OrderTag<Name<String1...>>, const OrderTag<Name<String2...>>) noexcept {
+	if constexpr ( sizeof...(String1) != sizeof...(String2) ) {
+		return compareValues(sizeof...(String1), sizeof...(String2));
+	} //if constexpr ( sizeof...(String1) != sizeof...(String2) )
+	else {
+		constexpr unsigned char string1[] = {static_cast<unsigned char>(String1)...};
+		constexpr unsigned char string2[] = {static_cast<unsigned char>(String2)...};
+		for ( std::size_t i = 0; i < sizeof...(String1); ++i ) {
+			if ( string1[i] != string2[i] ) {
+				return string1[i] < string2[i] ? -1 : 1;
+			} //if ( string1[i] != string2[i] )
+		} //for ( std::size_t i = 0; i < sizeof...(String1); ++i )
+		return 0;
+	} //else -> if constexpr ( sizeof...(String1) != sizeof...(String2) )
+}
+
+/**
+ * @brief Orders shorter tuples first, tuples of the same size lexicographically.
+ */
+template<typename... T1s, typename... T2s>
+constexpr int compareStatic(const OrderTag<std::tuple<T1s...>>, const OrderTag<std::tuple<T2s...>>) noexcept {
+	if constexpr ( sizeof...(T1s) != sizeof...(T2s) ) {
+		return compareValues(sizeof...(T1s), sizeof...(T2s));
+	} //if constexpr ( sizeof...(T1s) != sizeof...(T2s) )
+	else {
+		const std::array<int, sizeof...(T1s)> results{staticOrder<T1s, T2s>()...};
+		for ( const auto result : results ) {
+			if ( result != 0 ) {
+				return result;
+			} //if ( result != 0 )
+		} //for ( const auto result : results )
+		return 0;
+	} //else -> if constexpr ( sizeof...(T1s) != sizeof...(T2s) )
+}
+
+template<typename T1, typename T2>
+constexpr int compareNamed(void) noexcept {
+	const int ret = compareStatic(OrderTag<typename T1::first_type>{}, OrderTag<typename T2::first_type>{});
+	return ret != 0 ? ret : compareStatic(OrderTag<typename T1::second_type>{}, OrderTag<typename T2::second_type>{});
+}
+
+template<char c1, char... String1, char c2, char... String2>
+constexpr int compareStatic(const OrderTag<Variable<c1, String1...>>, const OrderTag<Variable<c2, String2...>>)
+		noexcept {
+	return compareStatic(OrderTag<Name<c1, String1...>>{}, OrderTag<Name<c2, String2...>>{});
+}
+
+template<typename Name1, typename... Args1, typename Name2, typename... Args2>
+constexpr int compareStatic(const OrderTag<Function<Name1, Args1...>>, const OrderTag<Function<Name2, Args2...>>)
+		noexcept {
+	return compareNamed<std::pair<Name1, std::tuple<Args1...>>, std::pair<Name2, std::tuple<Args2...>>>();
+}
+
+template<typename Name1, typename... Args1, typename Name2, typename... Args2>
+constexpr int compareStatic(const OrderTag<Predicate<Name1, Args1...>>, const OrderTag<Predicate<Name2, Args2...>>)
+		noexcept {
+	return compareNamed<std::pair<Name1, std::tuple<Args1...>>, std::pair<Name2, std::tuple<Args2...>>>();
+}
+
+template<template<typename...> class Node, typename... T1s, typename... T2s>
+constexpr int compareStatic(const OrderTag<Node<T1s...>>, const OrderTag<Node<T2s...>>) noexcept {
+	return compareStatic(OrderTag<std::tuple<T1s...>>{}, OrderTag<std::tuple<T2s...>>{});
+}
+
+constexpr int compareStatic(const OrderTag<True>, const OrderTag<True>) noexcept {
+	return 0;
+}
+
+constexpr int compareStatic(const OrderTag<False>, const OrderTag<False>) noexcept {
+	return 0;
+}
+
+/**
+ * @brief The canonical order of the static terms or formulas T1 and T2, negative if T1 comes first, zero if they are
+ * the same.
+ *
+ * The negations are ignored at first, so a literal is next to its atom, and only break the tie. Otherwise the kinds are
+ * ordered as in RtFormula::Kind, nodes of the same kind by their names and then by their operands. It is the order of
+ * RtFormula::order() on the runtime representation.
+ */
+template<typename T1, typename T2>
+constexpr int staticOrder(void) noexcept {
+	using Stripped1 = typename Negations<T1>::Type;
+	using Stripped2 = typename Negations<T2>::Type;
+	if constexpr ( OrderRank<Stripped1>::value != OrderRank<Stripped2>::value ) {
+		return OrderRank<Stripped1>::value < OrderRank<Stripped2>::value ? -1 : 1;
+	} //if constexpr ( OrderRank<Stripped1>::value != OrderRank<Stripped2>::value )
+	else {
+		const int ret = compareStatic(OrderTag<Stripped1>{}, OrderTag<Stripped2>{});
+		return ret != 0 ? ret : compareValues(Negations<T1>::Count, Negations<T2>::Count);
+	} //else -> if constexpr ( OrderRank<Stripped1>::value != OrderRank<Stripped2>::value )
+}
+
+template<typename T1, typename T2>
+constexpr int operandOrder(void) noexcept {
+	if constexpr ( IsStatic<T1>::value && IsStatic<T2>::value ) {
+		return staticOrder<T1, T2>();
+	} //if constexpr ( IsStatic<T1>::value && IsStatic<T2>::value )
+	else {
+		return 0;
+	} //else -> if constexpr ( IsStatic<T1>::value && IsStatic<T2>::value )
+}
+
+template<typename Tuple, std::size_t I, std::size_t... Js>
+constexpr std::array<int, sizeof...(Js)> operandOrderRow(const std::index_sequence<Js...>) noexcept {
+	return {operandOrder<std::tuple_element_t<I, Tuple>, std::tuple_element_t<Js, Tuple>>()...};
+}
+
+template<typename... Ts, std::size_t... Is>
+constexpr auto operandOrderMatrix(const std::index_sequence<Is...> indices) noexcept {
+	return std::array<std::array<int, sizeof...(Ts)>, sizeof...(Ts)>{
+		operandOrderRow<std::tuple<Ts...>, Is>(indices)...};
+}
+
+/**
+ * @brief Returns the positions of the operands Ts in canonical order.
+ *
+ * The static operands are sorted and come first, the others can only be told apart at runtime and keep their relative
+ * order.
+ */
+template<typename... Ts>
+constexpr std::array<std::size_t, sizeof...(Ts)> canonicalPositions(void) noexcept {
+	constexpr std::array<bool, sizeof...(Ts)> isStatic{IsStatic<Ts>::value...};
+	constexpr auto matrix = operandOrderMatrix<Ts...>(std::index_sequence_for<Ts...>{});
+	const auto less = [&isStatic, &matrix](const std::size_t i, const std::size_t j) noexcept {
+			return isStatic[i] && (!isStatic[j] || matrix[i][j] < 0);
+		};
+	
+	std::array<std::size_t, sizeof...(Ts)> ret{};
+	for ( std::size_t i = 0; i < ret.size(); ++i ) {
+		ret[i] = i;
+		for ( std::size_t j = i; j > 0 && less(ret[j], ret[j - 1]); --j ) {
+			const auto swap = ret[j];
+			ret[j]          = ret[j - 1];
+			ret[j - 1]      = swap;
+		} //for ( std::size_t j = i; j > 0 && less(ret[j], ret[j - 1]); --j )
+	} //for ( std::size_t i = 0; i < ret.size(); ++i )
+	return ret;
+}
+
+template<typename... Ts, std::size_t... Is>
+constexpr auto canonicalTupleImpl(const std::tuple<Ts...>& t, const std::index_sequence<Is...>) {
+	constexpr auto positions = canonicalPositions<Ts...>();
+	return std::tuple<std::tuple_element_t<positions[Is], std::tuple<Ts...>>...>{std::get<positions[Is]>(t)...};
+}
+
+/**
+ * @brief Returns the operands of t in canonical order.
+ */
+template<typename... Ts>
+constexpr auto canonicalTuple(const std::tuple<Ts...>& t) {
+	return canonicalTupleImpl(t, std::index_sequence_for<Ts...>());
+}
+} //namespace details
+
+/**
+ * @brief Whether the static term or formula f1 comes before f2 in the canonical order.
+ */
+template<typename T1, typename T2, std::enable_if_t<IsStatic<T1>::value && IsStatic<T2>::value>* = nullptr>
+constexpr bool orderedBefore(const T1&, const T2&) noexcept {
+	return details::staticOrder<T1, T2>() < 0;
+}
+
+} //namespace fol
+
+#endif
@@ -10,6 +10,7 @@
 #include "name.hpp"
 #include "not.hpp"
 #include "pretty_printer.hpp"
+#include "storage.hpp"
 #include "traits.hpp"
 
 #include <ostream>
@@ -19,7 +20,7 @@
 namespace fol {
 
 template<typename NameT, typename... Args>
-struct Predicate {
+struct Predicate : details::StoredN<NameT>, details::StoredA<std::tuple<Args...>> {
 	private:
 	template<typename Name2, std::size_t... Idx>
 	static constexpr Predicate<Name2, Args...> fromNameImpl(const Name2& n, const std::tuple<Args...>& t,
@@ -32,12 +33,12 @@ struct Predicate {
 	static_assert(IsName<NameT>::value, "First template argument must be a name!");
 	static_assert((IsTerm<Args>::value && ...), "All template arguments from the second on have to be terms!");
 	
+	using details::StoredN<NameT>::N;
+	using details::StoredA<std::tuple<Args...>>::A;
+	
 	using VariableCount = std::integral_constant<std::size_t, (0 + ... + Args::VariableCount::value)>;
 //	using VariableArray = decltype((ArraySet<0>{} + ... + typename Args::VariableArray{}));
 	
-	NameT N;
-	std::tuple<Args...> A;
-	
 	using Arity = std::integral_constant<std::size_t, sizeof...(Args)>;
 	
 	constexpr Predicate(void) = default;
@@ -45,8 +46,9 @@ struct Predicate {
 	constexpr Predicate(NameT n, Args... a)
 			noexcept(std::is_nothrow_move_constructible_v<NameT> &&
 			         (std::is_nothrow_move_constructible_v<Args> && ...) &&
-			         noexcept(std::make_tuple(std::move(a)...))) : N{std::move(n)},
-			A{std::make_tuple(std::move(a)...)} {
+			         noexcept(std::make_tuple(std::move(a)...))) :
+			details::StoredN<NameT>{std::move(n)},
+			details::StoredA<std::tuple<Args...>>{std::make_tuple(std::move(a)...)} {
 		return;
 	}
 	
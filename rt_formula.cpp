@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks rt_formula.hpp for self-containment.
+ * 
+ */
+
+#include "rt_formula.hpp"
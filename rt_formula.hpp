@@ -0,0 +1,617 @@
+/**
+ * @file
+ * @brief Contains the runtime representation of terms and formulas.
+ */
+
+#ifndef FOL_RT_FORMULA_HPP
+#define FOL_RT_FORMULA_HPP
+
+#include "forward.hpp"
+
+#include "and.hpp"
+#include "equality.hpp"
+#include "equivalent.hpp"
+#include "exists.hpp"
+#include "forall.hpp"
+#include "function.hpp"
+#include "implies.hpp"
+#include "name.hpp"
+#include "not.hpp"
+#include "or.hpp"
+#include "predicate.hpp"
+#include "pretty_printer.hpp"
+#include "stats.hpp"
+#include "traits.hpp"
+#include "truth.hpp"
+#include "variable.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+namespace details {
+constexpr std::size_t hashCombine(const std::size_t seed, const std::size_t value) noexcept {
+	return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * @brief Orders shorter sequences first, sequences of the same size lexicographically by T::order().
+ */
+template<typename T>
+int orderSequences(const std::vector<T>& v1, const std::vector<T>& v2) noexcept {
+	if ( v1.size() != v2.size() ) {
+		return v1.size() < v2.size() ? -1 : 1;
+	} //if ( v1.size() != v2.size() )
+	for ( std::size_t i = 0; i < v1.size(); ++i ) {
+		const int ret = T::order(v1[i], v2[i]);
+		if ( ret != 0 ) {
+			return ret;
+		} //if ( ret != 0 )
+	} //for ( std::size_t i = 0; i < v1.size(); ++i )
+	return 0;
+}
+} //namespace details
+
+/**
+ * @brief A term whose shape is only known at runtime.
+ */
+struct RtTerm {
+	enum class Kind : std::uint8_t { Variable, Function };
+	
+	Kind K;
+	RtName Name;
+	std::vector<RtTerm> Args;
+	
+	RtTerm(RtVariable v) : K{Kind::Variable}, Name{std::move(v.Name)} {
+		return;
+	}
+	
+	RtTerm(RtName name, std::vector<RtTerm> args = {}) : K{Kind::Function}, Name{std::move(name)},
+			Args{std::move(args)} {
+		return;
+	}
+	
+	bool isVariable(void) const noexcept {
+		return K == Kind::Variable;
+	}
+	
+	friend bool operator==(const RtTerm& t1, const RtTerm& t2) noexcept {
+		return t1.K == t2.K && t1.Name == t2.Name && t1.Args == t2.Args;
+	}
+	
+	friend bool operator!=(const RtTerm& t1, const RtTerm& t2) noexcept {
+		return !(t1 == t2);
+	}
+	
+	/**
+	 * @brief The canonical order of t1 and t2: variables before functions, then by name and arguments.
+	 */
+	static int order(const RtTerm& t1, const RtTerm& t2) noexcept {
+		if ( t1.K != t2.K ) {
+			return t1.K < t2.K ? -1 : 1;
+		} //if ( t1.K != t2.K )
+		const int ret = RtName::order(t1.Name, t2.Name);
+		return ret != 0 ? ret : details::orderSequences(t1.Args, t2.Args);
+	}
+	
+	friend bool operator<(const RtTerm& t1, const RtTerm& t2) noexcept {
+		return order(t1, t2) < 0;
+	}
+	
+	friend std::ostream& operator<<(std::ostream& os, const RtTerm& t) {
+		os<<t.Name;
+		if ( !t.Args.empty() ) {
+			const char *delimiter = "";
+			os<<'(';
+			for ( const auto& arg : t.Args ) {
+				os<<delimiter<<arg;
+				delimiter = ", ";
+			} //for ( const auto& arg : t.Args )
+			os<<')';
+		} //if ( !t.Args.empty() )
+		return os;
+	}
+};
+
+/**
+ * @brief A formula whose shape is only known at runtime.
+ *
+ * Every node is of one kind. Predicates use N as their name and Terms as their arguments, equalities have exactly two
+ * Terms, quantifiers use N as their bound variable and have exactly one child, the truth constants have nothing, all
+ * other connectives only use Children.
+ */
+struct RtFormula {
+	enum class Kind : std::uint8_t { Predicate, Equality, Not, And, Or, Implies, Equivalent, Exists, ForAll, True, False };
+	
+	Kind K;
+	std::optional<RtName> N;
+	std::vector<RtTerm> Terms;
+	std::vector<RtFormula> Children;
+	
+	RtFormula(const Kind k, std::optional<RtName> n, std::vector<RtTerm> terms, std::vector<RtFormula> children) :
+			K{k}, N{std::move(n)}, Terms{std::move(terms)}, Children{std::move(children)} {
+		return;
+	}
+	
+	static RtFormula constant(const bool value) {
+		return {value ? Kind::True : Kind::False, std::nullopt, {}, {}};
+	}
+	
+	static RtFormula predicate(RtName name, std::vector<RtTerm> args = {}) {
+		return {Kind::Predicate, std::move(name), std::move(args), {}};
+	}
+	
+	static RtFormula equality(RtTerm t1, RtTerm t2) {
+		std::vector<RtTerm> terms;
+		terms.reserve(2);
+		terms.push_back(std::move(t1));
+		terms.push_back(std::move(t2));
+		return {Kind::Equality, std::nullopt, std::move(terms), {}};
+	}
+	
+	static RtFormula negation(RtFormula f) {
+		return unary(Kind::Not, std::nullopt, std::move(f));
+	}
+	
+	static RtFormula conjunction(std::vector<RtFormula> fs) {
+		return {Kind::And, std::nullopt, {}, std::move(fs)};
+	}
+	
+	static RtFormula disjunction(std::vector<RtFormula> fs) {
+		return {Kind::Or, std::nullopt, {}, std::move(fs)};
+	}
+	
+	static RtFormula implication(RtFormula f1, RtFormula f2) {
+		return binary(Kind::Implies, std::move(f1), std::move(f2));
+	}
+	
+	static RtFormula equivalence(RtFormula f1, RtFormula f2) {
+		return binary(Kind::Equivalent, std::move(f1), std::move(f2));
+	}
+	
+	static RtFormula exists(RtVariable v, RtFormula f) {
+		return unary(Kind::Exists, std::move(v.Name), std::move(f));
+	}
+	
+	static RtFormula forAll(RtVariable v, RtFormula f) {
+		return unary(Kind::ForAll, std::move(v.Name), std::move(f));
+	}
+	
+	bool isAtom(void) const noexcept {
+		return K == Kind::Predicate || K == Kind::Equality;
+	}
+	
+	bool isQuantifier(void) const noexcept {
+		return K == Kind::Exists || K == Kind::ForAll;
+	}
+	
+	bool isTruth(void) const noexcept {
+		return K == Kind::True || K == Kind::False;
+	}
+	
+	RtFormula simplified(void) const {
+		const stats::Visit visit{stats::Pass::Simplify, K};
+		switch ( K ) {
+			case Kind::Predicate  :
+			case Kind::True       :
+			case Kind::False      : return *this;
+			case Kind::Equality   : return Terms[0] == Terms[1] ? constant(true) : *this;
+			case Kind::Not        : {
+				const RtFormula& t = Children.front();
+				if ( t.K == Kind::Not ) {
+					return t.Children.front().simplified();
+				} //if ( t.K == Kind::Not )
+				auto inner = t.simplified();
+				if ( inner.isTruth() ) {
+					return constant(inner.K == Kind::False);
+				} //if ( inner.isTruth() )
+				if ( inner.K == Kind::Not ) {
+					return std::move(inner.Children.front());
+				} //if ( inner.K == Kind::Not )
+				return negation(std::move(inner));
+			} //case Kind::Not
+			case Kind::And        :
+			case Kind::Or         : return simplifiedJunction(K, transformed(&RtFormula::simplified));
+			case Kind::Implies    : return disjunction({negation(Children[0]), Children[1]}).simplified();
+			case Kind::Equivalent : {
+				return simplifiedJunction(Kind::And, {implication(Children[0], Children[1]).simplified(),
+				                                      implication(Children[1], Children[0]).simplified()});
+			} //case Kind::Equivalent
+			case Kind::Exists     :
+			case Kind::ForAll     : {
+				auto form = Children.front().simplified();
+				if ( form.isTruth() ) {
+					return form;
+				} //if ( form.isTruth() )
+				return unary(K, N, std::move(form));
+			} //case Kind::Exists, Kind::ForAll
+		} //switch ( K )
+		return *this;
+	}
+	
+	RtFormula negate(void) const {
+		const stats::Visit visit{stats::Pass::Negate, K};
+		switch ( K ) {
+			case Kind::Predicate  :
+			case Kind::Equality   : return negation(*this);
+			case Kind::True       : return constant(false);
+			case Kind::False      : return constant(true);
+			case Kind::Not        : return Children.front().toNegationNormalForm();
+			case Kind::And        : return disjunction(transformed(&RtFormula::negate));
+			case Kind::Or         : return conjunction(transformed(&RtFormula::negate));
+			case Kind::Implies    :
+			case Kind::Equivalent : return simplified().negate();
+			case Kind::Exists     : return unary(Kind::ForAll, N, Children.front().negate());
+			case Kind::ForAll     : return unary(Kind::Exists, N, Children.front().negate());
+		} //switch ( K )
+		return *this;
+	}
+	
+	RtFormula toNegationNormalForm(void) const {
+		const stats::Visit visit{stats::Pass::NegationNormalForm, K};
+		switch ( K ) {
+			case Kind::Predicate  :
+			case Kind::Equality   :
+			case Kind::True       :
+			case Kind::False      : return *this;
+			case Kind::Not        : return Children.front().negate();
+			case Kind::And        :
+			case Kind::Or         : return {K, std::nullopt, {}, transformed(&RtFormula::toNegationNormalForm)};
+			case Kind::Implies    :
+			case Kind::Equivalent : return simplified().toNegationNormalForm();
+			case Kind::Exists     :
+			case Kind::ForAll     : return unary(K, N, Children.front().toNegationNormalForm());
+		} //switch ( K )
+		return *this;
+	}
+	
+	friend bool operator==(const RtFormula& f1, const RtFormula& f2) noexcept {
+		return f1.K == f2.K && f1.N == f2.N && f1.Terms == f2.Terms && f1.Children == f2.Children;
+	}
+	
+	friend bool operator!=(const RtFormula& f1, const RtFormula& f2) noexcept {
+		return !(f1 == f2);
+	}
+	
+	/**
+	 * @brief The canonical order of f1 and f2, negative if f1 comes first, zero if they are equal.
+	 *
+	 * The negations are ignored at first, so a literal is next to its atom, and only break the tie. Otherwise the kinds
+	 * are ordered as declared, nodes of the same kind by their name, their terms, and their children. On static
+	 * formulas it is the order of details::staticOrder().
+	 */
+	static int order(const RtFormula& f1, const RtFormula& f2) noexcept {
+		const RtFormula *stripped1 = &f1, *stripped2 = &f2;
+		std::size_t negations1 = 0, negations2 = 0;
+		for ( ; stripped1->K == Kind::Not; stripped1 = &stripped1->Children.front() ) {
+			++negations1;
+		} //for ( ; stripped1->K == Kind::Not; stripped1 = &stripped1->Children.front() )
+		for ( ; stripped2->K == Kind::Not; stripped2 = &stripped2->Children.front() ) {
+			++negations2;
+		} //for ( ; stripped2->K == Kind::Not; stripped2 = &stripped2->Children.front() )
+		
+		if ( stripped1->K != stripped2->K ) {
+			return stripped1->K < stripped2->K ? -1 : 1;
+		} //if ( stripped1->K != stripped2->K )
+		int ret = stripped1->N && stripped2->N ? RtName::order(*stripped1->N, *stripped2->N) : 0;
+		if ( ret == 0 ) {
+			ret = details::orderSequences(stripped1->Terms, stripped2->Terms);
+		} //if ( ret == 0 )
+		if ( ret == 0 ) {
+			ret = details::orderSequences(stripped1->Children, stripped2->Children);
+		} //if ( ret == 0 )
+		if ( ret == 0 && negations1 != negations2 ) {
+			ret = negations1 < negations2 ? -1 : 1;
+		} //if ( ret == 0 && negations1 != negations2 )
+		return ret;
+	}
+	
+	friend bool operator<(const RtFormula& f1, const RtFormula& f2) noexcept {
+		return order(f1, f2) < 0;
+	}
+	
+	friend std::ostream& operator<<(std::ostream& os, const RtFormula& f) {
+		const stats::Visit visit{stats::Pass::Print, f.K};
+		switch ( f.K ) {
+			case Kind::Predicate  : {
+				os<<*f.N;
+				if ( !f.Terms.empty() ) {
+					os<<'(';
+					f.printJoined(os, f.Terms, ", ");
+					os<<')';
+				} //if ( !f.Terms.empty() )
+				return os;
+			} //case Kind::Predicate
+			case Kind::Equality   : return os<<f.Terms[0]<<" = "<<f.Terms[1];
+			case Kind::Not        : return os<<'-'<<f.Children.front();
+			case Kind::And        : return f.printJoined(os, f.Children, " & ");
+			case Kind::Or         : return f.printJoined(os, f.Children, " | ");
+			case Kind::Implies    : return os<<f.Children[0]<<" -> "<<f.Children[1];
+			case Kind::Equivalent : return os<<f.Children[0]<<" <-> "<<f.Children[1];
+			case Kind::Exists     : return os<<'E'<<*f.N<<": "<<f.Children.front();
+			case Kind::ForAll     : return os<<'A'<<*f.N<<": "<<f.Children.front();
+			case Kind::True       : return os<<True{};
+			case Kind::False      : return os<<False{};
+		} //switch ( f.K )
+		return os;
+	}
+	
+	private:
+	static RtFormula unary(const Kind k, std::optional<RtName> n, RtFormula f) {
+		std::vector<RtFormula> children;
+		children.push_back(std::move(f));
+		stats::allocation(sizeof(RtFormula));
+		return {k, std::move(n), {}, std::move(children)};
+	}
+	
+	static RtFormula binary(const Kind k, RtFormula f1, RtFormula f2) {
+		std::vector<RtFormula> children;
+		children.reserve(2);
+		children.push_back(std::move(f1));
+		children.push_back(std::move(f2));
+		stats::allocation(2 * sizeof(RtFormula));
+		return {k, std::nullopt, {}, std::move(children)};
+	}
+	
+	/**
+	 * @brief Applies the algebraic rules to the simplified operands of a conjunction or disjunction.
+	 *
+	 * The same rules as details::simplifyJunction(), but every operand takes part in the comparisons, and all kept
+	 * operands are put in canonical order.
+	 */
+	static RtFormula simplifiedJunction(const Kind k, std::vector<RtFormula> operands) {
+		const Kind unit = k == Kind::And ? Kind::True : Kind::False;
+		const Kind zero = k == Kind::And ? Kind::False : Kind::True;
+		const Kind dual = k == Kind::And ? Kind::Or : Kind::And;
+		const auto contains = [&operands](const RtFormula& f) noexcept {
+				return std::find(operands.begin(), operands.end(), f) != operands.end();
+			};
+		
+		for ( const auto& operand : operands ) {
+			if ( operand.K == zero || (operand.K == Kind::Not && contains(operand.Children.front())) ) {
+				return constant(zero == Kind::True);
+			} //if ( operand.K == zero || (operand.K == Kind::Not && contains(operand.Children.front())) )
+		} //for ( const auto& operand : operands )
+		
+		std::vector<bool> keep(operands.size(), true);
+		for ( std::size_t i = 0; i < operands.size(); ++i ) {
+			const auto& operand = operands[i];
+			keep[i] = operand.K != unit &&
+			          std::find(operands.begin(), operands.begin() + static_cast<std::ptrdiff_t>(i), operand) ==
+			          operands.begin() + static_cast<std::ptrdiff_t>(i) &&
+			          !(operand.K == dual && std::any_of(operand.Children.begin(), operand.Children.end(), contains));
+		} //for ( std::size_t i = 0; i < operands.size(); ++i )
+		
+		std::vector<RtFormula> kept;
+		for ( std::size_t i = 0; i < operands.size(); ++i ) {
+			if ( keep[i] ) {
+				kept.push_back(std::move(operands[i]));
+			} //if ( keep[i] )
+		} //for ( std::size_t i = 0; i < operands.size(); ++i )
+		
+		if ( kept.empty() ) {
+			return constant(unit == Kind::True);
+		} //if ( kept.empty() )
+		if ( kept.size() == 1 ) {
+			return std::move(kept.front());
+		} //if ( kept.size() == 1 )
+		std::sort(kept.begin(), kept.end());
+		stats::allocation(kept.capacity() * sizeof(RtFormula));
+		return {k, std::nullopt, {}, std::move(kept)};
+	}
+	
+	std::vector<RtFormula> transformed(RtFormula (RtFormula::*transform)(void) const) const {
+		std::vector<RtFormula> ret;
+		ret.reserve(Children.size());
+		stats::allocation(Children.size() * sizeof(RtFormula));
+		for ( const auto& child : Children ) {
+			ret.push_back((child.*transform)());
+		} //for ( const auto& child : Children )
+		return ret;
+	}
+	
+	template<typename T>
+	static std::ostream& printJoined(std::ostream& os, const std::vector<T>& elements, const char *delimiter) {
+		const char *currentDelimiter = "";
+		for ( const auto& element : elements ) {
+			os<<currentDelimiter<<element;
+			currentDelimiter = delimiter;
+		} //for ( const auto& element : elements )
+		return os;
+	}
+};
+
+static_assert(static_cast<std::size_t>(RtFormula::Kind::False) < stats::KindCount);
+
+template<>
+struct PrettyPrinter<RtFormula> {
+	const RtFormula& F;
+	const int Index;
+	
+	PrettyPrinter(const RtFormula& f, int index = -1) : F{f}, Index{index} {
+		return;
+	}
+	
+	std::ostream& prettyPrint(std::ostream& os) const {
+		using Kind = RtFormula::Kind;
+		const stats::Visit visit{stats::Pass::Print, F.K};
+		const auto nextIndex = [](const int index) noexcept {
+				return (index + 1) % static_cast<int>(PrettyParanthesis.size());
+			};
+		
+		switch ( F.K ) {
+			case Kind::Predicate  :
+			case Kind::True       :
+			case Kind::False      : return os<<F;
+			case Kind::Not        : return os<<'-'<<PrettyPrinter{F.Children.front(), std::max(0, Index)};
+			case Kind::Exists     :
+			case Kind::ForAll     : {
+				const int index = std::max(0, Index);
+				const bool withParanthesis = !F.Children.front().isQuantifier();
+				os<<(F.K == Kind::Exists ? 'E' : 'A')<<*F.N;
+				if ( withParanthesis ) {
+					os<<": "<<PrettyParanthesis[static_cast<std::size_t>(index)].first;
+				} //if ( withParanthesis )
+				os<<PrettyPrinter{F.Children.front(), withParanthesis ? nextIndex(index) : index};
+				if ( withParanthesis ) {
+					os<<PrettyParanthesis[static_cast<std::size_t>(index)].second;
+				} //if ( withParanthesis )
+				return os;
+			} //case Kind::Exists, Kind::ForAll
+			default               : break;
+		} //switch ( F.K )
+		
+		const bool withParanthesis = Index != -1;
+		if ( withParanthesis ) {
+			os<<PrettyParanthesis[static_cast<std::size_t>(Index)].first;
+		} //if ( withParanthesis )
+		
+		if ( F.K == Kind::Equality ) {
+			os<<F;
+		} //if ( F.K == Kind::Equality )
+		else {
+			const char *delimiter = F.K == Kind::And ? " & " : F.K == Kind::Or ? " | " :
+			                        F.K == Kind::Implies ? " -> " : " <-> ";
+			const char *currentDelimiter = "";
+			for ( const auto& child : F.Children ) {
+				os<<currentDelimiter<<PrettyPrinter{child, nextIndex(Index)};
+				currentDelimiter = delimiter;
+			} //for ( const auto& child : F.Children )
+		} //else -> if ( F.K == Kind::Equality )
+		
+		if ( withParanthesis ) {
+			os<<PrettyParanthesis[static_cast<std::size_t>(Index)].second;
+		} //if ( withParanthesis )
+		return os;
+	}
+};
+
+namespace details {
+template<char... String>
+RtVariable toRtVariable(const Variable<String...> v) {
+	return RtName{v.N};
+}
+
+inline RtVariable toRtVariable(const RtVariable& v) {
+	return v;
+}
+} //namespace details
+
+/**
+ * @brief Converts a term or formula into its runtime representation.
+ */
+template<char... String>
+RtTerm toRuntime(const Variable<String...> v) {
+	return details::toRtVariable(v);
+}
+
+inline RtTerm toRuntime(const RtVariable& v) {
+	return v;
+}
+
+inline const RtFormula& toRuntime(const RtFormula& f) noexcept {
+	return f;
+}
+
+inline RtFormula toRuntime(const True) {
+	return RtFormula::constant(true);
+}
+
+inline RtFormula toRuntime(const False) {
+	return RtFormula::constant(false);
+}
+
+template<typename NameT, typename... Args>
+RtTerm toRuntime(const Function<NameT, Args...>& f) {
+	return std::apply([&f](const Args&... args) { return RtTerm{RtName{f.N}, {toRuntime(args)...}}; }, f.A);
+}
+
+template<typename NameT, typename... Args>
+RtFormula toRuntime(const Predicate<NameT, Args...>& p) {
+	return std::apply([&p](const Args&... args) { return RtFormula::predicate(RtName{p.N}, {toRuntime(args)...}); },
+	                  p.A);
+}
+
+template<typename T1, typename T2>
+RtFormula toRuntime(const Equality<T1, T2>& e) {
+	return RtFormula::equality(toRuntime(e.Term1), toRuntime(e.Term2));
+}
+
+template<typename T>
+RtFormula toRuntime(const Not<T>& n) {
+	return RtFormula::negation(toRuntime(n.t));
+}
+
+template<typename... Ts>
+RtFormula toRuntime(const And<Ts...>& a) {
+	return RtFormula::conjunction(std::apply([](const Ts&... ts) { return std::vector<RtFormula>{toRuntime(ts)...}; },
+	                                         a.ts));
+}
+
+template<typename... Ts>
+RtFormula toRuntime(const Or<Ts...>& o) {
+	return RtFormula::disjunction(std::apply([](const Ts&... ts) { return std::vector<RtFormula>{toRuntime(ts)...}; },
+	                                         o.ts));
+}
+
+template<typename T1, typename T2>
+RtFormula toRuntime(const Implies<T1, T2>& i) {
+	return RtFormula::implication(toRuntime(i.t1), toRuntime(i.t2));
+}
+
+template<typename T1, typename T2>
+RtFormula toRuntime(const Equivalent<T1, T2>& e) {
+	return RtFormula::equivalence(toRuntime(e.t1), toRuntime(e.t2));
+}
+
+template<typename Var, typename Form>
+RtFormula toRuntime(const Exists<Var, Form>& e) {
+	return RtFormula::exists(details::toRtVariable(e.V), toRuntime(e.F));
+}
+
+template<typename Var, typename Form>
+RtFormula toRuntime(const ForAll<Var, Form>& f) {
+	return RtFormula::forAll(details::toRtVariable(f.V), toRuntime(f.F));
+}
+
+} //namespace fol
+
+namespace std {
+template<>
+struct hash<fol::RtTerm> {
+	std::size_t operator()(const fol::RtTerm& t) const noexcept {
+		std::size_t ret = fol::details::hashCombine(static_cast<std::size_t>(t.K), std::hash<fol::RtName>{}(t.Name));
+		for ( const auto& arg : t.Args ) {
+			ret = fol::details::hashCombine(ret, (*this)(arg));
+		} //for ( const auto& arg : t.Args )
+		return ret;
+	}
+};
+
+template<>
+struct hash<fol::RtFormula> {
+	std::size_t operator()(const fol::RtFormula& f) const noexcept {
+		std::size_t ret = static_cast<std::size_t>(f.K);
+		if ( f.N ) {
+			ret = fol::details::hashCombine(ret, std::hash<fol::RtName>{}(*f.N));
+		} //if ( f.N )
+		for ( const auto& term : f.Terms ) {
+			ret = fol::details::hashCombine(ret, std::hash<fol::RtTerm>{}(term));
+		} //for ( const auto& term : f.Terms )
+		for ( const auto& child : f.Children ) {
+			ret = fol::details::hashCombine(ret, (*this)(child));
+		} //for ( const auto& child : f.Children )
+		return ret;
+	}
+};
+} //namespace std
+
+#endif
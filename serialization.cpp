@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks serialization.hpp for self-containment.
+ * 
+ */
+
+#include "serialization.hpp"
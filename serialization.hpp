@@ -0,0 +1,580 @@
+/**
+ * @file
+ * @brief Contains the binary serialization of runtime formulas.
+ */
+
+#ifndef FOL_SERIALIZATION_HPP
+#define FOL_SERIALIZATION_HPP
+
+#include "rt_formula.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fol {
+
+/**
+ * @brief Layout of the binary format.
+ *
+ * All integers are 32 bit in the byte order of the writer, which is recorded in the header. After the header follow the
+ * symbol offsets (SymbolCount + 1 entries into the symbol blob), the root indices, the nodes and the symbol blob. The
+ * nodes are the formulas in preorder, the terms of a predicate or equality are stored as its children. Every node
+ * records the index one past its subtree, so the next sibling of a node is found without walking its subtree.
+ */
+namespace binary {
+constexpr std::uint32_t Magic     = 0x004c4f46; //"FOL\0" read little endian
+constexpr std::uint32_t ByteOrder = 0x01020304;
+constexpr std::uint32_t Version   = 1;
+constexpr std::uint32_t NoSymbol  = 0xffffffff;
+
+enum class NodeKind : std::uint32_t {
+	Predicate, Equality, Not, And, Or, Implies, Equivalent, Exists, ForAll, True, False, Variable, Function
+};
+
+struct Header {
+	std::uint32_t Magic;
+	std::uint32_t ByteOrder;
+	std::uint32_t Version;
+	std::uint32_t SymbolCount;
+	std::uint32_t SymbolBytes;
+	std::uint32_t RootCount;
+	std::uint32_t NodeCount;
+	std::uint32_t Reserved;
+};
+
+struct Node {
+	NodeKind Kind;
+	std::uint32_t Symbol;
+	std::uint32_t ChildCount;
+	std::uint32_t End;
+};
+
+static_assert(sizeof(Header) == 32);
+static_assert(sizeof(Node) == 16);
+static_assert(static_cast<std::uint32_t>(NodeKind::ForAll) == static_cast<std::uint32_t>(RtFormula::Kind::ForAll));
+static_assert(static_cast<std::uint32_t>(NodeKind::False) == static_cast<std::uint32_t>(RtFormula::Kind::False));
+} //namespace binary
+
+/**
+ * @brief Writes runtime formulas into the binary format.
+ */
+class BinaryWriter {
+	std::vector<std::string> Symbols;
+	std::unordered_map<std::string, std::uint32_t> SymbolIds;
+	std::vector<std::uint32_t> Roots;
+	std::vector<binary::Node> Nodes;
+	
+	std::uint32_t symbol(const RtName& name) {
+		auto [iter, inserted] = SymbolIds.emplace(name.string(), static_cast<std::uint32_t>(Symbols.size()));
+		if ( inserted ) {
+			Symbols.push_back(name.string());
+		} //if ( inserted )
+		return iter->second;
+	}
+	
+	std::size_t open(const binary::NodeKind kind, const std::uint32_t symbol, const std::size_t children) {
+		if ( Nodes.size() >= binary::NoSymbol || children >= binary::NoSymbol ) {
+			throw std::length_error{"Too many nodes for the binary format!"};
+		} //if ( Nodes.size() >= binary::NoSymbol || children >= binary::NoSymbol )
+		Nodes.push_back({kind, symbol, static_cast<std::uint32_t>(children), 0});
+		return Nodes.size() - 1;
+	}
+	
+	void close(const std::size_t index) noexcept {
+		Nodes[index].End = static_cast<std::uint32_t>(Nodes.size());
+		return;
+	}
+	
+	void add(const RtTerm& t) {
+		const auto index = open(t.isVariable() ? binary::NodeKind::Variable : binary::NodeKind::Function,
+		                        symbol(t.Name), t.Args.size());
+		for ( const auto& arg : t.Args ) {
+			add(arg);
+		} //for ( const auto& arg : t.Args )
+		close(index);
+		return;
+	}
+	
+	void addNode(const RtFormula& f) {
+		const auto index = open(static_cast<binary::NodeKind>(f.K), f.N ? symbol(*f.N) : binary::NoSymbol,
+		                        f.Terms.size() + f.Children.size());
+		for ( const auto& term : f.Terms ) {
+			add(term);
+		} //for ( const auto& term : f.Terms )
+		for ( const auto& child : f.Children ) {
+			addNode(child);
+		} //for ( const auto& child : f.Children )
+		close(index);
+		return;
+	}
+	
+	template<typename T>
+	static void append(std::string& out, const T& t) {
+		out.append(reinterpret_cast<const char*>(&t), sizeof(T));
+		return;
+	}
+	
+	public:
+	void add(const RtFormula& f) {
+		Roots.push_back(static_cast<std::uint32_t>(Nodes.size()));
+		addNode(f);
+		return;
+	}
+	
+	std::string bytes(void) const {
+		std::uint32_t symbolBytes = 0;
+		for ( const auto& s : Symbols ) {
+			symbolBytes += static_cast<std::uint32_t>(s.size());
+		} //for ( const auto& s : Symbols )
+		
+		std::string ret;
+		ret.reserve(sizeof(binary::Header) + (Symbols.size() + 1 + Roots.size()) * sizeof(std::uint32_t) +
+		            Nodes.size() * sizeof(binary::Node) + symbolBytes);
+		append(ret, binary::Header{binary::Magic, binary::ByteOrder, binary::Version,
+		                           static_cast<std::uint32_t>(Symbols.size()), symbolBytes,
+		                           static_cast<std::uint32_t>(Roots.size()), static_cast<std::uint32_t>(Nodes.size()),
+		                           0});
+		std::uint32_t offset = 0;
+		append(ret, offset);
+		for ( const auto& s : Symbols ) {
+			offset += static_cast<std::uint32_t>(s.size());
+			append(ret, offset);
+		} //for ( const auto& s : Symbols )
+		for ( const auto root : Roots ) {
+			append(ret, root);
+		} //for ( const auto root : Roots )
+		for ( const auto& node : Nodes ) {
+			append(ret, node);
+		} //for ( const auto& node : Nodes )
+		for ( const auto& s : Symbols ) {
+			ret += s;
+		} //for ( const auto& s : Symbols )
+		return ret;
+	}
+	
+	void write(const std::string& path) const {
+		std::ofstream file{path, std::ios::binary | std::ios::trunc};
+		const auto data = bytes();
+		if ( !file.write(data.data(), static_cast<std::streamsize>(data.size())) ) {
+			throw std::runtime_error{"Could not write " + path + "!"};
+		} //if ( !file.write(data.data(), static_cast<std::streamsize>(data.size())) )
+		return;
+	}
+};
+
+class FormulaImage;
+
+/**
+ * @brief A node of a formula image, read in place.
+ */
+class FormulaView {
+	const FormulaImage *Image;
+	std::uint32_t Index;
+	
+	friend class FormulaImage;
+	
+	FormulaView(const FormulaImage *image, const std::uint32_t index) noexcept : Image{image}, Index{index} {
+		return;
+	}
+	
+	binary::Node node(void) const noexcept;
+	
+	public:
+	binary::NodeKind kind(void) const noexcept {
+		return node().Kind;
+	}
+	
+	bool isTerm(void) const noexcept {
+		return kind() == binary::NodeKind::Variable || kind() == binary::NodeKind::Function;
+	}
+	
+	std::optional<std::string_view> symbol(void) const noexcept;
+	
+	std::size_t childCount(void) const noexcept {
+		return node().ChildCount;
+	}
+	
+	/**
+	 * @brief Returns the first child, the next ones are reached with nextSibling().
+	 */
+	FormulaView firstChild(void) const noexcept {
+		return {Image, Index + 1};
+	}
+	
+	FormulaView nextSibling(void) const noexcept {
+		return {Image, node().End};
+	}
+	
+	/**
+	 * @brief Builds the runtime formula for this node and its subtree.
+	 */
+	RtFormula materialize(void) const;
+};
+
+/**
+ * @brief A view on a buffer in the binary format, nothing is copied or deserialized up front.
+ *
+ * The header, the symbol offsets, the roots and the node structure are checked once on construction, in one pass
+ * without allocating, so the views never read outside of the buffer.
+ */
+class FormulaImage {
+	const char *Data = nullptr;
+	std::size_t Size = 0;
+	binary::Header H{};
+	std::size_t RootsOffset = 0;
+	std::size_t NodesOffset = 0;
+	std::size_t SymbolsOffset = 0;
+	
+	friend class FormulaView;
+	
+	template<typename T>
+	T load(const std::size_t offset) const noexcept {
+		T ret;
+		std::memcpy(&ret, Data + offset, sizeof(T));
+		return ret;
+	}
+	
+	protected:
+	FormulaImage(void) = default;
+	
+	void reset(const char *data, const std::size_t size) {
+		if ( size < sizeof(binary::Header) ) {
+			throw std::invalid_argument{"Buffer too small for a formula image!"};
+		} //if ( size < sizeof(binary::Header) )
+		Data = data;
+		Size = size;
+		H    = load<binary::Header>(0);
+		if ( H.Magic != binary::Magic ) {
+			throw std::invalid_argument{"Not a formula image!"};
+		} //if ( H.Magic != binary::Magic )
+		if ( H.ByteOrder != binary::ByteOrder ) {
+			throw std::invalid_argument{"Formula image has a different byte order!"};
+		} //if ( H.ByteOrder != binary::ByteOrder )
+		if ( H.Version != binary::Version ) {
+			throw std::invalid_argument{"Unsupported formula image version " + std::to_string(H.Version) + "!"};
+		} //if ( H.Version != binary::Version )
+		
+		RootsOffset   = sizeof(binary::Header) + (std::size_t{H.SymbolCount} + 1) * sizeof(std::uint32_t);
+		NodesOffset   = RootsOffset + std::size_t{H.RootCount} * sizeof(std::uint32_t);
+		SymbolsOffset = NodesOffset + std::size_t{H.NodeCount} * sizeof(binary::Node);
+		if ( SymbolsOffset + H.SymbolBytes > Size ) {
+			throw std::invalid_argument{"Formula image is truncated!"};
+		} //if ( SymbolsOffset + H.SymbolBytes > Size )
+		validate();
+		return;
+	}
+	
+	static bool isTermKind(const binary::NodeKind kind) noexcept {
+		return kind == binary::NodeKind::Variable || kind == binary::NodeKind::Function;
+	}
+	
+	/**
+	 * @brief Returns whether a node of the kind may have that many children.
+	 */
+	static bool validChildCount(const binary::NodeKind kind, const std::uint32_t count) noexcept {
+		switch ( kind ) {
+			case binary::NodeKind::Predicate  :
+			case binary::NodeKind::And        :
+			case binary::NodeKind::Or         :
+			case binary::NodeKind::Function   : return true;
+			case binary::NodeKind::Equality   :
+			case binary::NodeKind::Implies    :
+			case binary::NodeKind::Equivalent : return count == 2;
+			case binary::NodeKind::Not        :
+			case binary::NodeKind::Exists     :
+			case binary::NodeKind::ForAll     : return count == 1;
+			case binary::NodeKind::True       :
+			case binary::NodeKind::False      :
+			case binary::NodeKind::Variable   : return count == 0;
+		} //switch ( kind )
+		return false;
+	}
+	
+	/**
+	 * @brief Checks that the symbol offsets lie in the symbol blob and that every node index, symbol id and subtree
+	 * end is in range, with the children of a node exactly filling its subtree.
+	 *
+	 * Each kind has to have its number of children, terms and atoms only term children, the other formulas only
+	 * formula children, and the roots have to be formulas.
+	 */
+	void validate(void) const {
+		std::uint32_t previous = 0;
+		for ( std::size_t id = 0; id <= H.SymbolCount; ++id ) {
+			const auto offset = load<std::uint32_t>(sizeof(binary::Header) + id * sizeof(std::uint32_t));
+			if ( offset < previous || offset > H.SymbolBytes ) {
+				throw std::invalid_argument{"Formula image has an invalid symbol offset!"};
+			} //if ( offset < previous || offset > H.SymbolBytes )
+			previous = offset;
+		} //for ( std::size_t id = 0; id <= H.SymbolCount; ++id )
+		
+		for ( std::size_t index = 0; index < H.RootCount; ++index ) {
+			if ( load<std::uint32_t>(RootsOffset + index * sizeof(std::uint32_t)) >= H.NodeCount ) {
+				throw std::invalid_argument{"Formula image has an invalid root!"};
+			} //if ( load<std::uint32_t>(RootsOffset + index * sizeof(std::uint32_t)) >= H.NodeCount )
+		} //for ( std::size_t index = 0; index < H.RootCount; ++index )
+		
+		const auto nodeAt = [this](const std::size_t index) noexcept {
+				return load<binary::Node>(NodesOffset + index * sizeof(binary::Node));
+			};
+		for ( std::size_t index = 0; index < H.NodeCount; ++index ) {
+			const auto node = nodeAt(index);
+			if ( node.Kind > binary::NodeKind::Function || node.End <= index || node.End > H.NodeCount ) {
+				throw std::invalid_argument{"Formula image has an invalid node!"};
+			} //if ( node.Kind > binary::NodeKind::Function || node.End <= index || node.End > H.NodeCount )
+			const bool named = node.Kind == binary::NodeKind::Predicate || node.Kind == binary::NodeKind::Exists ||
+			                   node.Kind == binary::NodeKind::ForAll || node.Kind == binary::NodeKind::Variable ||
+			                   node.Kind == binary::NodeKind::Function;
+			if ( node.Symbol == binary::NoSymbol ? named : node.Symbol >= H.SymbolCount ) {
+				throw std::invalid_argument{"Formula image has an invalid symbol id!"};
+			} //if ( node.Symbol == binary::NoSymbol ? named : node.Symbol >= H.SymbolCount )
+			if ( !validChildCount(node.Kind, node.ChildCount) ) {
+				throw std::invalid_argument{"Formula image has a node with a wrong number of children!"};
+			} //if ( !validChildCount(node.Kind, node.ChildCount) )
+			
+			//Every node ends after its own index, so the walk over the children terminates.
+			const bool termChildren = isTermKind(node.Kind) || node.Kind == binary::NodeKind::Predicate ||
+			                          node.Kind == binary::NodeKind::Equality;
+			std::size_t child = index + 1;
+			for ( std::uint32_t i = 0; i < node.ChildCount; ++i ) {
+				if ( child >= node.End ) {
+					throw std::invalid_argument{"Formula image has an invalid child!"};
+				} //if ( child >= node.End )
+				const auto childNode = nodeAt(child);
+				if ( isTermKind(childNode.Kind) != termChildren ) {
+					throw std::invalid_argument{"Formula image mixes terms and formulas!"};
+				} //if ( isTermKind(childNode.Kind) != termChildren )
+				child = childNode.End;
+			} //for ( std::uint32_t i = 0; i < node.ChildCount; ++i )
+			if ( child != node.End ) {
+				throw std::invalid_argument{"Formula image has an invalid subtree!"};
+			} //if ( child != node.End )
+		} //for ( std::size_t index = 0; index < H.NodeCount; ++index )
+		
+		for ( std::size_t index = 0; index < H.RootCount; ++index ) {
+			if ( isTermKind(nodeAt(load<std::uint32_t>(RootsOffset + index * sizeof(std::uint32_t))).Kind) ) {
+				throw std::invalid_argument{"Formula image has a term as root!"};
+			} //if ( isTermKind(nodeAt(load<std::uint32_t>(RootsOffset + index * sizeof(std::uint32_t))).Kind) )
+		} //for ( std::size_t index = 0; index < H.RootCount; ++index )
+		return;
+	}
+	
+	public:
+	FormulaImage(const char *data, const std::size_t size) {
+		reset(data, size);
+		return;
+	}
+	
+	std::size_t size(void) const noexcept {
+		return H.RootCount;
+	}
+	
+	std::size_t nodeCount(void) const noexcept {
+		return H.NodeCount;
+	}
+	
+	FormulaView root(const std::size_t index) const {
+		if ( index >= H.RootCount ) {
+			throw std::out_of_range{"Formula index out of range!"};
+		} //if ( index >= H.RootCount )
+		return {this, load<std::uint32_t>(RootsOffset + index * sizeof(std::uint32_t))};
+	}
+	
+	RtFormula formula(const std::size_t index) const {
+		return root(index).materialize();
+	}
+	
+	std::string_view symbol(const std::uint32_t id) const noexcept {
+		const auto begin = load<std::uint32_t>(sizeof(binary::Header) + id * sizeof(std::uint32_t));
+		const auto end   = load<std::uint32_t>(sizeof(binary::Header) + (id + 1u) * sizeof(std::uint32_t));
+		return {Data + SymbolsOffset + begin, end - begin};
+	}
+};
+
+inline binary::Node FormulaView::node(void) const noexcept {
+	return Image->load<binary::Node>(Image->NodesOffset + Index * sizeof(binary::Node));
+}
+
+inline std::optional<std::string_view> FormulaView::symbol(void) const noexcept {
+	const auto id = node().Symbol;
+	if ( id == binary::NoSymbol ) {
+		return std::nullopt;
+	} //if ( id == binary::NoSymbol )
+	return Image->symbol(id);
+}
+
+namespace details {
+/**
+ * @brief Builds the runtime term for a node of a flat view (FormulaView or FlatFormulaView) and its subtree.
+ */
+template<typename View>
+RtTerm materializeTerm(const View& view) {
+	RtName name{std::string{*view.symbol()}};
+	if ( view.kind() == binary::NodeKind::Variable ) {
+		return RtVariable{std::move(name)};
+	} //if ( view.kind() == binary::NodeKind::Variable )
+	
+	const auto childCount = view.childCount();
+	std::vector<RtTerm> args;
+	args.reserve(childCount);
+	auto child = view.firstChild();
+	for ( std::size_t i = 0; i < childCount; ++i, child = child.nextSibling() ) {
+		args.push_back(materializeTerm(child));
+	} //for ( std::size_t i = 0; i < childCount; ++i, child = child.nextSibling() )
+	return {std::move(name), std::move(args)};
+}
+
+/**
+ * @brief Builds the runtime formula for a node of a flat view and its subtree.
+ */
+template<typename View>
+RtFormula materializeFormula(const View& view) {
+	const auto kind = view.kind();
+	if ( view.isTerm() || kind > binary::NodeKind::False ) {
+		throw std::invalid_argument{"Node is not a formula!"};
+	} //if ( view.isTerm() || kind > binary::NodeKind::False )
+	
+	std::optional<RtName> name;
+	if ( const auto s = view.symbol(); s ) {
+		name.emplace(std::string{*s});
+	} //if ( const auto s = view.symbol(); s )
+	
+	const auto childCount = view.childCount();
+	std::vector<RtTerm> terms;
+	std::vector<RtFormula> children;
+	auto child = view.firstChild();
+	for ( std::size_t i = 0; i < childCount; ++i, child = child.nextSibling() ) {
+		if ( child.isTerm() ) {
+			terms.push_back(materializeTerm(child));
+		} //if ( child.isTerm() )
+		else {
+			children.push_back(materializeFormula(child));
+		} //else -> if ( child.isTerm() )
+	} //for ( std::size_t i = 0; i < childCount; ++i, child = child.nextSibling() )
+	return {static_cast<RtFormula::Kind>(kind), std::move(name), std::move(terms), std::move(children)};
+}
+} //namespace details
+
+inline RtFormula FormulaView::materialize(void) const {
+	return details::materializeFormula(*this);
+}
+
+/**
+ * @brief A formula image mapped from a file.
+ */
+class MappedFormulaFile : public FormulaImage {
+	void *Mapping = nullptr;
+	std::size_t MappingSize = 0;
+	
+	void unmap(void) noexcept {
+		if ( Mapping ) {
+#ifdef _WIN32
+			UnmapViewOfFile(Mapping);
+#else
+			munmap(Mapping, MappingSize);
+#endif
+			Mapping = nullptr;
+		} //if ( Mapping )
+		return;
+	}
+	
+	public:
+	explicit MappedFormulaFile(const std::string& path) {
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		                          FILE_ATTRIBUTE_NORMAL, nullptr);
+		if ( file == INVALID_HANDLE_VALUE ) {
+			throw std::system_error{static_cast<int>(GetLastError()), std::system_category(), "Could not open " + path};
+		} //if ( file == INVALID_HANDLE_VALUE )
+		LARGE_INTEGER size;
+		if ( !GetFileSizeEx(file, &size) ) {
+			const auto error = GetLastError();
+			CloseHandle(file);
+			throw std::system_error{static_cast<int>(error), std::system_category(), "Could not stat " + path};
+		} //if ( !GetFileSizeEx(file, &size) )
+		MappingSize = static_cast<std::size_t>(size.QuadPart);
+		if ( MappingSize < sizeof(binary::Header) ) {
+			CloseHandle(file);
+			throw std::invalid_argument{path + " is too small for a formula image!"};
+		} //if ( MappingSize < sizeof(binary::Header) )
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if ( !mapping ) {
+			throw std::system_error{static_cast<int>(GetLastError()), std::system_category(), "Could not map " + path};
+		} //if ( !mapping )
+		Mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+		if ( !Mapping ) {
+			throw std::system_error{static_cast<int>(GetLastError()), std::system_category(), "Could not map " + path};
+		} //if ( !Mapping )
+#else
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if ( fd < 0 ) {
+			throw std::system_error{errno, std::generic_category(), "Could not open " + path};
+		} //if ( fd < 0 )
+		struct stat info;
+		if ( fstat(fd, &info) != 0 ) {
+			const int error = errno;
+			::close(fd);
+			throw std::system_error{error, std::generic_category(), "Could not stat " + path};
+		} //if ( fstat(fd, &info) != 0 )
+		MappingSize = static_cast<std::size_t>(info.st_size);
+		if ( MappingSize < sizeof(binary::Header) ) {
+			::close(fd);
+			throw std::invalid_argument{path + " is too small for a formula image!"};
+		} //if ( MappingSize < sizeof(binary::Header) )
+		void *mapping = mmap(nullptr, MappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		const int error = errno;
+		::close(fd);
+		if ( mapping == MAP_FAILED ) {
+			throw std::system_error{error, std::generic_category(), "Could not map " + path};
+		} //if ( mapping == MAP_FAILED )
+		Mapping = mapping;
+#endif
+		
+		try {
+			reset(static_cast<const char*>(Mapping), MappingSize);
+		} //try
+		catch ( ... ) {
+			unmap();
+			throw;
+		} //catch ( ... )
+		return;
+	}
+	
+	MappedFormulaFile(const MappedFormulaFile&) = delete;
+	MappedFormulaFile& operator=(const MappedFormulaFile&) = delete;
+	
+	~MappedFormulaFile(void) {
+		unmap();
+		return;
+	}
+};
+
+} //namespace fol
+
+#endif
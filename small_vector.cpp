@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks small_vector.hpp for self-containment.
+ * 
+ */
+
+#include "small_vector.hpp"
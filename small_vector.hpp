@@ -0,0 +1,277 @@
+/**
+ * @file
+ * @brief Contains a vector with inline capacity.
+ */
+
+#ifndef FOL_SMALL_VECTOR_HPP
+#define FOL_SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace fol {
+
+/**
+ * @brief A vector which stores up to N elements inside the object and only allocates beyond that.
+ *
+ * The elements are contiguous in either case, the iterators are pointers. Like std::vector a growth invalidates all
+ * iterators, additionally moving a vector whose elements are inline moves the elements.
+ */
+template<typename T, std::size_t N>
+class SmallVector {
+	static_assert(N > 0, "The inline capacity must not be zero!");
+	
+	alignas(T) unsigned char Buffer[N * sizeof(T)];
+	T *Data;
+	std::size_t Size     = 0;
+	std::size_t Capacity = N;
+	
+	T* buffer(void) noexcept {
+		return std::launder(reinterpret_cast<T*>(Buffer));
+	}
+	
+	void release(void) noexcept {
+		if ( !isInline() ) {
+			std::allocator<T>{}.deallocate(Data, Capacity);
+		} //if ( !isInline() )
+		return;
+	}
+	
+	/**
+	 * @brief Moves the elements to new storage of the given capacity.
+	 */
+	void relocate(T *data, const std::size_t capacity) noexcept {
+		std::uninitialized_move(Data, Data + Size, data);
+		std::destroy(Data, Data + Size);
+		release();
+		Data     = data;
+		Capacity = capacity;
+		return;
+	}
+	
+	/**
+	 * @brief Takes the elements of other, which is left empty.
+	 */
+	void take(SmallVector&& other) noexcept {
+		if ( other.isInline() ) {
+			std::uninitialized_move(other.Data, other.Data + other.Size, Data);
+			Size = other.Size;
+			other.clear();
+		} //if ( other.isInline() )
+		else {
+			Data           = other.Data;
+			Size           = other.Size;
+			Capacity       = other.Capacity;
+			other.Data     = other.buffer();
+			other.Size     = 0;
+			other.Capacity = N;
+		} //else -> if ( other.isInline() )
+		return;
+	}
+	
+	public:
+	static_assert(std::is_nothrow_move_constructible_v<T>, "The elements have to be nothrow move constructible!");
+	
+	using value_type      = T;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference       = T&;
+	using const_reference = const T&;
+	using pointer         = T*;
+	using const_pointer   = const T*;
+	using iterator        = T*;
+	using const_iterator  = const T*;
+	
+	SmallVector(void) noexcept : Data{buffer()} {
+		return;
+	}
+	
+	template<typename Iter, typename = typename std::iterator_traits<Iter>::iterator_category>
+	SmallVector(Iter first, const Iter last) : SmallVector{} {
+		for ( ; first != last; ++first ) {
+			emplace_back(*first);
+		} //for ( ; first != last; ++first )
+		return;
+	}
+	
+	SmallVector(const std::initializer_list<T> init) : SmallVector(init.begin(), init.end()) {
+		return;
+	}
+	
+	SmallVector(const SmallVector& other) : SmallVector(other.begin(), other.end()) {
+		return;
+	}
+	
+	SmallVector(SmallVector&& other) noexcept : SmallVector{} {
+		take(std::move(other));
+		return;
+	}
+	
+	~SmallVector(void) {
+		clear();
+		release();
+		return;
+	}
+	
+	SmallVector& operator=(const SmallVector& other) {
+		if ( this != &other ) {
+			SmallVector copy(other);
+			*this = std::move(copy);
+		} //if ( this != &other )
+		return *this;
+	}
+	
+	SmallVector& operator=(SmallVector&& other) noexcept {
+		if ( this != &other ) {
+			clear();
+			release();
+			Data     = buffer();
+			Capacity = N;
+			take(std::move(other));
+		} //if ( this != &other )
+		return *this;
+	}
+	
+	bool isInline(void) const noexcept {
+		return Data == std::launder(reinterpret_cast<const T*>(Buffer));
+	}
+	
+	std::size_t size(void) const noexcept {
+		return Size;
+	}
+	
+	std::size_t capacity(void) const noexcept {
+		return Capacity;
+	}
+	
+	bool empty(void) const noexcept {
+		return Size == 0;
+	}
+	
+	T* data(void) noexcept {
+		return Data;
+	}
+	
+	const T* data(void) const noexcept {
+		return Data;
+	}
+	
+	T* begin(void) noexcept {
+		return Data;
+	}
+	
+	const T* begin(void) const noexcept {
+		return Data;
+	}
+	
+	T* end(void) noexcept {
+		return Data + Size;
+	}
+	
+	const T* end(void) const noexcept {
+		return Data + Size;
+	}
+	
+	T& operator[](const std::size_t index) noexcept {
+		return Data[index];
+	}
+	
+	const T& operator[](const std::size_t index) const noexcept {
+		return Data[index];
+	}
+	
+	T& front(void) noexcept {
+		return Data[0];
+	}
+	
+	const T& front(void) const noexcept {
+		return Data[0];
+	}
+	
+	T& back(void) noexcept {
+		return Data[Size - 1];
+	}
+	
+	const T& back(void) const noexcept {
+		return Data[Size - 1];
+	}
+	
+	void reserve(const std::size_t capacity) {
+		if ( capacity > Capacity ) {
+			relocate(std::allocator<T>{}.allocate(capacity), capacity);
+		} //if ( capacity > Capacity )
+		return;
+	}
+	
+	/**
+	 * @brief Constructs an element at the end, the arguments may refer to elements of the vector itself.
+	 */
+	template<typename... Args>
+	T& emplace_back(Args&&... args) {
+		if ( Size == Capacity ) {
+			const auto capacity = 2 * Capacity;
+			T *data             = std::allocator<T>{}.allocate(capacity);
+			try {
+				::new (static_cast<void*>(data + Size)) T(std::forward<Args>(args)...);
+			} //try
+			catch ( ... ) {
+				std::allocator<T>{}.deallocate(data, capacity);
+				throw;
+			} //catch ( ... )
+			relocate(data, capacity);
+		} //if ( Size == Capacity )
+		else {
+			::new (static_cast<void*>(Data + Size)) T(std::forward<Args>(args)...);
+		} //else -> if ( Size == Capacity )
+		return Data[Size++];
+	}
+	
+	void push_back(const T& t) {
+		emplace_back(t);
+		return;
+	}
+	
+	void push_back(T&& t) {
+		emplace_back(std::move(t));
+		return;
+	}
+	
+	void pop_back(void) noexcept {
+		std::destroy_at(Data + --Size);
+		return;
+	}
+	
+	/**
+	 * @brief Removes the elements [first, last), the following ones are moved to the front.
+	 */
+	T* erase(T *first, T *last) noexcept {
+		T *newEnd = std::move(last, end(), first);
+		std::destroy(newEnd, end());
+		Size = static_cast<std::size_t>(newEnd - Data);
+		return first;
+	}
+	
+	void clear(void) noexcept {
+		std::destroy(Data, Data + Size);
+		Size = 0;
+		return;
+	}
+	
+	friend bool operator==(const SmallVector& v1, const SmallVector& v2) {
+		return std::equal(v1.begin(), v1.end(), v2.begin(), v2.end());
+	}
+	
+	friend bool operator!=(const SmallVector& v1, const SmallVector& v2) {
+		return !(v1 == v2);
+	}
+};
+
+} //namespace fol
+
+#endif
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks stats.hpp for self-containment.
+ * 
+ */
+
+#include "stats.hpp"
@@ -0,0 +1,278 @@
+/**
+ * @file
+ * @brief Contains the opt-in instrumentation of the runtime transformations.
+ *
+ * The counting is compiled in when FOL_ENABLE_STATS is defined (CONFIG += stats), otherwise stats::Visit is an empty
+ * type and the hooks vanish.
+ */
+
+#ifndef FOL_STATS_HPP
+#define FOL_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace fol {
+
+namespace stats {
+
+#ifdef FOL_ENABLE_STATS
+constexpr bool Enabled = true;
+#else
+constexpr bool Enabled = false;
+#endif
+
+enum class Pass : std::uint8_t { Simplify, Negate, NegationNormalForm, Print };
+
+constexpr std::size_t PassCount = 4;
+
+/**
+ * @brief The number of node kinds the visits are counted for, RtFormula::Kind has to fit.
+ */
+constexpr std::size_t KindCount = 11;
+
+constexpr const char* passName(const Pass pass) noexcept {
+	switch ( pass ) {
+		case Pass::Simplify           : return "simplified";
+		case Pass::Negate             : return "negate";
+		case Pass::NegationNormalForm : return "toNegationNormalForm";
+		case Pass::Print              : return "print";
+	} //switch ( pass )
+	return "";
+}
+
+/**
+ * @brief The counters of one pass or of all passes of one kind.
+ *
+ * Nested calls, e.g. the negate() calls of toNegationNormalForm(), count to the outermost pass. Allocations are the
+ * child vectors the pass creates.
+ */
+struct PassStats {
+	std::array<std::uint64_t, KindCount> Visits{};
+	std::uint64_t Calls       = 0;
+	std::uint64_t Allocations = 0;
+	std::uint64_t Bytes       = 0;
+	std::size_t MaxDepth      = 0;
+	std::chrono::nanoseconds Elapsed{0};
+	
+	std::uint64_t visits(void) const noexcept {
+		return std::accumulate(Visits.begin(), Visits.end(), std::uint64_t{0});
+	}
+	
+	PassStats& operator+=(const PassStats& s) noexcept {
+		for ( std::size_t kind = 0; kind < KindCount; ++kind ) {
+			Visits[kind] += s.Visits[kind];
+		} //for ( std::size_t kind = 0; kind < KindCount; ++kind )
+		Calls       += s.Calls;
+		Allocations += s.Allocations;
+		Bytes       += s.Bytes;
+		MaxDepth     = std::max(MaxDepth, s.MaxDepth);
+		Elapsed     += s.Elapsed;
+		return *this;
+	}
+};
+
+/**
+ * @brief One outermost pass, as it ends up in the trace.
+ */
+struct TraceEvent {
+	Pass P;
+	std::uint32_t Thread;
+	std::chrono::nanoseconds Start;
+	std::chrono::nanoseconds Duration;
+	std::uint64_t Visits;
+	std::uint64_t Allocations;
+	std::size_t MaxDepth;
+};
+
+/**
+ * @brief Receives the counters of the passes run by the threads it is installed in.
+ *
+ * The threads count into thread local storage and only lock the collector once at the end of an outermost pass.
+ */
+class Collector {
+	mutable std::mutex Mutex;
+	std::array<PassStats, PassCount> Passes;
+	std::vector<TraceEvent> Events;
+	std::chrono::steady_clock::time_point Origin = std::chrono::steady_clock::now();
+	
+	public:
+	void record(const Pass pass, const PassStats& s, const std::uint32_t thread,
+	            const std::chrono::steady_clock::time_point start,
+	            const std::chrono::steady_clock::time_point end) noexcept {
+		std::lock_guard lock{Mutex};
+		auto& passStats = Passes[static_cast<std::size_t>(pass)];
+		passStats += s;
+		++passStats.Calls;
+		passStats.Elapsed += end - start;
+		try {
+			Events.push_back({pass, thread, start - Origin, end - start, s.visits(), s.Allocations, s.MaxDepth});
+		} //try
+		catch ( ... ) {
+			//The counters are still right, only the trace misses the event.
+		} //catch ( ... )
+		return;
+	}
+	
+	PassStats stats(const Pass pass) const {
+		std::lock_guard lock{Mutex};
+		return Passes[static_cast<std::size_t>(pass)];
+	}
+	
+	std::vector<TraceEvent> events(void) const {
+		std::lock_guard lock{Mutex};
+		return Events;
+	}
+	
+	void clear(void) {
+		std::lock_guard lock{Mutex};
+		Passes = {};
+		Events.clear();
+		Origin = std::chrono::steady_clock::now();
+		return;
+	}
+	
+	/**
+	 * @brief Writes the events in the Chrome trace event format, loadable in chrome://tracing or Perfetto.
+	 */
+	std::ostream& writeChromeTrace(std::ostream& os) const {
+		using Micro = std::chrono::duration<double, std::micro>;
+		const auto events = this->events();
+		os<<"{\"traceEvents\":[";
+		const char *delimiter = "";
+		for ( const auto& event : events ) {
+			os<<delimiter<<"{\"name\":\""<<passName(event.P)<<"\",\"cat\":\"fol\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+			  <<event.Thread<<",\"ts\":"<<Micro{event.Start}.count()<<",\"dur\":"<<Micro{event.Duration}.count()
+			  <<",\"args\":{\"visits\":"<<event.Visits<<",\"allocations\":"<<event.Allocations<<",\"maxDepth\":"
+			  <<event.MaxDepth<<"}}";
+			delimiter = ",\n";
+		} //for ( const auto& event : events )
+		return os<<"],\"displayTimeUnit\":\"ns\"}\n";
+	}
+};
+
+namespace details {
+struct ThreadState {
+	Collector *Target = nullptr;
+	Pass CurrentPass  = Pass::Simplify;
+	std::size_t Depth = 0;
+	PassStats Current;
+	std::chrono::steady_clock::time_point Start;
+};
+
+inline ThreadState& threadState(void) noexcept {
+	thread_local ThreadState state;
+	return state;
+}
+
+inline std::uint32_t threadId(void) noexcept {
+	static std::atomic<std::uint32_t> nextId{1};
+	thread_local const std::uint32_t id = nextId++;
+	return id;
+}
+
+/**
+ * @brief Counts the visit of one node for the lifetime of the object.
+ */
+class CountingVisit {
+	ThreadState *State;
+	
+	public:
+	template<typename Kind>
+	CountingVisit(const Pass pass, const Kind kind) noexcept : State{&threadState()} {
+		if ( !State->Target ) {
+			State = nullptr;
+			return;
+		} //if ( !State->Target )
+		
+		if ( State->Depth == 0 ) {
+			State->CurrentPass = pass;
+			State->Current     = {};
+			State->Start       = std::chrono::steady_clock::now();
+		} //if ( State->Depth == 0 )
+		++State->Current.Visits[static_cast<std::size_t>(kind)];
+		State->Current.MaxDepth = std::max(State->Current.MaxDepth, ++State->Depth);
+		return;
+	}
+	
+	CountingVisit(const CountingVisit&) = delete;
+	CountingVisit& operator=(const CountingVisit&) = delete;
+	
+	~CountingVisit(void) {
+		if ( State && --State->Depth == 0 ) {
+			State->Target->record(State->CurrentPass, State->Current, threadId(), State->Start,
+			                      std::chrono::steady_clock::now());
+		} //if ( State && --State->Depth == 0 )
+		return;
+	}
+};
+
+struct NoVisit {
+	template<typename Kind>
+	constexpr NoVisit(const Pass, const Kind) noexcept {
+		return;
+	}
+};
+} //namespace details
+
+/**
+ * @brief Put at the start of a transformation of one node: const stats::Visit visit{pass, kind};
+ */
+using Visit = std::conditional_t<Enabled, details::CountingVisit, details::NoVisit>;
+
+/**
+ * @brief Counts an allocation of the current pass.
+ */
+inline void allocation(const std::size_t bytes) noexcept {
+	if constexpr ( Enabled ) {
+		auto& state = details::threadState();
+		if ( state.Target && state.Depth != 0 ) {
+			++state.Current.Allocations;
+			state.Current.Bytes += bytes;
+		} //if ( state.Target && state.Depth != 0 )
+	} //if constexpr ( Enabled )
+	return;
+}
+
+/**
+ * @brief Returns the collector installed in this thread, or nullptr.
+ */
+inline Collector* current(void) noexcept {
+	return details::threadState().Target;
+}
+
+/**
+ * @brief Installs a collector in this thread for the lifetime of the object, restoring the previous one afterwards.
+ */
+class Install {
+	Collector *Previous;
+	
+	public:
+	explicit Install(Collector *collector) noexcept : Previous{details::threadState().Target} {
+		details::threadState().Target = collector;
+		return;
+	}
+	
+	Install(const Install&) = delete;
+	Install& operator=(const Install&) = delete;
+	
+	~Install(void) {
+		details::threadState().Target = Previous;
+		return;
+	}
+};
+
+} //namespace stats
+
+} //namespace fol
+
+#endif
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks storage.hpp for self-containment.
+ * 
+ */
+
+#include "storage.hpp"
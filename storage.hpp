@@ -0,0 +1,124 @@
+/**
+ * @file
+ * @brief Contains the member storage of the nodes, which does not spend memory on stateless members.
+ */
+
+#ifndef FOL_STORAGE_HPP
+#define FOL_STORAGE_HPP
+
+#include "traits.hpp"
+
+#include <tuple>
+#include <type_traits>
+
+namespace fol {
+
+namespace details {
+/**
+ * @brief Whether every object of T is equal to T{}, so a member of type T does not have to be stored.
+ */
+template<typename T>
+struct IsStateless : std::bool_constant<IsStatic<T>::value && std::is_empty_v<T>> { };
+
+template<typename... Ts>
+struct IsStateless<std::tuple<Ts...>> : std::bool_constant<(IsStateless<Ts>::value && ...)> { };
+
+/* The nodes derive from one of the following bases per member. A stateful member is an ordinary data member, a
+ * stateless one a static constant, so the node stays empty and costs no byte inside its parent. Even repeated types,
+ * which could not share an address as empty members or bases, vanish this way. Both forms can be initialized from a
+ * value of the member type, so the nodes keep their aggregate and constructor syntax. */
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredN { T N; };
+
+template<typename T>
+struct StoredN<T, true> {
+	static constexpr T N{};
+	constexpr StoredN(T = {}) noexcept { return; }
+};
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredA { T A; };
+
+template<typename T>
+struct StoredA<T, true> {
+	static constexpr T A{};
+	constexpr StoredA(T = {}) noexcept { return; }
+};
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredTs { T ts; };
+
+template<typename T>
+struct StoredTs<T, true> {
+	static constexpr T ts{};
+	constexpr StoredTs(T = {}) noexcept { return; }
+};
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredT { T t; };
+
+template<typename T>
+struct StoredT<T, true> {
+	static constexpr T t{};
+	constexpr StoredT(T = {}) noexcept { return; }
+};
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredT1 { T t1; };
+
+template<typename T>
+struct StoredT1<T, true> {
+	static constexpr T t1{};
+	constexpr StoredT1(T = {}) noexcept { return; }
+};
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredT2 { T t2; };
+
+template<typename T>
+struct StoredT2<T, true> {
+	static constexpr T t2{};
+	constexpr StoredT2(T = {}) noexcept { return; }
+};
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredTerm1 { T Term1; };
+
+template<typename T>
+struct StoredTerm1<T, true> {
+	static constexpr T Term1{};
+	constexpr StoredTerm1(T = {}) noexcept { return; }
+};
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredTerm2 { T Term2; };
+
+template<typename T>
+struct StoredTerm2<T, true> {
+	static constexpr T Term2{};
+	constexpr StoredTerm2(T = {}) noexcept { return; }
+};
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredV { T V; };
+
+template<typename T>
+struct StoredV<T, true> {
+	static constexpr T V{};
+	constexpr StoredV(T = {}) noexcept { return; }
+};
+
+template<typename T, bool = IsStateless<T>::value>
+struct StoredF { T F; };
+
+template<typename T>
+struct StoredF<T, true> {
+	static constexpr T F{};
+	constexpr StoredF(T = {}) noexcept { return; }
+};
+} //namespace details
+
+} //namespace fol
+
+#endif
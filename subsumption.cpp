@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks subsumption.hpp for self-containment.
+ * 
+ */
+
+#include "subsumption.hpp"
@@ -0,0 +1,621 @@
+/**
+ * @file
+ * @brief Contains the subsumption of first order clauses and a feature vector index for it.
+ */
+
+#ifndef FOL_SUBSUMPTION_HPP
+#define FOL_SUBSUMPTION_HPP
+
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+namespace details {
+/**
+ * @brief Encodes clauses as flat arrays of cells.
+ *
+ * A clause is its number of literals and variables, followed by its literals. A literal is a header cell with the
+ * predicate and its negation, followed by the arguments in preorder. A symbol cell holds the id and the arity, so the
+ * end of a term is found without a symbol table, a variable cell holds the number of the variable in its clause. The
+ * equality is the predicate 0, the ids of all other symbols are below SymbolLimit.
+ */
+class ClauseEncoder {
+	public:
+	static constexpr std::uint32_t VariableFlag  = 1;
+	static constexpr std::uint32_t MaxArity      = 0xff;
+	static constexpr std::uint32_t SymbolLimit   = (1u << 23) - 1;
+	
+	private:
+	std::unordered_map<RtName, std::uint32_t> Predicates;
+	std::unordered_map<RtName, std::uint32_t> Functions;
+	
+	template<typename Lookup>
+	static void encodeTerm(const RtTerm& t, std::vector<RtName>& variables, std::vector<std::uint32_t>& out,
+	                       Lookup& lookup) {
+		if ( t.isVariable() ) {
+			const auto iter = std::find(variables.begin(), variables.end(), t.Name);
+			out.push_back(variable(static_cast<std::uint32_t>(iter - variables.begin())));
+			if ( iter == variables.end() ) {
+				variables.push_back(t.Name);
+			} //if ( iter == variables.end() )
+			return;
+		} //if ( t.isVariable() )
+		out.push_back(symbol(lookup(false, t.Name), t.Args.size()));
+		for ( const auto& arg : t.Args ) {
+			encodeTerm(arg, variables, out, lookup);
+		} //for ( const auto& arg : t.Args )
+		return;
+	}
+	
+	template<typename Lookup>
+	static void encodeWith(const RtFormula& clause, std::vector<std::uint32_t>& out, Lookup lookup) {
+		const bool isJunction = clause.K == RtFormula::Kind::Or;
+		const std::size_t start = out.size();
+		out.push_back(static_cast<std::uint32_t>(isJunction ? clause.Children.size() : 1));
+		out.push_back(0);
+		std::vector<RtName> variables;
+		for ( std::size_t i = 0; i < (isJunction ? clause.Children.size() : 1); ++i ) {
+			const auto& literal = isJunction ? clause.Children[i] : clause;
+			const bool negated  = literal.K == RtFormula::Kind::Not;
+			const auto& atom    = negated ? literal.Children.front() : literal;
+			if ( !atom.isAtom() ) {
+				throw std::invalid_argument{"A literal has to be an atom or a negated atom!"};
+			} //if ( !atom.isAtom() )
+			const auto id = atom.K == RtFormula::Kind::Equality ? 0 : lookup(true, *atom.N);
+			out.push_back(symbol(id, atom.Terms.size()) | (negated ? 1u : 0u));
+			for ( const auto& t : atom.Terms ) {
+				encodeTerm(t, variables, out, lookup);
+			} //for ( const auto& t : atom.Terms )
+		} //for ( std::size_t i = 0; i < (isJunction ? clause.Children.size() : 1); ++i )
+		out[start + 1] = static_cast<std::uint32_t>(variables.size());
+		return;
+	}
+	
+	public:
+	static constexpr std::uint32_t symbol(const std::uint32_t id, const std::size_t arity) {
+		if ( arity > MaxArity ) {
+			throw std::length_error{"Too many arguments for the clause encoding!"};
+		} //if ( arity > MaxArity )
+		return id << 9 | static_cast<std::uint32_t>(arity) << 1;
+	}
+	
+	static constexpr std::uint32_t variable(const std::uint32_t number) noexcept {
+		return number << 1 | VariableFlag;
+	}
+	
+	static constexpr bool isVariable(const std::uint32_t cell) noexcept {
+		return cell & VariableFlag;
+	}
+	
+	static constexpr std::uint32_t arity(const std::uint32_t cell) noexcept {
+		return isVariable(cell) ? 0 : (cell >> 1) & MaxArity;
+	}
+	
+	static constexpr std::uint32_t id(const std::uint32_t cell) noexcept {
+		return cell >> 9;
+	}
+	
+	/**
+	 * @brief The arity of a literal header, whose lowest bit is the negation instead of the variable flag.
+	 */
+	static constexpr std::uint32_t literalArity(const std::uint32_t header) noexcept {
+		return (header >> 1) & MaxArity;
+	}
+	
+	/**
+	 * @brief Returns the position after the term starting at pos.
+	 */
+	static std::size_t termEnd(const std::uint32_t *cells, std::size_t pos) noexcept {
+		for ( std::size_t pending = 1; pending > 0; --pending ) {
+			pending += arity(cells[pos++]);
+		} //for ( std::size_t pending = 1; pending > 0; --pending )
+		return pos;
+	}
+	
+	static std::size_t literalEnd(const std::uint32_t *cells, std::size_t pos) noexcept {
+		for ( auto arg = literalArity(cells[pos++]); arg > 0; --arg ) {
+			pos = termEnd(cells, pos);
+		} //for ( auto arg = literalArity(cells[pos++]); arg > 0; --arg )
+		return pos;
+	}
+	
+	/**
+	 * @brief Appends the clause, interning its symbols.
+	 */
+	void encode(const RtFormula& clause, std::vector<std::uint32_t>& out) {
+		encodeWith(clause, out, [this](const bool predicate, const RtName& name) {
+				auto& table = predicate ? Predicates : Functions;
+				const auto first = predicate ? 1u : 0u;
+				const auto iter  = table.find(name);
+				if ( iter != table.end() ) {
+					return iter->second;
+				} //if ( iter != table.end() )
+				if ( table.size() + first >= SymbolLimit ) {
+					throw std::length_error{"Too many symbols for the clause encoding!"};
+				} //if ( table.size() + first >= SymbolLimit )
+				return table.emplace(name, static_cast<std::uint32_t>(table.size()) + first).first->second;
+			});
+		return;
+	}
+	
+	/**
+	 * @brief Appends the clause without interning, the symbols which were not interned get distinct ids after the
+	 * interned ones, valid for this clause only.
+	 */
+	void encode(const RtFormula& clause, std::vector<std::uint32_t>& out) const {
+		std::unordered_map<RtName, std::uint32_t> unknownPredicates, unknownFunctions;
+		encodeWith(clause, out, [this, &unknownPredicates, &unknownFunctions](const bool predicate,
+		                                                                       const RtName& name) {
+				const auto& table = predicate ? Predicates : Functions;
+				const auto iter   = table.find(name);
+				if ( iter != table.end() ) {
+					return iter->second;
+				} //if ( iter != table.end() )
+				auto& unknown    = predicate ? unknownPredicates : unknownFunctions;
+				const auto first = static_cast<std::uint32_t>(table.size()) + (predicate ? 1u : 0u);
+				if ( first + unknown.size() >= SymbolLimit ) {
+					throw std::length_error{"Too many symbols for the clause encoding!"};
+				} //if ( first + unknown.size() >= SymbolLimit )
+				return unknown.emplace(name, first + static_cast<std::uint32_t>(unknown.size())).first->second;
+			});
+		return;
+	}
+};
+
+/**
+ * @brief Decides whether an encoded clause subsumes another one.
+ *
+ * Every literal of the first clause has to be mapped to a different literal of the second one, such that one
+ * substitution of the variables of the first clause makes them equal. The variables of the second clause are treated
+ * as constants. The literals are matched by backtracking, the largest literals of the first clause first, equalities
+ * are tried in both orientations, each one is a choice point. The buffers are kept between calls.
+ */
+class ClauseMatcher {
+	static constexpr std::uint32_t Unbound = std::numeric_limits<std::uint32_t>::max();
+	
+	const std::uint32_t *C = nullptr;
+	const std::uint32_t *D = nullptr;
+	std::vector<std::uint32_t> CLiterals;
+	std::vector<std::uint32_t> DLiterals;
+	std::vector<std::uint32_t> Bindings;
+	std::vector<std::uint32_t> Trail;
+	std::vector<bool> Used;
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> BySize;
+	
+	static void literalsOf(const std::uint32_t *clause, std::vector<std::uint32_t>& out) {
+		out.clear();
+		std::size_t pos = 2;
+		for ( std::uint32_t i = 0; i < clause[0]; ++i ) {
+			out.push_back(static_cast<std::uint32_t>(pos));
+			pos = ClauseEncoder::literalEnd(clause, pos);
+		} //for ( std::uint32_t i = 0; i < clause[0]; ++i )
+		return;
+	}
+	
+	bool sameTerm(std::size_t d1, std::size_t d2) const noexcept {
+		const auto end = ClauseEncoder::termEnd(D, d1);
+		for ( ; d1 < end; ++d1, ++d2 ) {
+			if ( D[d1] != D[d2] ) {
+				return false;
+			} //if ( D[d1] != D[d2] )
+		} //for ( ; d1 < end; ++d1, ++d2 )
+		return true;
+	}
+	
+	/**
+	 * @brief Matches the term of C at c against the one of D at d, advancing both positions.
+	 */
+	bool matchTerm(std::size_t& c, std::size_t& d) {
+		const auto cell = C[c++];
+		if ( ClauseEncoder::isVariable(cell) ) {
+			auto& binding = Bindings[cell >> 1];
+			const auto end = ClauseEncoder::termEnd(D, d);
+			if ( binding == Unbound ) {
+				binding = static_cast<std::uint32_t>(d);
+				Trail.push_back(cell >> 1);
+			} //if ( binding == Unbound )
+			else if ( !sameTerm(binding, d) ) {
+				return false;
+			} //else if ( !sameTerm(binding, d) )
+			d = end;
+			return true;
+		} //if ( ClauseEncoder::isVariable(cell) )
+		if ( cell != D[d++] ) {
+			return false;
+		} //if ( cell != D[d++] )
+		for ( auto arg = ClauseEncoder::arity(cell); arg > 0; --arg ) {
+			if ( !matchTerm(c, d) ) {
+				return false;
+			} //if ( !matchTerm(c, d) )
+		} //for ( auto arg = ClauseEncoder::arity(cell); arg > 0; --arg )
+		return true;
+	}
+	
+	void undo(const std::size_t mark) noexcept {
+		while ( Trail.size() > mark ) {
+			Bindings[Trail.back()] = Unbound;
+			Trail.pop_back();
+		} //while ( Trail.size() > mark )
+		return;
+	}
+	
+	static bool isEquality(const std::uint32_t head) noexcept {
+		return ClauseEncoder::id(head) == 0;
+	}
+	
+	/**
+	 * @brief Matches the literal of C at c against the one of D at d, with the sides of an equality of D swapped if
+	 * requested.
+	 */
+	bool matchLiteral(std::size_t c, std::size_t d, const bool swapped) {
+		if ( C[c] != D[d] ) {
+			return false;
+		} //if ( C[c] != D[d] )
+		const auto cFirst = c + 1, dFirst = d + 1;
+		c = cFirst;
+		d = dFirst;
+		if ( swapped ) {
+			auto cSecond = ClauseEncoder::termEnd(C, cFirst), dSecond = ClauseEncoder::termEnd(D, dFirst);
+			return matchTerm(c, dSecond) && matchTerm(cSecond, d);
+		} //if ( swapped )
+		for ( auto arg = ClauseEncoder::literalArity(C[cFirst - 1]); arg > 0; --arg ) {
+			if ( !matchTerm(c, d) ) {
+				return false;
+			} //if ( !matchTerm(c, d) )
+		} //for ( auto arg = ClauseEncoder::literalArity(C[cFirst - 1]); arg > 0; --arg )
+		return true;
+	}
+	
+	bool search(const std::size_t literal) {
+		if ( literal == CLiterals.size() ) {
+			return true;
+		} //if ( literal == CLiterals.size() )
+		//The orientation of an equality is a choice point, the first one may bind variables the rest cannot use.
+		const int orientations = isEquality(C[CLiterals[literal]]) ? 2 : 1;
+		for ( std::size_t candidate = 0; candidate < DLiterals.size(); ++candidate ) {
+			if ( Used[candidate] ) {
+				continue;
+			} //if ( Used[candidate] )
+			for ( int orientation = 0; orientation < orientations; ++orientation ) {
+				const auto mark = Trail.size();
+				if ( matchLiteral(CLiterals[literal], DLiterals[candidate], orientation == 1) ) {
+					Used[candidate] = true;
+					if ( search(literal + 1) ) {
+						return true;
+					} //if ( search(literal + 1) )
+					Used[candidate] = false;
+				} //if ( matchLiteral(CLiterals[literal], DLiterals[candidate], orientation == 1) )
+				undo(mark);
+			} //for ( int orientation = 0; orientation < orientations; ++orientation )
+		} //for ( std::size_t candidate = 0; candidate < DLiterals.size(); ++candidate )
+		return false;
+	}
+	
+	public:
+	bool operator()(const std::uint32_t *c, const std::uint32_t *d) {
+		if ( c[0] > d[0] ) {
+			return false;
+		} //if ( c[0] > d[0] )
+		C = c;
+		D = d;
+		literalsOf(C, CLiterals);
+		literalsOf(D, DLiterals);
+		Bindings.assign(C[1], Unbound);
+		Trail.clear();
+		Used.assign(DLiterals.size(), false);
+		
+		BySize.clear();
+		for ( const auto literal : CLiterals ) {
+			BySize.emplace_back(static_cast<std::uint32_t>(ClauseEncoder::literalEnd(C, literal) - literal), literal);
+		} //for ( const auto literal : CLiterals )
+		std::sort(BySize.begin(), BySize.end(), std::greater<>{});
+		for ( std::size_t i = 0; i < BySize.size(); ++i ) {
+			CLiterals[i] = BySize[i].second;
+		} //for ( std::size_t i = 0; i < BySize.size(); ++i )
+		return search(0);
+	}
+};
+} //namespace details
+
+/**
+ * @brief Returns whether the clause c subsumes the clause d, i.e. c instantiated is a sub-multiset of d.
+ *
+ * A clause is a literal or a disjunction of literals, as for ClauseStore::add().
+ */
+inline bool subsumes(const RtFormula& c, const RtFormula& d) {
+	details::ClauseEncoder encoder;
+	std::vector<std::uint32_t> cCells, dCells;
+	encoder.encode(c, cCells);
+	encoder.encode(d, dCells);
+	return details::ClauseMatcher{}(cCells.data(), dCells.data());
+}
+
+template<typename T1, typename T2, std::enable_if_t<IsFormula<T1>::value && IsFormula<T2>::value>* = nullptr>
+bool subsumes(const T1& c, const T2& d) {
+	return subsumes(toRuntime(c), toRuntime(d));
+}
+
+/**
+ * @brief Stores clauses in a trie over their feature vectors, to find the clauses subsuming or subsumed by a query.
+ *
+ * The features count the literals per predicate and polarity, the occurrences of function symbols per polarity, and
+ * the maximal depth of a function symbol per polarity. Symbols are hashed into Buckets buckets per feature, a bucket
+ * holds the sum of its counts and the maximum of its depths. Instantiating a clause and adding literals never
+ * decreases a feature, so a clause can only subsume a clause whose features are all at least as large. A query only
+ * descends into the children of a trie node which satisfy this for the feature of the node, only the clauses in the
+ * reached leaves are given to the matcher. With zero buckets all clauses share one leaf and are matched linearly.
+ */
+class SubsumptionIndex {
+	public:
+	using ClauseId = std::uint32_t;
+	
+	struct Options {
+		std::size_t Buckets = 4;
+	};
+	
+	private:
+	using Encoder = details::ClauseEncoder;
+	
+	static constexpr std::uint32_t NoNode = std::numeric_limits<std::uint32_t>::max();
+	
+	/**
+	 * @brief A node of the trie, Present and Required are the union and the intersection of the feature masks of the
+	 * clauses below it.
+	 */
+	struct TrieNode {
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> Children;
+		std::vector<ClauseId> Clauses;
+		std::uint64_t Present  = 0;
+		std::uint64_t Required = std::numeric_limits<std::uint64_t>::max();
+	};
+	
+	Encoder Symbols;
+	std::vector<std::uint32_t> Cells;
+	std::vector<std::size_t> Offsets{0};
+	std::vector<bool> Removed;
+	std::vector<TrieNode> Trie{1};
+	std::size_t Buckets;
+	std::size_t RemovedClauses = 0;
+	
+	std::size_t collectFeatures(const std::uint32_t *cells, std::size_t pos, const std::uint32_t depth,
+	                            const std::size_t polarity, std::vector<std::uint32_t>& features) const {
+		const auto cell = cells[pos++];
+		if ( Encoder::isVariable(cell) ) {
+			return pos;
+		} //if ( Encoder::isVariable(cell) )
+		const auto bucket = Encoder::id(cell) % Buckets;
+		++features[(2 + polarity) * Buckets + bucket];
+		auto& maxDepth = features[(4 + polarity) * Buckets + bucket];
+		maxDepth = std::max(maxDepth, depth);
+		for ( auto arg = Encoder::arity(cell); arg > 0; --arg ) {
+			pos = collectFeatures(cells, pos, depth + 1, polarity, features);
+		} //for ( auto arg = Encoder::arity(cell); arg > 0; --arg )
+		return pos;
+	}
+	
+	std::vector<std::uint32_t> features(const std::uint32_t *clause) const {
+		std::vector<std::uint32_t> ret(6 * Buckets, 0);
+		if ( Buckets == 0 ) {
+			return ret;
+		} //if ( Buckets == 0 )
+		std::size_t pos = 2;
+		for ( std::uint32_t literal = 0; literal < clause[0]; ++literal ) {
+			const auto header   = clause[pos++];
+			const auto polarity = static_cast<std::size_t>(header & 1);
+			++ret[polarity * Buckets + Encoder::id(header) % Buckets];
+			for ( auto arg = Encoder::literalArity(header); arg > 0; --arg ) {
+				pos = collectFeatures(clause, pos, 1, polarity, ret);
+			} //for ( auto arg = Encoder::literalArity(header); arg > 0; --arg )
+		} //for ( std::uint32_t literal = 0; literal < clause[0]; ++literal )
+		return ret;
+	}
+	
+	/**
+	 * @brief Returns the mask with bit i % 64 set for every feature i which is not zero.
+	 */
+	static std::uint64_t maskOf(const std::vector<std::uint32_t>& features) noexcept {
+		std::uint64_t ret = 0;
+		for ( std::size_t i = 0; i < features.size(); ++i ) {
+			ret |= (features[i] != 0 ? std::uint64_t{1} : std::uint64_t{0}) << (i % 64);
+		} //for ( std::size_t i = 0; i < features.size(); ++i )
+		return ret;
+	}
+	
+	/**
+	 * @brief Calls visitor with the clauses whose features are all at most (forward) or at least (backward) the
+	 * query's, stops and returns false as soon as the visitor does.
+	 *
+	 * Besides the feature of the current depth the masks of the node prune the subtrees, which lack a feature of the
+	 * query (backward) or where every clause has a feature the query lacks (forward).
+	 */
+	template<typename Visitor>
+	bool traverse(const std::uint32_t node, const std::size_t depth, const std::vector<std::uint32_t>& query,
+	              const std::uint64_t queryMask, const bool forward, Visitor& visitor) const {
+		if ( forward ? (Trie[node].Required & ~queryMask) != 0 : (queryMask & ~Trie[node].Present) != 0 ) {
+			return true;
+		} //if ( forward ? (Trie[node].Required & ~queryMask) != 0 : (queryMask & ~Trie[node].Present) != 0 )
+		if ( depth == query.size() ) {
+			for ( const auto id : Trie[node].Clauses ) {
+				if ( !Removed[id] && !visitor(id) ) {
+					return false;
+				} //if ( !Removed[id] && !visitor(id) )
+			} //for ( const auto id : Trie[node].Clauses )
+			return true;
+		} //if ( depth == query.size() )
+		
+		const auto& children = Trie[node].Children;
+		const auto bound = std::lower_bound(children.begin(), children.end(),
+		                                    std::make_pair(query[depth], std::uint32_t{0}));
+		const auto first = forward ? children.begin() : bound;
+		const auto last  = forward ? std::upper_bound(bound, children.end(),
+		                                              std::make_pair(query[depth], NoNode)) :
+		                             children.end();
+		for ( auto iter = first; iter != last; ++iter ) {
+			if ( !traverse(iter->second, depth + 1, query, queryMask, forward, visitor) ) {
+				return false;
+			} //if ( !traverse(iter->second, depth + 1, query, queryMask, forward, visitor) )
+		} //for ( auto iter = first; iter != last; ++iter )
+		return true;
+	}
+	
+	const std::uint32_t* clause(const ClauseId id) const noexcept {
+		return Cells.data() + Offsets[id];
+	}
+	
+	public:
+	explicit SubsumptionIndex(const Options options) : Buckets{options.Buckets} {
+		return;
+	}
+	
+	SubsumptionIndex(void) : SubsumptionIndex{Options{}} {
+		return;
+	}
+	
+	/**
+	 * @brief Adds a clause, that is a disjunction of literals or a single literal.
+	 */
+	ClauseId add(const RtFormula& c) {
+		if ( Removed.size() >= std::numeric_limits<ClauseId>::max() ) {
+			throw std::length_error{"Too many clauses!"};
+		} //if ( Removed.size() >= std::numeric_limits<ClauseId>::max() )
+		const auto oldSize = Cells.size();
+		try {
+			Symbols.encode(c, Cells);
+		} //try
+		catch ( ... ) {
+			Cells.resize(oldSize);
+			throw;
+		} //catch ( ... )
+		
+		const auto id = static_cast<ClauseId>(Removed.size());
+		const auto clauseFeatures = features(Cells.data() + oldSize);
+		const auto mask           = maskOf(clauseFeatures);
+		std::uint32_t node        = 0;
+		for ( const auto feature : clauseFeatures ) {
+			Trie[node].Present  |= mask;
+			Trie[node].Required &= mask;
+			auto& children = Trie[node].Children;
+			auto iter = std::lower_bound(children.begin(), children.end(), std::make_pair(feature, std::uint32_t{0}));
+			if ( iter == children.end() || iter->first != feature ) {
+				const auto child = static_cast<std::uint32_t>(Trie.size());
+				children.insert(iter, {feature, child});
+				Trie.emplace_back();
+				node = child;
+			} //if ( iter == children.end() || iter->first != feature )
+			else {
+				node = iter->second;
+			} //else -> if ( iter == children.end() || iter->first != feature )
+		} //for ( const auto feature : clauseFeatures )
+		Trie[node].Present  |= mask;
+		Trie[node].Required &= mask;
+		Trie[node].Clauses.push_back(id);
+		Offsets.push_back(Cells.size());
+		Removed.push_back(false);
+		return id;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	ClauseId add(const T& c) {
+		return add(toRuntime(c));
+	}
+	
+	/**
+	 * @brief Removes the clause from the results of the queries.
+	 */
+	void remove(const ClauseId id) {
+		if ( id >= Removed.size() ) {
+			throw std::out_of_range{"Clause index out of range!"};
+		} //if ( id >= Removed.size() )
+		if ( !Removed[id] ) {
+			Removed[id] = true;
+			++RemovedClauses;
+		} //if ( !Removed[id] )
+		return;
+	}
+	
+	bool isRemoved(const ClauseId id) const {
+		return Removed.at(id);
+	}
+	
+	/**
+	 * @brief Returns the number of clause ids, including the removed clauses.
+	 */
+	std::size_t size(void) const noexcept {
+		return Removed.size();
+	}
+	
+	std::size_t liveClauses(void) const noexcept {
+		return Removed.size() - RemovedClauses;
+	}
+	
+	std::size_t trieNodes(void) const noexcept {
+		return Trie.size();
+	}
+	
+	/**
+	 * @brief Forward subsumption, returns a stored clause which subsumes c, if there is one.
+	 */
+	std::optional<ClauseId> findSubsuming(const RtFormula& c) const {
+		std::vector<std::uint32_t> query;
+		Symbols.encode(c, query);
+		details::ClauseMatcher matcher;
+		std::optional<ClauseId> ret;
+		auto visitor = [this, &query, &matcher, &ret](const ClauseId id) {
+				if ( matcher(clause(id), query.data()) ) {
+					ret = id;
+					return false;
+				} //if ( matcher(clause(id), query.data()) )
+				return true;
+			};
+		const auto queryFeatures = features(query.data());
+		traverse(0, 0, queryFeatures, maskOf(queryFeatures), true, visitor);
+		return ret;
+	}
+	
+	/**
+	 * @brief Backward subsumption, returns all stored clauses which are subsumed by c, in ascending order.
+	 */
+	std::vector<ClauseId> findSubsumed(const RtFormula& c) const {
+		std::vector<std::uint32_t> query;
+		Symbols.encode(c, query);
+		details::ClauseMatcher matcher;
+		std::vector<ClauseId> ret;
+		auto visitor = [this, &query, &matcher, &ret](const ClauseId id) {
+				if ( matcher(query.data(), clause(id)) ) {
+					ret.push_back(id);
+				} //if ( matcher(query.data(), clause(id)) )
+				return true;
+			};
+		const auto queryFeatures = features(query.data());
+		traverse(0, 0, queryFeatures, maskOf(queryFeatures), false, visitor);
+		std::sort(ret.begin(), ret.end());
+		return ret;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	std::optional<ClauseId> findSubsuming(const T& c) const {
+		return findSubsuming(toRuntime(c));
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	std::vector<ClauseId> findSubsumed(const T& c) const {
+		return findSubsumed(toRuntime(c));
+	}
+};
+
+} //namespace fol
+
+#endif
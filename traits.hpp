@@ -48,6 +48,12 @@ struct IsAtom<Equality<T1, T2>> : std::true_type { };
 template<typename T>
 struct IsFormula : std::conditional_t<IsAtom<T>::value, std::true_type, std::false_type> { };
 
+template<>
+struct IsFormula<True> : std::true_type { };
+
+template<>
+struct IsFormula<False> : std::true_type { };
+
 static_assert(IsFormula<Predicate<RtName>>::value);
 static_assert(!IsFormula<Function<RtName>>::value);
 
@@ -60,6 +66,12 @@ struct IsFormula<And<Ts...>> : std::true_type { };
 template<typename... Ts>
 struct IsFormula<Or<Ts...>> : std::true_type { };
 
+template<typename T, typename Container>
+struct IsFormula<AndN<T, Container>> : std::true_type { };
+
+template<typename T, typename Container>
+struct IsFormula<OrN<T, Container>> : std::true_type { };
+
 template<typename T1, typename T2>
 struct IsFormula<Implies<T1, T2>> : std::true_type { };
 
@@ -87,6 +99,65 @@ struct IsNot : std::false_type { };
 template<typename T>
 struct IsNot<Not<T>> : std::true_type { };
 
+template<typename T>
+struct IsTruth : std::false_type { };
+
+template<>
+struct IsTruth<True> : std::true_type { };
+
+template<>
+struct IsTruth<False> : std::true_type { };
+
+/**
+ * @brief Whether the value of T is completely determined by its type, i.e. it contains no runtime names.
+ */
+template<typename T>
+struct IsStatic : std::false_type { };
+
+template<char... String>
+struct IsStatic<Name<String...>> : std::true_type { };
+
+template<char c, char... String>
+struct IsStatic<Variable<c, String...>> : std::true_type { };
+
+template<typename Name, typename... Args>
+struct IsStatic<Function<Name, Args...>> :
+		std::bool_constant<IsStatic<Name>::value && (IsStatic<Args>::value && ...)> { };
+
+template<typename Name, typename... Args>
+struct IsStatic<Predicate<Name, Args...>> :
+		std::bool_constant<IsStatic<Name>::value && (IsStatic<Args>::value && ...)> { };
+
+template<typename T1, typename T2>
+struct IsStatic<Equality<T1, T2>> : std::bool_constant<IsStatic<T1>::value && IsStatic<T2>::value> { };
+
+template<>
+struct IsStatic<True> : std::true_type { };
+
+template<>
+struct IsStatic<False> : std::true_type { };
+
+template<typename T>
+struct IsStatic<Not<T>> : IsStatic<T> { };
+
+template<typename... Ts>
+struct IsStatic<And<Ts...>> : std::bool_constant<(IsStatic<Ts>::value && ...)> { };
+
+template<typename... Ts>
+struct IsStatic<Or<Ts...>> : std::bool_constant<(IsStatic<Ts>::value && ...)> { };
+
+template<typename T1, typename T2>
+struct IsStatic<Implies<T1, T2>> : std::bool_constant<IsStatic<T1>::value && IsStatic<T2>::value> { };
+
+template<typename T1, typename T2>
+struct IsStatic<Equivalent<T1, T2>> : std::bool_constant<IsStatic<T1>::value && IsStatic<T2>::value> { };
+
+template<typename Var, typename Form>
+struct IsStatic<Exists<Var, Form>> : std::bool_constant<IsStatic<Var>::value && IsStatic<Form>::value> { };
+
+template<typename Var, typename Form>
+struct IsStatic<ForAll<Var, Form>> : std::bool_constant<IsStatic<Var>::value && IsStatic<Form>::value> { };
+
 } //namespace fol
 
 #endif
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks truth.hpp for self-containment.
+ * 
+ */
+
+#include "truth.hpp"
@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @brief Contains the truth constants.
+ */
+
+#ifndef FOL_TRUTH_HPP
+#define FOL_TRUTH_HPP
+
+#include "forward.hpp"
+
+#include "pretty_printer.hpp"
+
+#include <ostream>
+#include <type_traits>
+
+namespace fol {
+
+struct True {
+	using VariableCount = std::integral_constant<std::size_t, 0>;
+	
+	constexpr True simplified(void) const noexcept { return {}; }
+	
+	constexpr False negate(void) const noexcept;
+	
+	constexpr True toNegationNormalForm(void) const noexcept { return {}; }
+	
+	friend std::ostream& operator<<(std::ostream& os, const True) {
+		return os<<"true";
+	}
+};
+
+struct False {
+	using VariableCount = std::integral_constant<std::size_t, 0>;
+	
+	constexpr False simplified(void) const noexcept { return {}; }
+	
+	constexpr True negate(void) const noexcept { return {}; }
+	
+	constexpr False toNegationNormalForm(void) const noexcept { return {}; }
+	
+	friend std::ostream& operator<<(std::ostream& os, const False) {
+		return os<<"false";
+	}
+};
+
+constexpr False True::negate(void) const noexcept {
+	return {};
+}
+
+constexpr bool operator==(const True, const True) noexcept { return true; }
+constexpr bool operator!=(const True, const True) noexcept { return false; }
+constexpr bool operator==(const False, const False) noexcept { return true; }
+constexpr bool operator!=(const False, const False) noexcept { return false; }
+
+template<>
+struct PrettyPrinter<True> {
+	PrettyPrinter(const True, const int = -1) noexcept {
+		return;
+	}
+	
+	std::ostream& prettyPrint(std::ostream& os) const {
+		return os<<True{};
+	}
+};
+
+template<>
+struct PrettyPrinter<False> {
+	PrettyPrinter(const False, const int = -1) noexcept {
+		return;
+	}
+	
+	std::ostream& prettyPrint(std::ostream& os) const {
+		return os<<False{};
+	}
+};
+
+} //namespace fol
+
+#endif
@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks truth_table.hpp for self-containment.
+ * 
+ */
+
+#include "truth_table.hpp"
@@ -0,0 +1,471 @@
+/**
+ * @file
+ * @brief Contains the bit parallel truth tables of propositional formulas.
+ */
+
+#ifndef FOL_TRUTH_TABLE_HPP
+#define FOL_TRUTH_TABLE_HPP
+
+#include "rt_formula.hpp"
+#include "traits.hpp"
+#include "visit.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define FOL_TRUTH_TABLE_X86
+#include <immintrin.h>
+#endif
+
+namespace fol {
+
+namespace details {
+/* The kernels combine whole rows of words, dst = dst op src. Every instruction set has its own set, the best one the
+ * processor supports is chosen at runtime. */
+
+struct WordKernels {
+	void (*And)(std::uint64_t *dst, const std::uint64_t *src, std::size_t count) noexcept;
+	void (*Or)(std::uint64_t *dst, const std::uint64_t *src, std::size_t count) noexcept;
+	void (*Implies)(std::uint64_t *dst, const std::uint64_t *src, std::size_t count) noexcept;
+	void (*Equivalent)(std::uint64_t *dst, const std::uint64_t *src, std::size_t count) noexcept;
+	void (*Not)(std::uint64_t *dst, std::size_t count) noexcept;
+};
+
+namespace scalar {
+inline void andWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	for ( std::size_t i = 0; i < count; ++i ) {
+		dst[i] &= src[i];
+	} //for ( std::size_t i = 0; i < count; ++i )
+	return;
+}
+
+inline void orWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	for ( std::size_t i = 0; i < count; ++i ) {
+		dst[i] |= src[i];
+	} //for ( std::size_t i = 0; i < count; ++i )
+	return;
+}
+
+inline void impliesWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	for ( std::size_t i = 0; i < count; ++i ) {
+		dst[i] = ~dst[i] | src[i];
+	} //for ( std::size_t i = 0; i < count; ++i )
+	return;
+}
+
+inline void equivalentWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	for ( std::size_t i = 0; i < count; ++i ) {
+		dst[i] = ~(dst[i] ^ src[i]);
+	} //for ( std::size_t i = 0; i < count; ++i )
+	return;
+}
+
+inline void notWords(std::uint64_t *dst, const std::size_t count) noexcept {
+	for ( std::size_t i = 0; i < count; ++i ) {
+		dst[i] = ~dst[i];
+	} //for ( std::size_t i = 0; i < count; ++i )
+	return;
+}
+
+constexpr WordKernels Kernels{andWords, orWords, impliesWords, equivalentWords, notWords};
+} //namespace scalar
+
+#ifdef FOL_TRUTH_TABLE_X86
+namespace avx2 {
+/* Each kernel handles the full 256 bit vectors and leaves the remaining words to the scalar kernel. */
+
+__attribute__((target("avx2")))
+inline void andWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	std::size_t i = 0;
+	for ( ; i + 4 <= count; i += 4 ) {
+		const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_and_si256(a, b));
+	} //for ( ; i + 4 <= count; i += 4 )
+	scalar::andWords(dst + i, src + i, count - i);
+	return;
+}
+
+__attribute__((target("avx2")))
+inline void orWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	std::size_t i = 0;
+	for ( ; i + 4 <= count; i += 4 ) {
+		const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(a, b));
+	} //for ( ; i + 4 <= count; i += 4 )
+	scalar::orWords(dst + i, src + i, count - i);
+	return;
+}
+
+__attribute__((target("avx2")))
+inline void impliesWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	const auto ones = _mm256_set1_epi64x(-1);
+	std::size_t i = 0;
+	for ( ; i + 4 <= count; i += 4 ) {
+		const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(_mm256_xor_si256(a, ones), b));
+	} //for ( ; i + 4 <= count; i += 4 )
+	scalar::impliesWords(dst + i, src + i, count - i);
+	return;
+}
+
+__attribute__((target("avx2")))
+inline void equivalentWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	const auto ones = _mm256_set1_epi64x(-1);
+	std::size_t i = 0;
+	for ( ; i + 4 <= count; i += 4 ) {
+		const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(_mm256_xor_si256(a, b), ones));
+	} //for ( ; i + 4 <= count; i += 4 )
+	scalar::equivalentWords(dst + i, src + i, count - i);
+	return;
+}
+
+__attribute__((target("avx2")))
+inline void notWords(std::uint64_t *dst, const std::size_t count) noexcept {
+	const auto ones = _mm256_set1_epi64x(-1);
+	std::size_t i = 0;
+	for ( ; i + 4 <= count; i += 4 ) {
+		const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, ones));
+	} //for ( ; i + 4 <= count; i += 4 )
+	scalar::notWords(dst + i, count - i);
+	return;
+}
+
+constexpr WordKernels Kernels{andWords, orWords, impliesWords, equivalentWords, notWords};
+} //namespace avx2
+
+namespace avx512 {
+__attribute__((target("avx512f")))
+inline void andWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	std::size_t i = 0;
+	for ( ; i + 8 <= count; i += 8 ) {
+		_mm512_storeu_si512(dst + i, _mm512_and_si512(_mm512_loadu_si512(dst + i), _mm512_loadu_si512(src + i)));
+	} //for ( ; i + 8 <= count; i += 8 )
+	scalar::andWords(dst + i, src + i, count - i);
+	return;
+}
+
+__attribute__((target("avx512f")))
+inline void orWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	std::size_t i = 0;
+	for ( ; i + 8 <= count; i += 8 ) {
+		_mm512_storeu_si512(dst + i, _mm512_or_si512(_mm512_loadu_si512(dst + i), _mm512_loadu_si512(src + i)));
+	} //for ( ; i + 8 <= count; i += 8 )
+	scalar::orWords(dst + i, src + i, count - i);
+	return;
+}
+
+/* The immediates of the ternary logic are the truth tables of the operation, with 0xF0 for dst and 0xCC for src. */
+
+__attribute__((target("avx512f")))
+inline void impliesWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	std::size_t i = 0;
+	for ( ; i + 8 <= count; i += 8 ) {
+		const auto a = _mm512_loadu_si512(dst + i);
+		const auto b = _mm512_loadu_si512(src + i);
+		_mm512_storeu_si512(dst + i, _mm512_ternarylogic_epi64(a, b, b, 0xCF));
+	} //for ( ; i + 8 <= count; i += 8 )
+	scalar::impliesWords(dst + i, src + i, count - i);
+	return;
+}
+
+__attribute__((target("avx512f")))
+inline void equivalentWords(std::uint64_t *dst, const std::uint64_t *src, const std::size_t count) noexcept {
+	std::size_t i = 0;
+	for ( ; i + 8 <= count; i += 8 ) {
+		const auto a = _mm512_loadu_si512(dst + i);
+		const auto b = _mm512_loadu_si512(src + i);
+		_mm512_storeu_si512(dst + i, _mm512_ternarylogic_epi64(a, b, b, 0xC3));
+	} //for ( ; i + 8 <= count; i += 8 )
+	scalar::equivalentWords(dst + i, src + i, count - i);
+	return;
+}
+
+__attribute__((target("avx512f")))
+inline void notWords(std::uint64_t *dst, const std::size_t count) noexcept {
+	std::size_t i = 0;
+	for ( ; i + 8 <= count; i += 8 ) {
+		const auto a = _mm512_loadu_si512(dst + i);
+		_mm512_storeu_si512(dst + i, _mm512_ternarylogic_epi64(a, a, a, 0x0F));
+	} //for ( ; i + 8 <= count; i += 8 )
+	scalar::notWords(dst + i, count - i);
+	return;
+}
+
+constexpr WordKernels Kernels{andWords, orWords, impliesWords, equivalentWords, notWords};
+} //namespace avx512
+#endif
+
+inline bool nameLess(const RtName& n1, const RtName& n2) noexcept {
+	return n1.string() < n2.string();
+}
+
+inline std::size_t popCount(const std::uint64_t word) noexcept {
+#ifdef __GNUC__
+	return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+	auto w = word - ((word >> 1) & 0x5555555555555555ull);
+	w      = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+	w      = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return static_cast<std::size_t>((w * 0x0101010101010101ull) >> 56);
+#endif
+}
+} //namespace details
+
+/**
+ * @brief The complete truth table of a propositional formula, 64 rows per word.
+ *
+ * The atoms of the formula have to be predicates without arguments, they are the variables of the table and are sorted
+ * by name. Row r assigns true to variable i iff bit i of r is set, the value of row r is bit r % 64 of word r / 64.
+ * Every connective is computed for all rows at once, with the widest vector instructions the processor supports.
+ */
+class TruthTable {
+	public:
+	enum class Backend : std::uint8_t { Scalar, AVX2, AVX512 };
+	
+	static constexpr std::size_t MaxVariables = 24;
+	
+	private:
+	std::vector<RtName> Variables;
+	std::vector<std::uint64_t> Words;
+	std::size_t Rows;
+	
+	/**
+	 * @brief Returns the kernels of the backend, or of the best supported one if the processor lacks it.
+	 */
+	static const details::WordKernels& kernels(const Backend backend) noexcept {
+		switch ( std::min(backend, bestBackend()) ) {
+#ifdef FOL_TRUTH_TABLE_X86
+			case Backend::AVX512 : return details::avx512::Kernels;
+			case Backend::AVX2   : return details::avx2::Kernels;
+#else
+			case Backend::AVX512 :
+			case Backend::AVX2   :
+#endif
+			case Backend::Scalar : break;
+		} //switch ( backend )
+		return details::scalar::Kernels;
+	}
+	
+	struct Builder {
+		const details::WordKernels& Kernels;
+		std::unordered_map<RtName, std::size_t> Index;
+		std::size_t WordCount;
+		//One operand buffer per nesting level of the connectives with more than one child.
+		std::vector<std::vector<std::uint64_t>> Scratch;
+		
+		static std::size_t junctionDepth(const RtFormula& f) noexcept {
+			std::size_t ret = 0;
+			for ( const auto& child : f.Children ) {
+				ret = std::max(ret, junctionDepth(child));
+			} //for ( const auto& child : f.Children )
+			return f.Children.size() > 1 ? ret + 1 : ret;
+		}
+		
+		void fillVariable(std::vector<std::uint64_t>& dst, const std::size_t variable) const noexcept {
+			constexpr std::uint64_t patterns[] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+			                                      0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+			for ( std::size_t word = 0; word < WordCount; ++word ) {
+				dst[word] = variable < 6 ? patterns[variable] : ((word >> (variable - 6)) & 1) ? ~0ull : 0ull;
+			} //for ( std::size_t word = 0; word < WordCount; ++word )
+			return;
+		}
+		
+		void compute(const RtFormula& f, std::vector<std::uint64_t>& dst, const std::size_t depth = 0) {
+			using Kind = RtFormula::Kind;
+			const auto combine = [this, &f, &dst, depth](auto kernel) {
+					//As in junctionDepth() only a node with a second operand occupies the buffer of its level.
+					const auto childDepth = f.Children.size() > 1 ? depth + 1 : depth;
+					compute(f.Children.front(), dst, childDepth);
+					for ( std::size_t i = 1; i < f.Children.size(); ++i ) {
+						compute(f.Children[i], Scratch[depth], childDepth);
+						kernel(dst.data(), Scratch[depth].data(), WordCount);
+					} //for ( std::size_t i = 1; i < f.Children.size(); ++i )
+					return;
+				};
+			
+			switch ( f.K ) {
+				case Kind::True       :
+				case Kind::False      : std::fill(dst.begin(), dst.end(), f.K == Kind::True ? ~0ull : 0ull); break;
+				case Kind::Predicate  : {
+					if ( !f.Terms.empty() ) {
+						throw std::invalid_argument{"Predicate " + f.N->string() + " is not propositional!"};
+					} //if ( !f.Terms.empty() )
+					fillVariable(dst, Index.at(*f.N));
+					break;
+				} //case Kind::Predicate
+				case Kind::Not        : {
+					compute(f.Children.front(), dst, depth);
+					Kernels.Not(dst.data(), WordCount);
+					break;
+				} //case Kind::Not
+				case Kind::And        :
+				case Kind::Or         : {
+					if ( f.Children.empty() ) {
+						std::fill(dst.begin(), dst.end(), f.K == Kind::And ? ~0ull : 0ull);
+					} //if ( f.Children.empty() )
+					else {
+						combine(f.K == Kind::And ? Kernels.And : Kernels.Or);
+					} //else -> if ( f.Children.empty() )
+					break;
+				} //case Kind::And, Kind::Or
+				case Kind::Implies    : combine(Kernels.Implies); break;
+				case Kind::Equivalent : combine(Kernels.Equivalent); break;
+				case Kind::Equality   :
+				case Kind::Exists     :
+				case Kind::ForAll     : throw std::invalid_argument{"Formula is not propositional!"};
+			} //switch ( f.K )
+			return;
+		}
+	};
+	
+	public:
+	/**
+	 * @brief Returns the widest backend the processor supports, determined once.
+	 */
+	static Backend bestBackend(void) noexcept {
+		static const Backend best = [](void) noexcept {
+#ifdef FOL_TRUTH_TABLE_X86
+				__builtin_cpu_init();
+				if ( __builtin_cpu_supports("avx512f") ) {
+					return Backend::AVX512;
+				} //if ( __builtin_cpu_supports("avx512f") )
+				if ( __builtin_cpu_supports("avx2") ) {
+					return Backend::AVX2;
+				} //if ( __builtin_cpu_supports("avx2") )
+#endif
+				return Backend::Scalar;
+			}();
+		return best;
+	}
+	
+	/**
+	 * @brief Returns the variables of the propositional formula, sorted by name.
+	 */
+	static std::vector<RtName> variablesOf(const RtFormula& f) {
+		std::vector<RtName> ret;
+		visit(f, [&ret](const auto& node) {
+				if constexpr ( std::is_same_v<std::decay_t<decltype(node)>, RtFormula> ) {
+					if ( node.K == RtFormula::Kind::Predicate &&
+					     std::find(ret.begin(), ret.end(), *node.N) == ret.end() ) {
+						ret.push_back(*node.N);
+					} //if ( node.K == RtFormula::Kind::Predicate && ... )
+				} //if constexpr ( std::is_same_v<std::decay_t<decltype(node)>, RtFormula> )
+				return true;
+			});
+		std::sort(ret.begin(), ret.end(), details::nameLess);
+		return ret;
+	}
+	
+	/**
+	 * @brief Computes the table over the given variables, which have to contain every variable of the formula.
+	 */
+	TruthTable(const RtFormula& f, std::vector<RtName> variables, const Backend backend = bestBackend()) :
+			Variables{std::move(variables)} {
+		if ( Variables.size() > MaxVariables ) {
+			throw std::length_error{"Too many variables for a truth table!"};
+		} //if ( Variables.size() > MaxVariables )
+		Rows = std::size_t{1} << Variables.size();
+		
+		Builder builder{kernels(backend), {}, (Rows + 63) / 64, {}};
+		for ( std::size_t i = 0; i < Variables.size(); ++i ) {
+			builder.Index.emplace(Variables[i], i);
+		} //for ( std::size_t i = 0; i < Variables.size(); ++i )
+		for ( const auto& variable : variablesOf(f) ) {
+			if ( !builder.Index.count(variable) ) {
+				throw std::invalid_argument{"Variable " + variable.string() + " is not part of the table!"};
+			} //if ( !builder.Index.count(variable) )
+		} //for ( const auto& variable : variablesOf(f) )
+		
+		Words.resize(builder.WordCount);
+		builder.Scratch.assign(Builder::junctionDepth(f), std::vector<std::uint64_t>(builder.WordCount));
+		builder.compute(f, Words);
+		if ( Rows < 64 ) {
+			Words.front() &= (std::uint64_t{1} << Rows) - 1;
+		} //if ( Rows < 64 )
+		return;
+	}
+	
+	explicit TruthTable(const RtFormula& f, const Backend backend = bestBackend()) :
+			TruthTable{f, variablesOf(f), backend} {
+		return;
+	}
+	
+	template<typename T, std::enable_if_t<IsFormula<T>::value>* = nullptr>
+	explicit TruthTable(const T& f, const Backend backend = bestBackend()) : TruthTable{toRuntime(f), backend} {
+		return;
+	}
+	
+	const std::vector<RtName>& variables(void) const noexcept {
+		return Variables;
+	}
+	
+	std::size_t rows(void) const noexcept {
+		return Rows;
+	}
+	
+	const std::vector<std::uint64_t>& words(void) const noexcept {
+		return Words;
+	}
+	
+	bool value(const std::size_t row) const {
+		if ( row >= Rows ) {
+			throw std::out_of_range{"Row is not part of the table!"};
+		} //if ( row >= Rows )
+		return (Words[row / 64] >> (row % 64)) & 1;
+	}
+	
+	std::size_t modelCount(void) const noexcept {
+		std::size_t ret = 0;
+		for ( const auto word : Words ) {
+			ret += details::popCount(word);
+		} //for ( const auto word : Words )
+		return ret;
+	}
+	
+	bool isTautology(void) const noexcept {
+		return modelCount() == Rows;
+	}
+	
+	bool isSatisfiable(void) const noexcept {
+		return std::any_of(Words.begin(), Words.end(), [](const std::uint64_t word) noexcept { return word != 0; });
+	}
+	
+	friend bool operator==(const TruthTable& t1, const TruthTable& t2) noexcept {
+		return t1.Variables == t2.Variables && t1.Words == t2.Words;
+	}
+	
+	friend bool operator!=(const TruthTable& t1, const TruthTable& t2) noexcept {
+		return !(t1 == t2);
+	}
+};
+
+/**
+ * @brief Checks whether the propositional formulas have the same truth value under every assignment.
+ */
+inline bool arePropositionallyEquivalent(const RtFormula& f1, const RtFormula& f2) {
+	auto variables = TruthTable::variablesOf(f1);
+	for ( auto& variable : TruthTable::variablesOf(f2) ) {
+		const auto iter = std::lower_bound(variables.begin(), variables.end(), variable, details::nameLess);
+		if ( iter == variables.end() || *iter != variable ) {
+			variables.insert(iter, std::move(variable));
+		} //if ( iter == variables.end() || *iter != variable )
+	} //for ( auto& variable : TruthTable::variablesOf(f2) )
+	return TruthTable{f1, variables} == TruthTable{f2, variables};
+}
+
+} //namespace fol
+
+#endif
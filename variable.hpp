@@ -7,6 +7,7 @@
 #define FOL_VARIABLE_HPP
 
 #include "name.hpp"
+#include "storage.hpp"
 
 #include <array>
 #include <ostream>
@@ -14,8 +15,8 @@
 namespace fol {
 
 template<char c, char... String>
-struct Variable {
-	Name<c,String...> N;
+struct Variable : details::StoredN<Name<c, String...>> {
+	using details::StoredN<Name<c, String...>>::N;
 	
 	using VariableCount = std::integral_constant<std::size_t, 1>;
 //	using VariableArray = ArraySet<VariableCount::value, Variable<c, String...>>;
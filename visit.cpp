@@ -0,0 +1,7 @@
+/**
+ * @file
+ * @brief Checks visit.hpp for self-containment.
+ * 
+ */
+
+#include "visit.hpp"
@@ -0,0 +1,207 @@
+/**
+ * @file
+ * @brief Contains the generic traversal of terms and formulas.
+ */
+
+#ifndef FOL_VISIT_HPP
+#define FOL_VISIT_HPP
+
+#include "forward.hpp"
+
+#include "and.hpp"
+#include "equality.hpp"
+#include "equivalent.hpp"
+#include "exists.hpp"
+#include "forall.hpp"
+#include "function.hpp"
+#include "implies.hpp"
+#include "not.hpp"
+#include "or.hpp"
+#include "predicate.hpp"
+#include "rt_formula.hpp"
+#include "traits.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fol {
+
+namespace details {
+template<typename T>
+constexpr std::tuple<> children(const T&) noexcept {
+	return {};
+}
+
+template<typename NameT, typename... Args>
+constexpr const std::tuple<Args...>& children(const Function<NameT, Args...>& f) noexcept {
+	return f.A;
+}
+
+template<typename NameT, typename... Args>
+constexpr const std::tuple<Args...>& children(const Predicate<NameT, Args...>& p) noexcept {
+	return p.A;
+}
+
+template<typename T1, typename T2>
+constexpr auto children(const Equality<T1, T2>& e) noexcept {
+	return std::tie(e.Term1, e.Term2);
+}
+
+template<typename T>
+constexpr auto children(const Not<T>& n) noexcept {
+	return std::tie(n.t);
+}
+
+template<typename... Ts>
+constexpr const std::tuple<Ts...>& children(const And<Ts...>& a) noexcept {
+	return a.ts;
+}
+
+template<typename... Ts>
+constexpr const std::tuple<Ts...>& children(const Or<Ts...>& o) noexcept {
+	return o.ts;
+}
+
+template<typename T1, typename T2>
+constexpr auto children(const Implies<T1, T2>& i) noexcept {
+	return std::tie(i.t1, i.t2);
+}
+
+template<typename T1, typename T2>
+constexpr auto children(const Equivalent<T1, T2>& e) noexcept {
+	return std::tie(e.t1, e.t2);
+}
+
+template<typename Var, typename Form>
+constexpr auto children(const Exists<Var, Form>& e) noexcept {
+	return std::tie(e.F);
+}
+
+template<typename Var, typename Form>
+constexpr auto children(const ForAll<Var, Form>& f) noexcept {
+	return std::tie(f.F);
+}
+} //namespace details
+
+template<typename T, typename Visitor>
+constexpr bool visit(const T& node, Visitor&& visitor);
+
+/**
+ * @brief Visits the runtime formula and its terms in pre-order.
+ *
+ * Works with an explicit stack instead of recursion, so the depth of the formula is only limited by the heap.
+ */
+template<typename Visitor>
+bool visit(const RtFormula& f, Visitor&& visitor) {
+	struct Entry {
+		const RtFormula *Formula;
+		const RtTerm *Term;
+	};
+	std::vector<Entry> stack{{&f, nullptr}};
+	
+	while ( !stack.empty() ) {
+		const auto entry = stack.back();
+		stack.pop_back();
+		
+		if ( entry.Formula ) {
+			if ( !visitor(*entry.Formula) ) {
+				return false;
+			} //if ( !visitor(*entry.Formula) )
+			for ( auto iter = entry.Formula->Children.rbegin(); iter != entry.Formula->Children.rend(); ++iter ) {
+				stack.push_back({&*iter, nullptr});
+			} //for ( auto iter = entry.Formula->Children.rbegin(); iter != entry.Formula->Children.rend(); ++iter )
+			for ( auto iter = entry.Formula->Terms.rbegin(); iter != entry.Formula->Terms.rend(); ++iter ) {
+				stack.push_back({nullptr, &*iter});
+			} //for ( auto iter = entry.Formula->Terms.rbegin(); iter != entry.Formula->Terms.rend(); ++iter )
+		} //if ( entry.Formula )
+		else {
+			if ( !visitor(*entry.Term) ) {
+				return false;
+			} //if ( !visitor(*entry.Term) )
+			for ( auto iter = entry.Term->Args.rbegin(); iter != entry.Term->Args.rend(); ++iter ) {
+				stack.push_back({nullptr, &*iter});
+			} //for ( auto iter = entry.Term->Args.rbegin(); iter != entry.Term->Args.rend(); ++iter )
+		} //else -> if ( entry.Formula )
+	} //while ( !stack.empty() )
+	return true;
+}
+
+/**
+ * @brief Visits the runtime term and its arguments in pre-order, with an explicit stack.
+ */
+template<typename Visitor>
+bool visit(const RtTerm& t, Visitor&& visitor) {
+	std::vector<const RtTerm*> stack{&t};
+	while ( !stack.empty() ) {
+		const auto term = stack.back();
+		stack.pop_back();
+		if ( !visitor(*term) ) {
+			return false;
+		} //if ( !visitor(*term) )
+		for ( auto iter = term->Args.rbegin(); iter != term->Args.rend(); ++iter ) {
+			stack.push_back(&*iter);
+		} //for ( auto iter = term->Args.rbegin(); iter != term->Args.rend(); ++iter )
+	} //while ( !stack.empty() )
+	return true;
+}
+
+/**
+ * @brief Calls visitor with every formula and term in pre-order, stopping as soon as it returns false.
+ * @return Whether the whole formula was visited.
+ *
+ * The visitor gets the nodes as their own type, so a generic lambda can tell them apart with if constexpr, for runtime
+ * formulas it gets RtFormula and RtTerm. The bound variable of a quantifier is part of the quantifier node and is not
+ * visited on its own. Usable in constant expressions for the static types.
+ */
+template<typename T, typename Visitor>
+constexpr bool visit(const T& node, Visitor&& visitor) {
+	if ( !visitor(node) ) {
+		return false;
+	} //if ( !visitor(node) )
+	return std::apply([&visitor](const auto&... children) { return (visit(children, visitor) && ...); },
+	                  details::children(node));
+}
+
+/**
+ * @brief Folds folder over every formula and term in pre-order.
+ *
+ * The folder is called as folder(accumulator, node) and updates the accumulator in place. If it returns a bool, false
+ * ends the traversal early.
+ */
+template<typename T, typename Acc, typename Folder>
+constexpr Acc fold(const T& node, Acc acc, Folder folder) {
+	visit(node, [&acc, &folder](const auto& n) {
+			if constexpr ( std::is_same_v<decltype(folder(acc, n)), bool> ) {
+				return folder(acc, n);
+			} //if constexpr ( std::is_same_v<decltype(folder(acc, n)), bool> )
+			else {
+				folder(acc, n);
+				return true;
+			} //else -> if constexpr ( std::is_same_v<decltype(folder(acc, n)), bool> )
+		});
+	return acc;
+}
+
+/**
+ * @brief Returns the number of atoms, i.e. predicates and equalities, in the formula.
+ */
+template<typename T>
+constexpr std::size_t atomCount(const T& f) {
+	return fold(f, std::size_t{0}, [](std::size_t& count, const auto& node) {
+			using Node = std::decay_t<decltype(node)>;
+			if constexpr ( std::is_same_v<Node, RtFormula> ) {
+				count += node.isAtom() ? 1u : 0u;
+			} //if constexpr ( std::is_same_v<Node, RtFormula> )
+			else {
+				count += IsAtom<Node>::value ? 1u : 0u;
+			} //else -> if constexpr ( std::is_same_v<Node, RtFormula> )
+			return;
+		});
+}
+
+} //namespace fol
+
+#endif